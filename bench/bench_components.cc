@@ -0,0 +1,151 @@
+/*
+ * File: bench_components.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * Benchmark of FieldEngine::applyComponents(): Cartesian and spherical
+ * gradients evaluated into interleaved components (apply(), array of
+ * structures), interleaved components split into separate arrays
+ * afterwards (what a caller needing separate arrays would otherwise do)
+ * and separate arrays written directly (applyComponents(), structure of
+ * arrays), on a uniform n^3 grid. Arrays are aligned to 64 bytes.
+ *
+ * Printed times are the best of several runs, throughput is in output
+ * values per second. Results of both layouts are also compared (they have
+ * to be identical).
+ *
+ * Usage: bench_components [n] [width] [threads]
+ */
+
+#include "field_engine.h"    /* FieldEngine */
+#include "FieldOperators.h"  /* CartesianGradientFieldOp, ... */
+
+#include <algorithm>         /* std::min */
+#include <cmath>             /* sin */
+#include <cstdio>            /* printf */
+#include <cstdlib>           /* atoi */
+#include <new>               /* std::bad_alloc */
+#include <vector>            /* std::vector */
+
+#include <stdlib.h>          /* posix_memalign, free */
+
+#include <omp.h>             /* omp_get_wtime */
+
+using namespace GridDiff;
+
+namespace
+{
+
+/* Number of timed runs (the shortest is reported). */
+const unsigned RUNS = 5;
+
+/* Number of gradient components. */
+const unsigned NCOMP = 3;
+
+/*
+ * Returns size doubles aligned to 64 bytes (to be freed with free()).
+ */
+double * AlignedArray (const size_t & size)
+{
+    void * mem = NULL;
+
+    if (posix_memalign(&mem, 64, size * sizeof(double)) != 0){
+        throw std::bad_alloc();
+    }
+    return static_cast<double *>(mem);
+}
+
+} /* anonymous namespace */
+
+
+int main (int argc, char ** argv)
+{
+    const size_t   n       = (argc > 1) ? (size_t)   atoi(argv[1]) : 160;
+    const unsigned width   = (argc > 2) ? (unsigned) atoi(argv[2]) : 5;
+    const unsigned threads = (argc > 3) ? (unsigned) atoi(argv[3]) : 0;
+
+    /* Nonuniform grid (spherical operators need nonzero radius). */
+    QGrid q(n);
+
+    for (size_t i = 0; i < n; ++i){
+        q[i] = 1.0 + 0.01 * i + 1e-5 * i * i;
+    }
+
+    FieldEngine       engine(q, q, q, width, 1);
+    FieldEngineConfig config;
+
+    config.threads = threads;
+    engine.setConfig(config);
+
+    const size_t N = engine.size();
+
+    double * f   = AlignedArray(N);
+    double * aos = AlignedArray(NCOMP * N);
+    double * soa[NCOMP];
+
+    for (unsigned c = 0; c < NCOMP; ++c){
+        soa[c] = AlignedArray(N);
+    }
+
+    for (size_t i = 0; i < N; ++i){
+        f[i] = sin(0.001 * i);
+    }
+
+    const CartesianGradientFieldOp cartesian;
+    const SphericalGradientFieldOp spherical;
+    const FieldOperator * ops[]   = { &cartesian, &spherical };
+    const char          * names[] = { "cartesian", "spherical" };
+
+    printf("grid %lu^3, width %u, %d threads\n", (unsigned long) n, width,
+           engine.threadCount());
+    printf("%-10s %-14s %10s %14s %6s\n", "gradient", "layout", "ms",
+           "Mvalues/s", "same");
+
+    for (unsigned o = 0; o < 2; ++o){
+        const FieldOperator & op = *ops[o];
+        double best[3] = { 1e30, 1e30, 1e30 };
+
+        for (unsigned r = 0; r < RUNS; ++r){
+            double t0 = omp_get_wtime();
+
+            engine.apply(op, f, aos);
+            best[0] = std::min(best[0], omp_get_wtime() - t0);
+
+            #pragma omp parallel for num_threads(engine.threadCount())
+            for (long i = 0; i < (long) N; ++i){
+                for (unsigned c = 0; c < NCOMP; ++c){
+                    soa[c][i] = aos[NCOMP * i + c];
+                }
+            }
+            best[1] = std::min(best[1], omp_get_wtime() - t0);
+
+            t0 = omp_get_wtime();
+            engine.applyComponents(op, f, soa);
+            best[2] = std::min(best[2], omp_get_wtime() - t0);
+        }
+
+        bool same = true;
+
+        for (size_t i = 0; i < N; ++i){
+            for (unsigned c = 0; c < NCOMP; ++c){
+                same = same && soa[c][i] == aos[NCOMP * i + c];
+            }
+        }
+
+        const char * layouts[] = { "AoS", "AoS + split", "SoA" };
+
+        for (unsigned l = 0; l < 3; ++l){
+            printf("%-10s %-14s %10.1f %14.1f %6s\n", names[o], layouts[l],
+                   1e3 * best[l], 1e-6 * NCOMP * N / best[l],
+                   same ? "yes" : "NO");
+        }
+    }
+
+    free(f);
+    free(aos);
+    for (unsigned c = 0; c < NCOMP; ++c){
+        free(soa[c]);
+    }
+
+    return 0;
+}
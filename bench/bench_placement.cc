@@ -0,0 +1,116 @@
+/*
+ * File: bench_placement.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * Benchmark of Field3D page placement: Cartesian Laplacian evaluated with
+ * FieldEngine::apply() on input and output fields allocated with local
+ * (first touch by evaluating threads), interleaved and naive (first touch
+ * by the calling thread) placement, on a uniform n^3 grid.
+ *
+ * Printed times are the allocation (first touch) time and the best of
+ * several evaluations; bandwidth assumes 24 bytes of memory traffic per
+ * node (reading the field, writing the output with write-allocate).
+ * Differences show up only on multi-socket machines when all cores are
+ * used; on a single NUMA node all policies should perform the same.
+ * Threads are pinned to CPUs (see PinWorkerThreads()) unless pin is 0.
+ *
+ * Usage: bench_placement [n] [threads] [pin] [hugepages]
+ */
+
+#include "field3d.h"         /* Field3D, PinWorkerThreads */
+#include "FieldOperators.h"  /* CartesianLaplacianFieldOp */
+
+#include <algorithm>         /* std::min */
+#include <cmath>             /* sin */
+#include <cstdio>            /* printf */
+#include <cstdlib>           /* atoi */
+#include <cstring>           /* memcmp */
+#include <vector>            /* std::vector */
+
+#include <omp.h>             /* omp_get_wtime */
+
+using namespace GridDiff;
+
+namespace
+{
+
+/* Number of timed runs (the shortest is reported). */
+const unsigned RUNS = 5;
+
+/* Stencil width of the evaluated operator. */
+const unsigned WIDTH = 5;
+
+} /* anonymous namespace */
+
+
+int main (int argc, char ** argv)
+{
+    const size_t   n       = (argc > 1) ? (size_t)   atoi(argv[1]) : 256;
+    const unsigned threads = (argc > 2) ? (unsigned) atoi(argv[2]) : 0;
+    const bool     pin     = (argc > 3) ? atoi(argv[3]) != 0 : true;
+    const bool     huge    = (argc > 4) ? atoi(argv[4]) != 0 : false;
+
+    QGrid q(n);
+
+    for (size_t i = 0; i < n; ++i){
+        q[i] = (double) i / (n - 1);
+    }
+
+    FieldEngine       engine(q, q, q, WIDTH, 2);
+    FieldEngineConfig config;
+
+    config.threads = threads;
+    engine.setConfig(config);
+
+    const CartesianLaplacianFieldOp lap;
+    const size_t                    N = engine.size();
+    const bool pinned = pin && PinWorkerThreads(engine);
+
+    printf("grid %lu^3 (%.0f MB per field), %d threads%s%s\n",
+           (unsigned long) n, N * 8.0 / (1 << 20), engine.threadCount(),
+           pinned ? ", pinned" : "", huge ? ", huge pages" : "");
+    printf("%-12s %12s %12s %10s %6s\n", "placement", "alloc ms",
+           "apply ms", "GB/s", "same");
+
+    const FieldPlacement placements[] = { FIELD_PLACEMENT_LOCAL,
+                                          FIELD_PLACEMENT_INTERLEAVED,
+                                          FIELD_PLACEMENT_NAIVE };
+    const char * names[] = { "local", "interleaved", "naive" };
+
+    std::vector<double> reference;
+
+    for (unsigned p = 0; p < 3; ++p){
+        const double t0 = omp_get_wtime();
+
+        Field3D f(engine, 1, placements[p], huge);
+        Field3D out(engine, 1, placements[p], huge);
+
+        const double ta = omp_get_wtime() - t0;
+
+        /* Writing values does not move pages placed by first touch. */
+        for (size_t i = 0; i < N; ++i){
+            f[i] = sin(0.001 * i);
+        }
+
+        double best = 1e30;
+
+        for (unsigned r = 0; r < RUNS; ++r){
+            const double t1 = omp_get_wtime();
+
+            engine.apply(lap, f.data(), out.data());
+            best = std::min(best, omp_get_wtime() - t1);
+        }
+
+        if (reference.empty()){
+            reference.assign(out.data(), out.data() + N);
+        }
+        const bool eq = memcmp(&reference[0], out.data(),
+                               N * sizeof(double)) == 0;
+
+        printf("%-12s %12.1f %12.1f %10.2f %6s\n", names[p], 1e3 * ta,
+               1e3 * best, 24.0 * N / best * 1e-9, eq ? "yes" : "NO");
+    }
+
+    return 0;
+}
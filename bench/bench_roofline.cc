@@ -0,0 +1,131 @@
+/*
+ * File: bench_roofline.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * Roofline report of operator evaluation (see roofline.h header file):
+ * measures memory bandwidth and peak flop rate of the machine, then
+ * throughput of every FieldEngine operator at several stencil widths (on
+ * an n^3 grid; spherical and cylindrical radius starts at 1) and of every
+ * point operator (at points sets of function values of a width-point
+ * stencil), and prints achieved rates against roofline bounds.
+ *
+ * Usage: bench_roofline [n] [points] [threads]
+ */
+
+#include "roofline.h"        /* MeasureMachineRoofline, ... */
+#include "FieldOperators.h"  /* CartesianGradientFieldOp, ... */
+#include "Gradients.h"       /* CartesianGradient, ... */
+#include "Laplacians.h"      /* CartesianLaplacian, ... */
+
+#include <cstdio>            /* snprintf */
+#include <cstdlib>           /* atoi */
+#include <iostream>          /* std::cout */
+#include <string>            /* std::string */
+#include <vector>            /* std::vector */
+
+#include <omp.h>             /* omp_set_num_threads */
+
+using namespace GridDiff;
+
+namespace
+{
+
+/* Stencil widths of measured kernels. */
+const unsigned WIDTHS[] = { 3, 5, 7 };
+const unsigned NWIDTHS  = sizeof(WIDTHS) / sizeof(WIDTHS[0]);
+
+/*
+ * Returns kernel name with stencil width appended.
+ */
+std::string KernelName (const char * name, const unsigned & width)
+{
+    char buf[64];
+
+    snprintf(buf, sizeof(buf), "%s w%u", name, width);
+    return buf;
+}
+
+} /* anonymous namespace */
+
+
+int main (int argc, char ** argv)
+{
+    const size_t n       = (argc > 1) ? (size_t) atoi(argv[1]) : 128;
+    const size_t points  = (argc > 2) ? (size_t) atoi(argv[2]) : 1 << 18;
+    const int    threads = (argc > 3) ? atoi(argv[3]) : 0;
+
+    if (threads > 0){
+        omp_set_num_threads(threads);
+    }
+
+    const MachineRoofline      machine = MeasureMachineRoofline();
+    std::vector<RooflineEntry> entries;
+
+    /* Field operators: radius-like axis starting at 1, angles within
+     * (0, pi). */
+    QGrid q(n);
+
+    for (size_t i = 0; i < n; ++i){
+        q[i] = 1.0 + 2.0 * i / (n - 1);
+    }
+
+    const CartesianGradientFieldOp    cartGrad;
+    const CartesianLaplacianFieldOp   cartLap;
+    const CylindricalGradientFieldOp  cylGrad;
+    const CylindricalLaplacianFieldOp cylLap;
+    const SphericalGradientFieldOp    sphGrad;
+    const SphericalLaplacianFieldOp   sphLap;
+
+    const FieldOperator * ops[] = { &cartGrad, &cartLap, &cylGrad,
+                                    &cylLap,   &sphGrad, &sphLap };
+    const char * names[] = { "field cartesian grad", "field cartesian lap",
+                             "field cylindrical grad",
+                             "field cylindrical lap",
+                             "field spherical grad", "field spherical lap" };
+
+    for (unsigned w = 0; w < NWIDTHS; ++w){
+        FieldEngine engine(q, q, q, WIDTHS[w], 2);
+
+        for (unsigned o = 0; o < sizeof(ops) / sizeof(ops[0]); ++o){
+            entries.push_back(MeasureFieldOperator(engine, *ops[o],
+                                  KernelName(names[o], WIDTHS[w])));
+        }
+    }
+
+    /* Point operators at the middle node of a width-point grid. */
+    for (unsigned w = 0; w < NWIDTHS; ++w){
+        const unsigned width = WIDTHS[w];
+        QGrid          g(width);
+
+        for (unsigned i = 0; i < width; ++i){
+            g[i] = 1.0 + 0.01 * i;
+        }
+
+        QPoint p0;
+        p0.q1 = p0.q2 = p0.q3 = g[width / 2];
+
+        entries.push_back(MeasurePointOperator(
+            CartesianGradient   (p0, g, g, g),
+            KernelName("point cartesian grad", width), points));
+        entries.push_back(MeasurePointOperator(
+            CartesianLaplacian  (p0, g, g, g),
+            KernelName("point cartesian lap", width), points));
+        entries.push_back(MeasurePointOperator(
+            CylindricalGradient (p0, g, g, g),
+            KernelName("point cylindrical grad", width), points));
+        entries.push_back(MeasurePointOperator(
+            CylindricalLaplacian(p0, g, g, g),
+            KernelName("point cylindrical lap", width), points));
+        entries.push_back(MeasurePointOperator(
+            SphericalGradient   (p0, g, g, g),
+            KernelName("point spherical grad", width), points));
+        entries.push_back(MeasurePointOperator(
+            SphericalLaplacian  (p0, g, g, g),
+            KernelName("point spherical lap", width), points));
+    }
+
+    WriteRooflineReport(std::cout, machine, entries);
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * File: bench_steps.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * Benchmark of FieldEngine::applySteps(): K explicit steps of Cartesian
+ * Laplacian applied in K separate sweeps and in a single temporally
+ * blocked (wavefront) sweep, on a uniform n^3 grid.
+ *
+ * Every separate sweep reads and writes a whole field, i.e. streams about
+ * 16*K bytes per node from and to main memory, while the wavefront sweep
+ * keeps intermediate planes of a tile in cache and streams 16 bytes per
+ * node once per group of steps swept together (all K steps, unless their
+ * halos are too large, see applySteps()). Printed traffic is this model
+ * (for a single group); effective bandwidth is the modelled traffic of
+ * K separate sweeps divided by measured time (values above the memory
+ * bandwidth of the machine show the reduction). Blocking pays off only
+ * if separate sweeps are memory-bound, i.e. for fields much larger than
+ * the last level cache evaluated by many threads. Results of both methods
+ * are also compared (they have to be identical).
+ *
+ * Usage: bench_steps [n] [width] [threads]
+ */
+
+#include "field_engine.h"    /* FieldEngine */
+#include "FieldOperators.h"  /* CartesianLaplacianFieldOp */
+
+#include <algorithm>         /* std::min */
+#include <cmath>             /* sin */
+#include <cstdio>            /* printf */
+#include <cstdlib>           /* atoi */
+#include <cstring>           /* memcmp */
+#include <vector>            /* std::vector */
+
+#include <omp.h>             /* omp_get_wtime */
+
+using namespace GridDiff;
+
+namespace
+{
+
+/* Number of timed runs (the shortest is reported). */
+const unsigned RUNS = 3;
+
+/*
+ * Returns the shortest time of RUNS applySteps() calls.
+ */
+double TimeSteps (const FieldEngine   &  engine,
+                  const FieldOperator &      op,
+                  const unsigned      &   steps,
+                  const double        *       f,
+                  double              *     out)
+{
+    double best = 1e30;
+
+    for (unsigned r = 0; r < RUNS; ++r){
+        const double t0 = omp_get_wtime();
+
+        engine.applySteps(op, 1e-6, steps, f, out);
+        best = std::min(best, omp_get_wtime() - t0);
+    }
+    return best;
+}
+
+} /* anonymous namespace */
+
+
+int main (int argc, char ** argv)
+{
+    const size_t   n       = (argc > 1) ? (size_t)   atoi(argv[1]) : 256;
+    const unsigned width   = (argc > 2) ? (unsigned) atoi(argv[2]) : 5;
+    const unsigned threads = (argc > 3) ? (unsigned) atoi(argv[3]) : 0;
+
+    QGrid q(n);
+
+    for (size_t i = 0; i < n; ++i){
+        q[i] = (double) i / (n - 1);
+    }
+
+    FieldEngine                     engine(q, q, q, width, 2);
+    const CartesianLaplacianFieldOp lap;
+    const size_t                    N = engine.size();
+
+    std::vector<double> f(N), sep(N), blk(N);
+
+    for (size_t i = 0; i < N; ++i){
+        f[i] = sin(0.001 * i);
+    }
+
+    printf("grid %lu^3 (%.0f MB per field), width %u\n",
+           (unsigned long) n, N * 8.0 / (1 << 20), width);
+    printf("%4s %12s %12s %8s %14s %14s %10s\n", "K", "separate ms",
+           "blocked ms", "speedup", "traffic MB", "eff. GB/s", "same");
+
+    const unsigned ks[] = { 1, 2, 4, 8 };
+
+    for (unsigned k = 0; k < sizeof(ks) / sizeof(ks[0]); ++k){
+        const unsigned  K = ks[k];
+        FieldEngineConfig config;
+
+        config.threads          = threads;
+        config.temporalBlocking = false;
+        engine.setConfig(config);
+
+        const double ts = TimeSteps(engine, lap, K, &f[0], &sep[0]);
+
+        config.temporalBlocking = true;
+        engine.setConfig(config);
+
+        const double tb = TimeSteps(engine, lap, K, &f[0], &blk[0]);
+
+        /* Modelled main memory traffic (MB) of separate and blocked
+         * sweeps. */
+        const double ms = 16.0 * N * K / (1 << 20);
+        const double mb = 16.0 * N     / (1 << 20);
+        const bool   eq = memcmp(&sep[0], &blk[0], N * sizeof(double)) == 0;
+
+        printf("%4u %12.1f %12.1f %8.2f %6.0f -> %5.0f %6.1f -> %5.1f %10s\n",
+               K, 1e3 * ts, 1e3 * tb, ts / tb, ms, mb,
+               ms / 1024.0 / ts, ms / 1024.0 / tb, eq ? "yes" : "NO");
+    }
+
+    return 0;
+}
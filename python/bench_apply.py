@@ -0,0 +1,135 @@
+#
+# File: bench_apply.py
+# Author(s): P Kuszaj
+# Last changed: 18.10.2026
+#
+# Benchmark of griddiff.FieldEngine.apply() against pure NumPy finite
+# differences (second-order central differences written with array
+# slicing, and numpy.gradient) on a uniform n^3 grid, and of
+# griddiff.PointOperator.eval() on m value sets at once against one call
+# per set. Times are the best of several runs; errors are measured
+# against exact derivatives of smooth test functions (at interior nodes
+# for fields).
+#
+# Usage (after python setup.py build_ext --inplace):
+#     python bench_apply.py [n] [threads] [m]
+#
+
+import sys
+import time
+
+import numpy as np
+
+import griddiff
+
+
+def best_time(fn, repeat=5):
+    """Returns the shortest of repeat run times of fn() (in seconds)."""
+    best = float('inf')
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        fn()
+        best = min(best, time.perf_counter() - t0)
+    return best
+
+
+def numpy_laplacian(f, h, out):
+    """Second-order central difference Laplacian at interior nodes."""
+    c = f[1:-1, 1:-1, 1:-1]
+    out[1:-1, 1:-1, 1:-1] = (f[1:-1, 1:-1, 2:] + f[1:-1, 1:-1, :-2] +
+                             f[1:-1, 2:, 1:-1] + f[1:-1, :-2, 1:-1] +
+                             f[2:, 1:-1, 1:-1] + f[:-2, 1:-1, 1:-1] -
+                             6.0 * c) / (h * h)
+    return out
+
+
+def numpy_gradient(f, h):
+    """Gradient with numpy.gradient, as (n3, n2, n1, 3) array (q1 first)."""
+    g3, g2, g1 = np.gradient(f, h)
+    return np.stack((g1, g2, g3), axis=-1)
+
+
+def main():
+    n = int(sys.argv[1]) if len(sys.argv) > 1 else 128
+    threads = int(sys.argv[2]) if len(sys.argv) > 2 else 0
+    m = int(sys.argv[3]) if len(sys.argv) > 3 else 100000
+
+    q = np.linspace(0.0, 1.0, n)
+    h = q[1] - q[0]
+    z, y, x = np.meshgrid(q, q, q, indexing='ij')
+
+    # f = sin(x) cos(2y) exp(z/2)
+    f = np.sin(x) * np.cos(2.0 * y) * np.exp(0.5 * z)
+    f32 = f.astype(np.float32)
+    lap = (-1.0 - 4.0 + 0.25) * f
+    grad = np.stack((np.cos(x) * np.cos(2.0 * y) * np.exp(0.5 * z),
+                     -2.0 * np.sin(x) * np.sin(2.0 * y) * np.exp(0.5 * z),
+                     0.5 * f), axis=-1)
+
+    inner = (slice(2, -2),) * 3
+    out = np.empty_like(f)
+    vout = np.empty(f.shape + (3,))
+
+    print('grid %d^3, threads %s' % (n, threads if threads else 'default'))
+    print('%-36s %10s %12s' % ('method', 'time [ms]', 'max error'))
+
+    def report(name, seconds, result, exact):
+        err = np.max(np.abs(result[inner] - exact[inner]))
+        print('%-36s %10.2f %12.3e' % (name, 1e3 * seconds, err))
+
+    t = best_time(lambda: numpy_laplacian(f, h, out))
+    report('numpy laplacian (3-point)', t, out, lap)
+
+    t = best_time(lambda: numpy_gradient(f, h))
+    report('numpy.gradient', t, numpy_gradient(f, h), grad)
+
+    for width in (3, 5):
+        engine = griddiff.FieldEngine(q, q, q, width=width, max_order=2,
+                                      threads=threads)
+
+        t = best_time(lambda: engine.apply('cartesian_laplacian', f, out))
+        report('griddiff laplacian (width %d)' % width, t, out, lap)
+
+        t = best_time(lambda: engine.apply('cartesian_laplacian', f32, out))
+        report('griddiff laplacian float32 (width %d)' % width, t, out, lap)
+
+        t = best_time(lambda: engine.apply('cartesian_gradient', f, vout))
+        report('griddiff gradient (width %d)' % width, t, vout, grad)
+
+    # Strided view (every other q1 node of a twice larger array), no copy.
+    wide = np.repeat(f, 2, axis=2)[:, :, ::2]
+    engine = griddiff.FieldEngine(q, q, q, width=3, max_order=2,
+                                  threads=threads)
+    t = best_time(lambda: engine.apply('cartesian_laplacian', wide, out))
+    report('griddiff laplacian strided view', t, out, lap)
+
+    # Point gradient at p0 from 5 values per axis, for m value sets
+    # (shifted test functions): all sets in one call, then one call per set.
+    g = 1.0 + 0.01 * np.arange(5)
+    p0 = g[2]
+    shift = np.linspace(0.0, 1.0, m)[:, None]
+    v1 = np.sin(g + shift)
+    v2 = np.cos(2.0 * g + shift)
+    v3 = np.exp(0.5 * g + shift)
+    exact = np.hstack((np.cos(p0 + shift), -2.0 * np.sin(2.0 * p0 + shift),
+                       0.5 * np.exp(0.5 * p0 + shift)))
+
+    op = griddiff.PointOperator('cartesian_gradient', (p0, p0, p0), g, g, g,
+                                threads=threads)
+    pout = np.empty((m, 3))
+
+    def per_set():
+        for s in range(m):
+            pout[s] = op.eval(v1[s], v2[s], v3[s])
+
+    print('%-36s %10s %12s' % ('point gradient, %d sets' % m, '', ''))
+    t = best_time(lambda: op.eval(v1, v2, v3, pout))
+    print('%-36s %10.2f %12.3e' % ('griddiff eval, all sets', 1e3 * t,
+                                   np.max(np.abs(pout - exact))))
+    t = best_time(per_set, repeat=1)
+    print('%-36s %10.2f %12.3e' % ('griddiff eval, one call per set',
+                                   1e3 * t, np.max(np.abs(pout - exact))))
+
+
+if __name__ == '__main__':
+    main()
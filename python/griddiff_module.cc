@@ -0,0 +1,1209 @@
+/*
+ * File: griddiff_module.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing griddiff Python extension module: FieldEngine
+ * type evaluating field-level operators (see FieldOperators.h header file)
+ * and PointOperator type evaluating point operators (see Gradients.h and
+ * Laplacians.h header files) directly on NumPy arrays (or any other
+ * objects supporting the buffer protocol), without copying them.
+ *
+ * Fields are 3D arrays of shape (n3, n2, n1), i.e. the last index runs
+ * along q1 axis (the memory layout described in qobj.h header file for
+ * C-contiguous arrays). Values can be float32 or float64, with arbitrary
+ * strides. Results are float64 arrays of shape (n3, n2, n1) for scalar
+ * operators and (n3, n2, n1, 3) for vector ones. The GIL is released
+ * during evaluation.
+ *
+ * Point operators take function values along q1, q2 and q3 axes of their
+ * grid as arrays of shape (ni,) (a single set) or (m, ni) (m sets, e.g.
+ * values at m points sharing the grid), float32 or float64 with arbitrary
+ * strides. Sets are evaluated in parallel without the GIL.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <cstring>           /* strcmp */
+#include <exception>         /* std::exception */
+#include <new>               /* std::bad_alloc */
+#include <stdexcept>         /* std::invalid_argument */
+#include <string>            /* std::string */
+#include <vector>            /* std::vector */
+
+#include "field_engine.h"    /* FieldEngine, FieldView */
+#include "FieldOperators.h"  /* *FieldOp */
+#include "Gradients.h"       /* *Gradient */
+#include "Laplacians.h"      /* *Laplacian */
+
+#include <omp.h>             /* omp_get_max_threads */
+
+using namespace GridDiff;
+
+namespace
+{
+
+/*
+ * Operators available by name.
+ */
+const CartesianGradientFieldOp    CARTESIAN_GRADIENT;
+const CartesianLaplacianFieldOp   CARTESIAN_LAPLACIAN;
+const CylindricalGradientFieldOp  CYLINDRICAL_GRADIENT;
+const CylindricalLaplacianFieldOp CYLINDRICAL_LAPLACIAN;
+const SphericalGradientFieldOp    SPHERICAL_GRADIENT;
+const SphericalLaplacianFieldOp   SPHERICAL_LAPLACIAN;
+
+struct NamedOperator
+{
+    const char          * name;
+    const FieldOperator * op;
+};
+
+const NamedOperator OPERATORS[] =
+{
+    { "cartesian_gradient",    &CARTESIAN_GRADIENT    },
+    { "cartesian_laplacian",   &CARTESIAN_LAPLACIAN   },
+    { "cylindrical_gradient",  &CYLINDRICAL_GRADIENT  },
+    { "cylindrical_laplacian", &CYLINDRICAL_LAPLACIAN },
+    { "spherical_gradient",    &SPHERICAL_GRADIENT    },
+    { "spherical_laplacian",   &SPHERICAL_LAPLACIAN   }
+};
+
+const FieldOperator * FindOperator (const char * name)
+{
+    const size_t n = sizeof(OPERATORS) / sizeof(OPERATORS[0]);
+
+    for (size_t i = 0; i < n; ++i){
+        if (std::strcmp(OPERATORS[i].name, name) == 0){
+            return OPERATORS[i].op;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * PointOp class
+ *
+ * Point operator (child class of Basic_3D_DiffOp, whose eval() methods
+ * are not virtual and return QPoint or double) behind a common interface.
+ */
+class PointOp
+{
+    public:
+        virtual ~PointOp () { }
+
+        /* Number of result values. */
+        virtual unsigned components () const = 0;
+
+        /* Number of grid points along qi axis (i = axis+1). */
+        virtual size_t size (const unsigned & axis) const = 0;
+
+        /* Evaluates operator, writing components() values to out. */
+        virtual void eval (const QGrid & v1,
+                           const QGrid & v2,
+                           const QGrid & v3,
+                           double      * out) const = 0;
+};
+
+inline void StoreResult (const QPoint & r, double * out)
+{
+    out[0] = r.q1;
+    out[1] = r.q2;
+    out[2] = r.q3;
+}
+
+inline void StoreResult (const double & r, double * out)
+{
+    out[0] = r;
+}
+
+template <class Op, unsigned NCOMP>
+class PointOpImpl : public PointOp
+{
+    protected:
+        Op mOp;
+
+    public:
+        PointOpImpl (const QPoint & p0,
+                     const QGrid  & q1, const QGrid & q2, const QGrid & q3)
+            : mOp(p0, q1, q2, q3) { }
+
+        unsigned components () const { return NCOMP; }
+
+        size_t size (const unsigned & axis) const
+        {
+            return mOp.coeffTableSize(axis) / (mOp.maxOrder() + 1);
+        }
+
+        void eval (const QGrid & v1,
+                   const QGrid & v2,
+                   const QGrid & v3,
+                   double      * out) const
+        {
+            StoreResult(mOp.eval(v1, v2, v3), out);
+        }
+};
+
+template <class Op, unsigned NCOMP>
+PointOp * CreatePointOp (const QPoint & p0,
+                         const QGrid  & q1, const QGrid & q2, const QGrid & q3)
+{
+    return new PointOpImpl<Op, NCOMP>(p0, q1, q2, q3);
+}
+
+/*
+ * Point operators available by name.
+ */
+struct NamedPointOp
+{
+    const char * name;
+    PointOp   *(*create)(const QPoint &,
+                         const QGrid  &, const QGrid &, const QGrid &);
+};
+
+const NamedPointOp POINT_OPERATORS[] =
+{
+    { "cartesian_gradient",    &CreatePointOp<CartesianGradient,    3> },
+    { "cartesian_laplacian",   &CreatePointOp<CartesianLaplacian,   1> },
+    { "cylindrical_gradient",  &CreatePointOp<CylindricalGradient,  3> },
+    { "cylindrical_laplacian", &CreatePointOp<CylindricalLaplacian, 1> },
+    { "spherical_gradient",    &CreatePointOp<SphericalGradient,    3> },
+    { "spherical_laplacian",   &CreatePointOp<SphericalLaplacian,   1> }
+};
+
+const NamedPointOp * FindPointOperator (const char * name)
+{
+    const size_t n = sizeof(POINT_OPERATORS) / sizeof(POINT_OPERATORS[0]);
+
+    for (size_t i = 0; i < n; ++i){
+        if (std::strcmp(POINT_OPERATORS[i].name, name) == 0){
+            return &POINT_OPERATORS[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Converts a Python sequence of numbers to QGrid. Returns false (with
+ * Python exception set) on failure.
+ */
+bool ToGrid (PyObject * obj, QGrid & grid)
+{
+    PyObject * seq = PySequence_Fast(obj, "coordinates must be a sequence");
+
+    if (seq == NULL){
+        return false;
+    }
+
+    const Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    grid.resize(n);
+
+    for (Py_ssize_t i = 0; i < n; ++i){
+        grid[i] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(seq, i));
+
+        if (grid[i] == -1.0 && PyErr_Occurred()){
+            Py_DECREF(seq);
+            return false;
+        }
+    }
+
+    Py_DECREF(seq);
+    return true;
+}
+
+/*
+ * Returns value type character of a buffer format string (skipping byte
+ * order prefix, which has to be native), or 0 if not supported.
+ */
+char FormatType (const char * format)
+{
+    if (format == NULL){
+        return 'B';
+    }
+
+    if (format[0] == '@' || format[0] == '=' ||
+#if PY_LITTLE_ENDIAN
+        format[0] == '<'
+#else
+        format[0] == '>'
+#endif
+        ){
+        ++format;
+    }
+
+    if ((format[0] == 'd' || format[0] == 'f') && format[1] == '\0'){
+        return format[0];
+    }
+    return 0;
+}
+
+/*
+ * Kinds of C++ exceptions, translated to Python exceptions.
+ */
+enum ErrorKind
+{
+    ERROR_NONE,     /* no exception */
+    ERROR_VALUE,    /* std::invalid_argument (ValueError) */
+    ERROR_MEMORY,   /* std::bad_alloc (MemoryError) */
+    ERROR_RUNTIME   /* other exceptions (RuntimeError) */
+};
+
+/*
+ * Returns kind of C++ exception being handled and sets message to its
+ * description. Does not use Python API, so it can be called without GIL.
+ */
+ErrorKind CaptureException (std::string & message)
+{
+    try {
+        throw;
+    }
+    catch (const std::invalid_argument & e){
+        message = e.what();
+        return ERROR_VALUE;
+    }
+    catch (const std::bad_alloc &){
+        message.clear();
+        return ERROR_MEMORY;
+    }
+    catch (const std::exception & e){
+        message = e.what();
+        return ERROR_RUNTIME;
+    }
+    catch (...){
+        message = "unknown C++ exception";
+        return ERROR_RUNTIME;
+    }
+}
+
+/*
+ * Sets Python exception of given kind (GIL has to be held).
+ */
+void SetError (const ErrorKind   &    kind,
+               const std::string & message)
+{
+    switch (kind){
+        case ERROR_NONE:
+            break;
+        case ERROR_VALUE:
+            PyErr_SetString(PyExc_ValueError, message.c_str());
+            break;
+        case ERROR_MEMORY:
+            PyErr_NoMemory();
+            break;
+        case ERROR_RUNTIME:
+            PyErr_SetString(PyExc_RuntimeError, message.c_str());
+            break;
+    }
+}
+
+/*
+ * Translates C++ exception being handled to Python exception.
+ */
+void SetErrorFromException ()
+{
+    std::string     message;
+    const ErrorKind kind = CaptureException(message);
+
+    SetError(kind, message);
+}
+
+/*
+ * Returns first and one past last byte of memory spanned by a buffer
+ * (strides can be negative).
+ */
+void BufferExtent (const Py_buffer &  buf,
+                   const char     *&   lo,
+                   const char     *&   hi)
+{
+    lo = static_cast<const char *>(buf.buf);
+    hi = lo + buf.itemsize;
+
+    for (int a = 0; a < buf.ndim; ++a){
+        if (buf.shape[a] == 0){
+            hi = lo;
+            return;
+        }
+
+        const Py_ssize_t span = (buf.shape[a] - 1) * buf.strides[a];
+
+        if (span < 0){
+            lo += span;
+        }
+        else {
+            hi += span;
+        }
+    }
+}
+
+
+/*
+ * EngineObject struct
+ *
+ * Python FieldEngine object.
+ */
+struct EngineObject
+{
+    PyObject_HEAD
+    FieldEngine * engine;
+};
+
+void Engine_dealloc (EngineObject * self)
+{
+    delete self->engine;
+    Py_TYPE(self)->tp_free((PyObject *) self);
+}
+
+PyObject * Engine_new (PyTypeObject * type, PyObject *, PyObject *)
+{
+    EngineObject * self = (EngineObject *) type->tp_alloc(type, 0);
+
+    if (self != NULL){
+        self->engine = NULL;
+    }
+    return (PyObject *) self;
+}
+
+int Engine_init (EngineObject * self, PyObject * args, PyObject * kwds)
+{
+    static const char * kwlist[] = { "q1", "q2", "q3", "width", "max_order",
+                                      "threads", NULL };
+    PyObject * o1, * o2, * o3;
+    unsigned   width    = 5,
+               maxOrder = 2,
+               threads  = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOO|III", (char **) kwlist,
+                                     &o1, &o2, &o3,
+                                     &width, &maxOrder, &threads)){
+        return -1;
+    }
+
+    /* Engine is used without GIL, so it cannot be replaced. */
+    if (self->engine != NULL){
+        PyErr_SetString(PyExc_RuntimeError, "engine already initialized");
+        return -1;
+    }
+
+    QGrid q1, q2, q3;
+
+    if (!ToGrid(o1, q1) || !ToGrid(o2, q2) || !ToGrid(o3, q3)){
+        return -1;
+    }
+
+    try {
+        FieldEngine     * engine = new FieldEngine(q1, q2, q3, width, maxOrder);
+        FieldEngineConfig config;
+
+        config.threads = threads;
+        engine->setConfig(config);
+
+        self->engine = engine;
+    }
+    catch (...){
+        SetErrorFromException();
+        return -1;
+    }
+
+    return 0;
+}
+
+PyObject * Engine_shape (EngineObject * self, void *)
+{
+    if (self->engine == NULL){
+        PyErr_SetString(PyExc_RuntimeError, "engine not initialized");
+        return NULL;
+    }
+
+    return Py_BuildValue("(nnn)", (Py_ssize_t) self->engine->n3(),
+                                  (Py_ssize_t) self->engine->n2(),
+                                  (Py_ssize_t) self->engine->n1());
+}
+
+/*
+ * FieldEngine.apply(op, f, out=None)
+ *
+ * Evaluates operator of given name at every grid node of field f.
+ */
+PyObject * Engine_apply (EngineObject * self, PyObject * args, PyObject * kwds)
+{
+    static const char * kwlist[] = { "op", "f", "out", NULL };
+    const char * name;
+    PyObject   * fObj;
+    PyObject   * outObj = Py_None;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO|O", (char **) kwlist,
+                                     &name, &fObj, &outObj)){
+        return NULL;
+    }
+
+    if (self->engine == NULL){
+        PyErr_SetString(PyExc_RuntimeError, "engine not initialized");
+        return NULL;
+    }
+
+    const FieldOperator * op = FindOperator(name);
+
+    if (op == NULL){
+        PyErr_Format(PyExc_ValueError, "unknown operator '%s'", name);
+        return NULL;
+    }
+
+    const FieldEngine & engine = *self->engine;
+    const Py_ssize_t    n[3]   = { (Py_ssize_t) engine.n3(),
+                                   (Py_ssize_t) engine.n2(),
+                                   (Py_ssize_t) engine.n1() };
+    const unsigned      ncomp  = op->components();
+
+    /* Input field (any strides, float32 or float64). */
+    Py_buffer fBuf;
+
+    if (PyObject_GetBuffer(fObj, &fBuf, PyBUF_STRIDES | PyBUF_FORMAT) != 0){
+        return NULL;
+    }
+
+    const char type = FormatType(fBuf.format);
+
+    if (type == 0){
+        PyBuffer_Release(&fBuf);
+        PyErr_SetString(PyExc_TypeError, "field values must be float32 "
+                                         "or float64");
+        return NULL;
+    }
+
+    if (fBuf.ndim != 3 || fBuf.shape[0] != n[0] || fBuf.shape[1] != n[1]
+                       || fBuf.shape[2] != n[2]){
+        PyBuffer_Release(&fBuf);
+        PyErr_Format(PyExc_ValueError, "field must be of shape (%zd, %zd, "
+                     "%zd)", n[0], n[1], n[2]);
+        return NULL;
+    }
+
+    FieldView view;
+    view.data = fBuf.buf;
+    view.type = (type == 'd') ? FIELD_FLOAT64 : FIELD_FLOAT32;
+
+    for (int a = 0; a < 3; ++a){
+        if (fBuf.strides[a] % fBuf.itemsize != 0){
+            PyBuffer_Release(&fBuf);
+            PyErr_SetString(PyExc_ValueError, "field strides are not "
+                                              "multiples of item size");
+            return NULL;
+        }
+        view.strides[2-a] = fBuf.strides[a] / fBuf.itemsize;
+    }
+
+    /* Output field (new or given C-contiguous float64 array). */
+    PyObject * result;
+
+    if (outObj == Py_None){
+        PyObject * numpy = PyImport_ImportModule("numpy");
+
+        if (numpy == NULL){
+            PyBuffer_Release(&fBuf);
+            return NULL;
+        }
+
+        result = (ncomp == 1)
+               ? PyObject_CallMethod(numpy, "empty", "((nnn))",
+                                     n[0], n[1], n[2])
+               : PyObject_CallMethod(numpy, "empty", "((nnnI))",
+                                     n[0], n[1], n[2], ncomp);
+        Py_DECREF(numpy);
+
+        if (result == NULL){
+            PyBuffer_Release(&fBuf);
+            return NULL;
+        }
+    }
+    else {
+        result = outObj;
+        Py_INCREF(result);
+    }
+
+    Py_buffer outBuf;
+
+    if (PyObject_GetBuffer(result, &outBuf, PyBUF_C_CONTIGUOUS |
+                                            PyBUF_WRITABLE     |
+                                            PyBUF_FORMAT) != 0){
+        Py_DECREF(result);
+        PyBuffer_Release(&fBuf);
+        return NULL;
+    }
+
+    if (FormatType(outBuf.format) != 'd' ||
+        outBuf.len != (Py_ssize_t) (engine.size() * ncomp * sizeof(double))){
+        PyBuffer_Release(&outBuf);
+        Py_DECREF(result);
+        PyBuffer_Release(&fBuf);
+        PyErr_Format(PyExc_ValueError, "out must be a C-contiguous float64 "
+                     "array of %zd values", (Py_ssize_t) (engine.size()*ncomp));
+        return NULL;
+    }
+
+    /* Rows of f are read while rows of out are written, so they cannot
+     * share memory. */
+    const char * fLo, * fHi, * oLo, * oHi;
+
+    BufferExtent(fBuf,   fLo, fHi);
+    BufferExtent(outBuf, oLo, oHi);
+
+    if (fLo < oHi && oLo < fHi){
+        PyBuffer_Release(&outBuf);
+        Py_DECREF(result);
+        PyBuffer_Release(&fBuf);
+        PyErr_SetString(PyExc_ValueError, "out must not overlap f");
+        return NULL;
+    }
+
+    /* Evaluation without GIL. Buffers (and the engine, kept alive by the
+     * method call) are not released before reacquiring it; exceptions are
+     * translated after that. */
+    ErrorKind   error = ERROR_NONE;
+    std::string message;
+
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        engine.apply(*op, view, static_cast<double *>(outBuf.buf));
+    }
+    catch (...){
+        error = CaptureException(message);
+    }
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&outBuf);
+    PyBuffer_Release(&fBuf);
+
+    if (error != ERROR_NONE){
+        Py_DECREF(result);
+        SetError(error, message);
+        return NULL;
+    }
+
+    return result;
+}
+
+PyObject * Module_operators (PyObject *, PyObject *)
+{
+    const size_t n    = sizeof(OPERATORS) / sizeof(OPERATORS[0]);
+    PyObject   * list = PyList_New(n);
+
+    if (list == NULL){
+        return NULL;
+    }
+
+    for (size_t i = 0; i < n; ++i){
+        PyObject * s = PyUnicode_FromString(OPERATORS[i].name);
+
+        if (s == NULL){
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, s);
+    }
+
+    return list;
+}
+
+
+PyMethodDef ENGINE_METHODS[] =
+{
+    { "apply", (PyCFunction) (void (*)(void)) Engine_apply,
+      METH_VARARGS | METH_KEYWORDS,
+      "apply(op, f, out=None)\n\n"
+      "Evaluates operator of given name at every grid node of field f\n"
+      "(array of shape (n3, n2, n1), float32 or float64, any strides).\n"
+      "Returns out (or a new float64 array) of shape (n3, n2, n1) for\n"
+      "scalar operators and (n3, n2, n1, 3) for vector ones; out cannot\n"
+      "overlap f." },
+    { NULL, NULL, 0, NULL }
+};
+
+PyGetSetDef ENGINE_GETSET[] =
+{
+    { (char *) "shape", (getter) Engine_shape, NULL,
+      (char *) "Shape (n3, n2, n1) of fields.", NULL },
+    { NULL, NULL, NULL, NULL, NULL }
+};
+
+PyTypeObject ENGINE_TYPE =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "griddiff.FieldEngine",                   /* tp_name */
+    sizeof(EngineObject),                     /* tp_basicsize */
+    0,                                        /* tp_itemsize */
+    (destructor) Engine_dealloc,              /* tp_dealloc */
+    0,                                        /* tp_vectorcall_offset */
+    0,                                        /* tp_getattr */
+    0,                                        /* tp_setattr */
+    0,                                        /* tp_as_async */
+    0,                                        /* tp_repr */
+    0,                                        /* tp_as_number */
+    0,                                        /* tp_as_sequence */
+    0,                                        /* tp_as_mapping */
+    0,                                        /* tp_hash */
+    0,                                        /* tp_call */
+    0,                                        /* tp_str */
+    0,                                        /* tp_getattro */
+    0,                                        /* tp_setattro */
+    0,                                        /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                       /* tp_flags */
+    "FieldEngine(q1, q2, q3, width=5, max_order=2, threads=0)\n\n"
+    "Evaluates differential operators at all nodes of a tensor grid with\n"
+    "given coordinates along q1, q2 and q3 axes.",  /* tp_doc */
+    0,                                        /* tp_traverse */
+    0,                                        /* tp_clear */
+    0,                                        /* tp_richcompare */
+    0,                                        /* tp_weaklistoffset */
+    0,                                        /* tp_iter */
+    0,                                        /* tp_iternext */
+    ENGINE_METHODS,                           /* tp_methods */
+    0,                                        /* tp_members */
+    ENGINE_GETSET,                            /* tp_getset */
+    0,                                        /* tp_base */
+    0,                                        /* tp_dict */
+    0,                                        /* tp_descr_get */
+    0,                                        /* tp_descr_set */
+    0,                                        /* tp_dictoffset */
+    (initproc) Engine_init,                   /* tp_init */
+    0,                                        /* tp_alloc */
+    Engine_new,                               /* tp_new */
+};
+
+/*
+ * ValuesBuffer struct
+ *
+ * Function values along one axis of a point operator grid: buffer of shape
+ * (ni,) or (m, ni), released on destruction (GIL has to be held).
+ */
+struct ValuesBuffer
+{
+    Py_buffer  buf;
+    bool       held;
+    char       type;      /* 'd' or 'f' */
+    Py_ssize_t step;      /* stride between values, in items */
+
+    ValuesBuffer () : held(false), type(0), step(0) { }
+
+    ~ValuesBuffer ()
+    {
+        if (held){
+            PyBuffer_Release(&buf);
+        }
+    }
+
+    /* Number of value sets (1 for 1D buffers). */
+    Py_ssize_t sets () const
+    {
+        return (buf.ndim == 2) ? buf.shape[0] : 1;
+    }
+
+    /* Copies values of given set to v (no Python API used). */
+    void gather (const Py_ssize_t & set, QGrid & v) const
+    {
+        const char * row = static_cast<const char *>(buf.buf)
+                         + ((buf.ndim == 2) ? set * buf.strides[0] : 0);
+
+        if (type == 'd'){
+            const double * x = reinterpret_cast<const double *>(row);
+
+            for (size_t i = 0; i < v.size(); ++i){
+                v[i] = x[i * step];
+            }
+        }
+        else {
+            const float * x = reinterpret_cast<const float *>(row);
+
+            for (size_t i = 0; i < v.size(); ++i){
+                v[i] = x[i * step];
+            }
+        }
+    }
+};
+
+/*
+ * Acquires buffer of values along an axis with n points. Returns false
+ * (with Python exception set) on failure.
+ */
+bool GetValues (PyObject * obj, const size_t & n, ValuesBuffer & values)
+{
+    if (PyObject_GetBuffer(obj, &values.buf,
+                           PyBUF_STRIDES | PyBUF_FORMAT) != 0){
+        return false;
+    }
+    values.held = true;
+    values.type = FormatType(values.buf.format);
+
+    if (values.type == 0){
+        PyErr_SetString(PyExc_TypeError, "values must be float32 or float64");
+        return false;
+    }
+
+    const int ndim = values.buf.ndim;
+
+    if ((ndim != 1 && ndim != 2) ||
+        values.buf.shape[ndim-1] != (Py_ssize_t) n){
+        PyErr_Format(PyExc_ValueError, "values must be of shape (%zd,) or "
+                     "(m, %zd)", (Py_ssize_t) n, (Py_ssize_t) n);
+        return false;
+    }
+
+    for (int a = 0; a < ndim; ++a){
+        if (values.buf.strides[a] % values.buf.itemsize != 0){
+            PyErr_SetString(PyExc_ValueError, "values strides are not "
+                                              "multiples of item size");
+            return false;
+        }
+    }
+    values.step = values.buf.strides[ndim-1] / values.buf.itemsize;
+
+    return true;
+}
+
+
+/*
+ * PointOperatorObject struct
+ *
+ * Python PointOperator object.
+ */
+struct PointOperatorObject
+{
+    PyObject_HEAD
+    PointOp  * op;
+    unsigned   threads;
+};
+
+void PointOperator_dealloc (PointOperatorObject * self)
+{
+    delete self->op;
+    Py_TYPE(self)->tp_free((PyObject *) self);
+}
+
+PyObject * PointOperator_new (PyTypeObject * type, PyObject *, PyObject *)
+{
+    PointOperatorObject * self = (PointOperatorObject *)
+                                 type->tp_alloc(type, 0);
+
+    if (self != NULL){
+        self->op      = NULL;
+        self->threads = 0;
+    }
+    return (PyObject *) self;
+}
+
+int PointOperator_init (PointOperatorObject * self, PyObject * args,
+                        PyObject * kwds)
+{
+    static const char * kwlist[] = { "op", "point", "q1", "q2", "q3",
+                                      "threads", NULL };
+    const char * name;
+    PyObject   * po, * o1, * o2, * o3;
+    unsigned     threads = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sOOOO|I", (char **) kwlist,
+                                     &name, &po, &o1, &o2, &o3, &threads)){
+        return -1;
+    }
+
+    /* Operator is used without GIL, so it cannot be replaced. */
+    if (self->op != NULL){
+        PyErr_SetString(PyExc_RuntimeError, "operator already initialized");
+        return -1;
+    }
+
+    const NamedPointOp * named = FindPointOperator(name);
+
+    if (named == NULL){
+        PyErr_Format(PyExc_ValueError, "unknown operator '%s'", name);
+        return -1;
+    }
+
+    QGrid p, q1, q2, q3;
+
+    if (!ToGrid(po, p) || !ToGrid(o1, q1) || !ToGrid(o2, q2) ||
+        !ToGrid(o3, q3)){
+        return -1;
+    }
+
+    if (p.size() != 3){
+        PyErr_SetString(PyExc_ValueError, "point must have 3 coordinates");
+        return -1;
+    }
+
+    QPoint p0;
+    p0.q1 = p[0];
+    p0.q2 = p[1];
+    p0.q3 = p[2];
+
+    try {
+        self->op = named->create(p0, q1, q2, q3);
+    }
+    catch (...){
+        SetErrorFromException();
+        return -1;
+    }
+    self->threads = threads;
+
+    return 0;
+}
+
+PyObject * PointOperator_shape (PointOperatorObject * self, void *)
+{
+    if (self->op == NULL){
+        PyErr_SetString(PyExc_RuntimeError, "operator not initialized");
+        return NULL;
+    }
+
+    return Py_BuildValue("(nnn)", (Py_ssize_t) self->op->size(0),
+                                  (Py_ssize_t) self->op->size(1),
+                                  (Py_ssize_t) self->op->size(2));
+}
+
+PyObject * PointOperator_components (PointOperatorObject * self, void *)
+{
+    if (self->op == NULL){
+        PyErr_SetString(PyExc_RuntimeError, "operator not initialized");
+        return NULL;
+    }
+
+    return PyLong_FromUnsignedLong(self->op->components());
+}
+
+/*
+ * PointOperator.eval(v1, v2, v3, out=None)
+ *
+ * Evaluates operator for a single set or m sets of function values.
+ */
+PyObject * PointOperator_eval (PointOperatorObject * self, PyObject * args,
+                               PyObject * kwds)
+{
+    static const char * kwlist[] = { "v1", "v2", "v3", "out", NULL };
+    PyObject * vObj[3];
+    PyObject * outObj = Py_None;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOO|O", (char **) kwlist,
+                                     &vObj[0], &vObj[1], &vObj[2], &outObj)){
+        return NULL;
+    }
+
+    if (self->op == NULL){
+        PyErr_SetString(PyExc_RuntimeError, "operator not initialized");
+        return NULL;
+    }
+
+    const PointOp & op    = *self->op;
+    const unsigned  ncomp = op.components();
+    ValuesBuffer    values[3];
+
+    for (unsigned a = 0; a < 3; ++a){
+        if (!GetValues(vObj[a], op.size(a), values[a])){
+            return NULL;
+        }
+    }
+
+    const int        ndim = values[0].buf.ndim;
+    const Py_ssize_t m    = values[0].sets();
+
+    for (unsigned a = 1; a < 3; ++a){
+        if (values[a].buf.ndim != ndim || values[a].sets() != m){
+            PyErr_SetString(PyExc_ValueError, "v1, v2 and v3 must hold the "
+                                              "same number of value sets");
+            return NULL;
+        }
+    }
+
+    /* Single set: result returned as a float or a tuple. */
+    if (ndim == 1){
+        if (outObj != Py_None){
+            PyErr_SetString(PyExc_ValueError, "out requires value sets of "
+                                              "shape (m, ni)");
+            return NULL;
+        }
+
+        QGrid  v[3];
+        double r[3];
+
+        try {
+            for (unsigned a = 0; a < 3; ++a){
+                v[a].resize(op.size(a));
+                values[a].gather(0, v[a]);
+            }
+            op.eval(v[0], v[1], v[2], r);
+        }
+        catch (...){
+            SetErrorFromException();
+            return NULL;
+        }
+
+        return (ncomp == 1) ? PyFloat_FromDouble(r[0])
+                            : Py_BuildValue("(ddd)", r[0], r[1], r[2]);
+    }
+
+    /* Output values (new or given C-contiguous float64 array). */
+    PyObject * result;
+
+    if (outObj == Py_None){
+        PyObject * numpy = PyImport_ImportModule("numpy");
+
+        if (numpy == NULL){
+            return NULL;
+        }
+
+        result = (ncomp == 1)
+               ? PyObject_CallMethod(numpy, "empty", "((n))", m)
+               : PyObject_CallMethod(numpy, "empty", "((nI))", m, ncomp);
+        Py_DECREF(numpy);
+
+        if (result == NULL){
+            return NULL;
+        }
+    }
+    else {
+        result = outObj;
+        Py_INCREF(result);
+    }
+
+    Py_buffer outBuf;
+
+    if (PyObject_GetBuffer(result, &outBuf, PyBUF_C_CONTIGUOUS |
+                                            PyBUF_WRITABLE     |
+                                            PyBUF_FORMAT) != 0){
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    if (FormatType(outBuf.format) != 'd' ||
+        outBuf.len != (Py_ssize_t) (m * ncomp * sizeof(double))){
+        PyBuffer_Release(&outBuf);
+        Py_DECREF(result);
+        PyErr_Format(PyExc_ValueError, "out must be a C-contiguous float64 "
+                     "array of %zd values", (Py_ssize_t) (m * ncomp));
+        return NULL;
+    }
+
+    /* Sets are read while results are written, so they cannot share
+     * memory. */
+    const char * oLo, * oHi;
+
+    BufferExtent(outBuf, oLo, oHi);
+
+    for (unsigned a = 0; a < 3; ++a){
+        const char * vLo, * vHi;
+
+        BufferExtent(values[a].buf, vLo, vHi);
+
+        if (vLo < oHi && oLo < vHi){
+            PyBuffer_Release(&outBuf);
+            Py_DECREF(result);
+            PyErr_SetString(PyExc_ValueError, "out must not overlap values");
+            return NULL;
+        }
+    }
+
+    /* Evaluation without GIL, every thread gathering sets to its own
+     * grids; the first exception is translated after reacquiring it. */
+    double    * out     = static_cast<double *>(outBuf.buf);
+    const int   threads = (self->threads > 0) ? (int) self->threads
+                                              : omp_get_max_threads();
+    ErrorKind   error   = ERROR_NONE;
+    std::string message;
+
+    Py_BEGIN_ALLOW_THREADS
+    #pragma omp parallel num_threads(threads)
+    {
+        QGrid     v[3];
+        ErrorKind localError = ERROR_NONE;
+        std::string localMessage;
+
+        try {
+            for (unsigned a = 0; a < 3; ++a){
+                v[a].resize(op.size(a));
+            }
+        }
+        catch (...){
+            localError = CaptureException(localMessage);
+        }
+
+        #pragma omp for schedule(static)
+        for (Py_ssize_t s = 0; s < m; ++s){
+            if (localError != ERROR_NONE){
+                continue;
+            }
+
+            try {
+                for (unsigned a = 0; a < 3; ++a){
+                    values[a].gather(s, v[a]);
+                }
+                op.eval(v[0], v[1], v[2], out + s * ncomp);
+            }
+            catch (...){
+                localError = CaptureException(localMessage);
+            }
+        }
+
+        if (localError != ERROR_NONE){
+            #pragma omp critical (griddiff_point_error)
+            if (error == ERROR_NONE){
+                error   = localError;
+                message = localMessage;
+            }
+        }
+    }
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&outBuf);
+
+    if (error != ERROR_NONE){
+        Py_DECREF(result);
+        SetError(error, message);
+        return NULL;
+    }
+
+    return result;
+}
+
+PyObject * Module_point_operators (PyObject *, PyObject *)
+{
+    const size_t n    = sizeof(POINT_OPERATORS) / sizeof(POINT_OPERATORS[0]);
+    PyObject   * list = PyList_New(n);
+
+    if (list == NULL){
+        return NULL;
+    }
+
+    for (size_t i = 0; i < n; ++i){
+        PyObject * s = PyUnicode_FromString(POINT_OPERATORS[i].name);
+
+        if (s == NULL){
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, s);
+    }
+
+    return list;
+}
+
+
+PyMethodDef POINT_OPERATOR_METHODS[] =
+{
+    { "eval", (PyCFunction) (void (*)(void)) PointOperator_eval,
+      METH_VARARGS | METH_KEYWORDS,
+      "eval(v1, v2, v3, out=None)\n\n"
+      "Evaluates operator for function values along q1, q2 and q3 axes\n"
+      "(float32 or float64, any strides). Values of shape (ni,) give a\n"
+      "float (scalar operators) or a 3-tuple (vector ones); values of\n"
+      "shape (m, ni) give out (or a new float64 array) of shape (m,) or\n"
+      "(m, 3), evaluating the m sets in parallel; out cannot overlap\n"
+      "values." },
+    { NULL, NULL, 0, NULL }
+};
+
+PyGetSetDef POINT_OPERATOR_GETSET[] =
+{
+    { (char *) "shape", (getter) PointOperator_shape, NULL,
+      (char *) "Numbers of grid points (n1, n2, n3) along q1, q2 and q3.",
+      NULL },
+    { (char *) "components", (getter) PointOperator_components, NULL,
+      (char *) "Number of result values (1 or 3).", NULL },
+    { NULL, NULL, NULL, NULL, NULL }
+};
+
+PyTypeObject POINT_OPERATOR_TYPE =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "griddiff.PointOperator",                 /* tp_name */
+    sizeof(PointOperatorObject),              /* tp_basicsize */
+    0,                                        /* tp_itemsize */
+    (destructor) PointOperator_dealloc,       /* tp_dealloc */
+    0,                                        /* tp_vectorcall_offset */
+    0,                                        /* tp_getattr */
+    0,                                        /* tp_setattr */
+    0,                                        /* tp_as_async */
+    0,                                        /* tp_repr */
+    0,                                        /* tp_as_number */
+    0,                                        /* tp_as_sequence */
+    0,                                        /* tp_as_mapping */
+    0,                                        /* tp_hash */
+    0,                                        /* tp_call */
+    0,                                        /* tp_str */
+    0,                                        /* tp_getattro */
+    0,                                        /* tp_setattro */
+    0,                                        /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                       /* tp_flags */
+    "PointOperator(op, point, q1, q2, q3, threads=0)\n\n"
+    "Evaluates differential operator of given name at point (q1, q2, q3)\n"
+    "from function values at grid points with given coordinates along\n"
+    "q1, q2 and q3 axes.",                    /* tp_doc */
+    0,                                        /* tp_traverse */
+    0,                                        /* tp_clear */
+    0,                                        /* tp_richcompare */
+    0,                                        /* tp_weaklistoffset */
+    0,                                        /* tp_iter */
+    0,                                        /* tp_iternext */
+    POINT_OPERATOR_METHODS,                   /* tp_methods */
+    0,                                        /* tp_members */
+    POINT_OPERATOR_GETSET,                    /* tp_getset */
+    0,                                        /* tp_base */
+    0,                                        /* tp_dict */
+    0,                                        /* tp_descr_get */
+    0,                                        /* tp_descr_set */
+    0,                                        /* tp_dictoffset */
+    (initproc) PointOperator_init,            /* tp_init */
+    0,                                        /* tp_alloc */
+    PointOperator_new,                        /* tp_new */
+};
+
+PyMethodDef MODULE_METHODS[] =
+{
+    { "operators", Module_operators, METH_NOARGS,
+      "operators()\n\nNames of operators accepted by FieldEngine.apply()." },
+    { "point_operators", Module_point_operators, METH_NOARGS,
+      "point_operators()\n\nNames of operators accepted by PointOperator." },
+    { NULL, NULL, 0, NULL }
+};
+
+PyModuleDef MODULE =
+{
+    PyModuleDef_HEAD_INIT,
+    "griddiff",
+    "Evaluation of differential operators on tensor grids.",
+    -1,
+    MODULE_METHODS,
+    NULL, NULL, NULL, NULL
+};
+
+} /* anonymous namespace */
+
+
+PyMODINIT_FUNC PyInit_griddiff (void)
+{
+    if (PyType_Ready(&ENGINE_TYPE) < 0 ||
+        PyType_Ready(&POINT_OPERATOR_TYPE) < 0){
+        return NULL;
+    }
+
+    PyObject * module = PyModule_Create(&MODULE);
+
+    if (module == NULL){
+        return NULL;
+    }
+
+    Py_INCREF(&ENGINE_TYPE);
+    if (PyModule_AddObject(module, "FieldEngine",
+                           (PyObject *) &ENGINE_TYPE) < 0){
+        Py_DECREF(&ENGINE_TYPE);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&POINT_OPERATOR_TYPE);
+    if (PyModule_AddObject(module, "PointOperator",
+                           (PyObject *) &POINT_OPERATOR_TYPE) < 0){
+        Py_DECREF(&POINT_OPERATOR_TYPE);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    return module;
+}
@@ -0,0 +1,38 @@
+#
+# File: setup.py
+# Author(s): P Kuszaj
+# Last changed: 18.10.2026
+#
+# Build script of griddiff Python extension module (see griddiff_module.cc
+# source file). Usage: python setup.py build_ext --inplace
+#
+
+import os
+
+from setuptools import setup, Extension
+
+SRC = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                   '..', 'src'))
+
+griddiff = Extension(
+    'griddiff',
+    sources=['griddiff_module.cc'] + [
+        os.path.join(SRC, name) for name in ('axis_plan.cc',
+                                             'basic_3D_diffop.cc',
+                                             'bricked_field.cc',
+                                             'CartesianGradient.cc',
+                                             'CartesianLaplacian.cc',
+                                             'CylindricalGradient.cc',
+                                             'CylindricalLaplacian.cc',
+                                             'field_engine.cc',
+                                             'FieldOperators.cc',
+                                             'fornberg_nderivs.c',
+                                             'SphericalGradient.cc',
+                                             'SphericalLaplacian.cc',
+                                             'stencil_table.cc')],
+    include_dirs=[SRC],
+    extra_compile_args=['-O3', '-fopenmp'],
+    extra_link_args=['-fopenmp'],
+)
+
+setup(name='griddiff', version='0.1', ext_modules=[griddiff])
@@ -1,7 +1,7 @@
 /*
  * File: CartesianGradient.cc
  * Author(s): P Kuszaj
- * Last changed: 29.01.2015
+ * Last changed: 18.10.2026
  *
  * A source file providing CartesianGradient class methods implementation
  * (declared in CartesianGradient.h header file).
@@ -14,7 +14,7 @@ namespace GridDiff
 
 QPoint CartesianGradient::eval(const QGrid & xVals,
                                const QGrid & yVals,
-                               const QGrid & zVals)
+                               const QGrid & zVals) const
 {
     /*             [ df/dx ]
        Lf(x,y,z) = [ df/dy ]
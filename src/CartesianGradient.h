@@ -1,7 +1,7 @@
 /*
  * File: CartesianGradient.h
  * Author(s): P Kuszaj
- * Last changed: 29.01.2015
+ * Last changed: 18.10.2026
  *
  * A header file providing CartesianGradient class used for evaluating
  * gradient at a given point in cartesian coordinate system using given grid
@@ -90,7 +90,7 @@ class CartesianGradient : public Basic_3D_DiffOp
          */
         QPoint eval(const QGrid & xVals,
                     const QGrid & yVals,
-                    const QGrid & zVals);
+                    const QGrid & zVals) const;
 
 }; /* class CartesianGradient */
 
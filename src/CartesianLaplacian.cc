@@ -14,7 +14,7 @@ namespace GridDiff
 
 double CartesianLaplacian::eval(const QGrid & xVals,
                                 const QGrid & yVals,
-                                const QGrid & zVals)
+                                const QGrid & zVals) const
 {
     /* Lf(x,y,z) = d^2f/dx^2 + d^2f/dy^2 +  d^2f/dz^2 */
     return   fEvalQ1Diff(2, xVals)
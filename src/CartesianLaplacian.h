@@ -90,7 +90,7 @@ class CartesianLaplacian : public Basic_3D_DiffOp
          */
         double eval(const QGrid & xVals,
                     const QGrid & yVals,
-                    const QGrid & zVals);
+                    const QGrid & zVals) const;
 
 }; /* class CartesianLaplacian */
 
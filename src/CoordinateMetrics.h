@@ -0,0 +1,178 @@
+/*
+ * File: CoordinateMetrics.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing metric policy classes of orthogonal coordinate
+ * systems, used as template parameters of curvilinear operators (see
+ * CurvilinearOperators.h header file).
+ *
+ * A metric policy supplies Lame scale factors h1, h2, h3 of coordinates
+ * (q1, q2, q3) and their derivatives through a const member function:
+ *
+ *     void scales (const double & q1, const double & q2,
+ *                  double * h, double * dh) const;
+ *
+ * writing h[i] = h(i+1) and dh[3*a + i] = d h(i+1) / dq(a+1) for a=0,1.
+ * Scale factors cannot depend on q3 (it is the translation or rotation
+ * coordinate in all supported systems), so metric tables are built for
+ * the q1-q2 plane of a grid only.
+ */
+
+#ifndef GRIDDIFF_COORDINATEMETRICS_H
+#define GRIDDIFF_COORDINATEMETRICS_H
+
+#include <cmath>  /* sin, cos, sinh, cosh, sqrt */
+
+namespace GridDiff
+{
+
+/*
+ * CartesianMetric class
+ *
+ * Cartesian coordinate system (x, y, z).
+ */
+class CartesianMetric
+{
+    public:
+        void scales (const double &, const double &,
+                     double * h, double * dh) const
+        {
+            h[0] = 1.0; h[1] = 1.0; h[2] = 1.0;
+
+            for (unsigned i = 0; i < 6; ++i){
+                dh[i] = 0.0;
+            }
+        }
+
+}; /* class CartesianMetric */
+
+
+/*
+ * CylindricalMetric class
+ *
+ * Cylindrical coordinate system (rho, phi, z) ordered as (q1, q2, q3).
+ */
+class CylindricalMetric
+{
+    public:
+        void scales (const double & rho, const double &,
+                     double * h, double * dh) const
+        {
+            h[0]  = 1.0; h[1]  = rho; h[2]  = 1.0;
+            dh[0] = 0.0; dh[1] = 1.0; dh[2] = 0.0;
+            dh[3] = 0.0; dh[4] = 0.0; dh[5] = 0.0;
+        }
+
+}; /* class CylindricalMetric */
+
+
+/*
+ * SphericalMetric class
+ *
+ * Spherical coordinate system (r, theta, phi).
+ */
+class SphericalMetric
+{
+    public:
+        void scales (const double & r, const double & theta,
+                     double * h, double * dh) const
+        {
+            const double s = sin(theta);
+            const double c = cos(theta);
+
+            h[0]  = 1.0; h[1]  = r;   h[2]  = r * s;
+            dh[0] = 0.0; dh[1] = 1.0; dh[2] = s;
+            dh[3] = 0.0; dh[4] = 0.0; dh[5] = r * c;
+        }
+
+}; /* class SphericalMetric */
+
+
+/*
+ * ProlateSpheroidalMetric class
+ *
+ * Prolate spheroidal coordinate system (mu, nu, phi) with foci at z = -a
+ * and z = a:
+ *     x = a sinh(mu) sin(nu) cos(phi)
+ *     y = a sinh(mu) sin(nu) sin(phi)
+ *     z = a cosh(mu) cos(nu)
+ */
+class ProlateSpheroidalMetric
+{
+    protected:
+        double mA;
+
+    public:
+        ProlateSpheroidalMetric (const double & a = 1.0) : mA(a) { }
+
+        void scales (const double & mu, const double & nu,
+                     double * h, double * dh) const
+        {
+            const double shm = sinh(mu), chm = cosh(mu);
+            const double sn  = sin(nu),  cn  = cos(nu);
+            const double S   = sqrt(shm * shm + sn * sn);
+
+            h[0]  = mA * S;
+            h[1]  = mA * S;
+            h[2]  = mA * shm * sn;
+
+            /* d/dmu */
+            dh[0] = mA * shm * chm / S;
+            dh[1] = dh[0];
+            dh[2] = mA * chm * sn;
+
+            /* d/dnu */
+            dh[3] = mA * sn * cn / S;
+            dh[4] = dh[3];
+            dh[5] = mA * shm * cn;
+        }
+
+}; /* class ProlateSpheroidalMetric */
+
+
+/*
+ * ToroidalMetric class
+ *
+ * Toroidal coordinate system (tau, sigma, phi) with focal ring of radius
+ * a:
+ *     x = a sinh(tau) cos(phi) / (cosh(tau) - cos(sigma))
+ *     y = a sinh(tau) sin(phi) / (cosh(tau) - cos(sigma))
+ *     z = a sin(sigma)         / (cosh(tau) - cos(sigma))
+ */
+class ToroidalMetric
+{
+    protected:
+        double mA;
+
+    public:
+        ToroidalMetric (const double & a = 1.0) : mA(a) { }
+
+        void scales (const double & tau, const double & sigma,
+                     double * h, double * dh) const
+        {
+            const double sht = sinh(tau),  cht = cosh(tau);
+            const double ss  = sin(sigma), cs  = cos(sigma);
+            const double D   = cht - cs;
+            const double D2  = D * D;
+
+            h[0]  = mA / D;
+            h[1]  = mA / D;
+            h[2]  = mA * sht / D;
+
+            /* d/dtau */
+            dh[0] = - mA * sht / D2;
+            dh[1] = dh[0];
+            dh[2] = mA * (1.0 - cht * cs) / D2;
+
+            /* d/dsigma */
+            dh[3] = - mA * ss / D2;
+            dh[4] = dh[3];
+            dh[5] = - mA * sht * ss / D2;
+        }
+
+}; /* class ToroidalMetric */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_COORDINATEMETRICS_H */
@@ -0,0 +1,298 @@
+/*
+ * File: CurvilinearOperators.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing field-level gradient and Laplace operators and
+ * divergence function for any orthogonal coordinate system, described by
+ * a metric policy class given as a template parameter (see
+ * CoordinateMetrics.h header file). Metric terms are evaluated once per
+ * grid (for every node of the q1-q2 plane) and stored in tables.
+ */
+
+#ifndef GRIDDIFF_CURVILINEAROPERATORS_H
+#define GRIDDIFF_CURVILINEAROPERATORS_H
+
+#include "field_engine.h"       /* FieldEngine */
+#include "field_operator.h"     /* FieldOperator */
+#include "CoordinateMetrics.h"  /* *Metric */
+
+#include <vector>               /* std::vector */
+
+namespace GridDiff
+{
+
+/*
+ * MetricTable class
+ *
+ * Metric terms of a coordinate system at nodes (i1,i2) of the q1-q2 plane
+ * of a grid (node index p = i1 + n1*i2):
+ *     h(p,i)    scale factor h(i+1),
+ *     invH(p,i) 1/h(i+1),
+ *     lap1(p,i) coefficient of df/dq(i+1) in Laplace operator,
+ *     lap2(p,i) coefficient of d^2f/dq(i+1)^2 in Laplace operator.
+ *
+ * Laplace operator in orthogonal coordinates (J = h1*h2*h3):
+ *     Lf = sum over i of 1/J * d/dqi ( J/hi^2 * df/dqi )
+ * thus lap2 = 1/hi^2 and lap1 = 1/J * d/dqi (J/hi^2).
+ */
+template <class Metric>
+class MetricTable
+{
+    protected:
+        size_t              mN1,
+                            mN2;
+        std::vector<double> mTerms;
+
+    public:
+        MetricTable (const FieldEngine & engine,
+                     const Metric      & metric = Metric())
+            : mN1   (engine.n1()),
+              mN2   (engine.n2()),
+              mTerms(12 * engine.n1() * engine.n2())
+        {
+            const QGrid & q1 = engine.coords(AXIS_Q1);
+            const QGrid & q2 = engine.coords(AXIS_Q2);
+
+            for (size_t i2 = 0; i2 < q2.size(); ++i2){
+                for (size_t i1 = 0; i1 < q1.size(); ++i1){
+                    double * t = &mTerms[12 * (i1 + mN1 * i2)];
+                    double   h[3], dh[6];
+
+                    metric.scales(q1[i1], q2[i2], h, dh);
+
+                    for (unsigned i = 0; i < 3; ++i){
+                        const unsigned j = (i + 1) % 3,
+                                       k = (i + 2) % 3;
+
+                        t[i]     = h[i];
+                        t[3 + i] = 1.0 / h[i];
+                        t[9 + i] = 1.0 / (h[i] * h[i]);
+
+                        /* d/dqi (hj*hk/hi) / J; zero along q3. */
+                        t[6 + i] = (i == 2) ? 0.0
+                                 : ( dh[3*i + j] / h[j]
+                                   + dh[3*i + k] / h[k]
+                                   - dh[3*i + i] / h[i] ) * t[9 + i];
+                    }
+                }
+            }
+        }
+
+        /* True if the table covers q1-q2 plane of n1 x n2 nodes. */
+        bool fits (const size_t & n1, const size_t & n2) const
+        {
+            return n1 == mN1 && n2 == mN2;
+        }
+
+        const double * h    (const size_t & i1, const size_t & i2) const
+        {
+            return &mTerms[12 * (i1 + mN1 * i2)];
+        }
+        const double * invH (const size_t & i1, const size_t & i2) const
+        {
+            return h(i1, i2) + 3;
+        }
+        const double * lap1 (const size_t & i1, const size_t & i2) const
+        {
+            return h(i1, i2) + 6;
+        }
+        const double * lap2 (const size_t & i1, const size_t & i2) const
+        {
+            return h(i1, i2) + 9;
+        }
+
+}; /* class MetricTable */
+
+
+/*
+ * CurvilinearGradientFieldOp class
+ *
+ * Gradient in a given orthogonal coordinate system:
+ *     (grad f)_i = 1/hi * df/dqi
+ * Three components. Has to be evaluated with the engine it was built for
+ * (grids of other sizes are rejected by engines, see fits()).
+ */
+template <class Metric>
+class CurvilinearGradientFieldOp : public FieldOperator
+{
+    protected:
+        MetricTable<Metric> mTable;
+
+    public:
+        CurvilinearGradientFieldOp (const FieldEngine & engine,
+                                    const Metric      & metric = Metric())
+            : mTable(engine, metric) { }
+
+        unsigned maxOrder   () const { return 1; }
+        unsigned components () const { return 3; }
+
+        bool uses (const unsigned & /* axis */,
+                   const unsigned &       order) const
+        {
+            return order == 1;
+        }
+
+        bool fits (const size_t &     n1,
+                   const size_t &     n2,
+                   const size_t & /* n3 */) const
+        {
+            return mTable.fits(n1, n2);
+        }
+
+        void combineRow (const RowContext     &    row,
+                         const double * const *      d,
+                         double       * const *    out,
+                         const ptrdiff_t      & stride) const
+        {
+            const double * d1 = d[1];
+            const double * d2 = d[3];
+            const double * d3 = d[5];
+
+            for (size_t j = 0; j < row.length; ++j){
+                const double * g = mTable.invH(row.i1 + j, row.i2);
+
+                out[0][j*stride] = g[0] * d1[j];
+                out[1][j*stride] = g[1] * d2[j];
+                out[2][j*stride] = g[2] * d3[j];
+            }
+        }
+
+}; /* class CurvilinearGradientFieldOp */
+
+
+/*
+ * CurvilinearLaplacianFieldOp class
+ *
+ * Laplace operator in a given orthogonal coordinate system (see
+ * MetricTable class). Has to be evaluated with the engine it was built
+ * for (grids of other sizes are rejected by engines, see fits()).
+ */
+template <class Metric>
+class CurvilinearLaplacianFieldOp : public FieldOperator
+{
+    protected:
+        MetricTable<Metric> mTable;
+
+    public:
+        CurvilinearLaplacianFieldOp (const FieldEngine & engine,
+                                     const Metric      & metric = Metric())
+            : mTable(engine, metric) { }
+
+        unsigned maxOrder   () const { return 2; }
+        unsigned components () const { return 1; }
+
+        bool uses (const unsigned &  axis,
+                   const unsigned & order) const
+        {
+            return order == 2 || (axis != AXIS_Q3 && order == 1);
+        }
+
+        bool fits (const size_t &     n1,
+                   const size_t &     n2,
+                   const size_t & /* n3 */) const
+        {
+            return mTable.fits(n1, n2);
+        }
+
+        void combineRow (const RowContext     &    row,
+                         const double * const *      d,
+                         double       * const *    out,
+                         const ptrdiff_t      & stride) const
+        {
+            const double * d1  = d[1];
+            const double * d11 = d[2];
+            const double * d2  = d[4];
+            const double * d22 = d[5];
+            const double * d33 = d[8];
+
+            for (size_t j = 0; j < row.length; ++j){
+                const double * a = mTable.lap1(row.i1 + j, row.i2);
+                const double * b = mTable.lap2(row.i1 + j, row.i2);
+
+                out[0][j*stride] = b[0] * d11[j] + a[0] * d1[j]
+                                 + b[1] * d22[j] + a[1] * d2[j]
+                                 + b[2] * d33[j];
+            }
+        }
+
+}; /* class CurvilinearLaplacianFieldOp */
+
+
+/*
+ * CurvilinearDivergence()
+ *
+ * Evaluates divergence of a vector field in a given orthogonal coordinate
+ * system at every grid node:
+ *     div A = 1/J * sum over i of d/dqi ( J/hi * Ai )
+ * Products J/hi * Ai are differentiated with FieldEngine::derivative().
+ *
+ * -----------
+ *  Arguments
+ * -----------
+ * const FieldEngine & engine
+ *     Engine of the grid.
+ *
+ * const double * A
+ *     Vector field components (3*engine.size() values; all components of
+ *     a node stored consecutively).
+ *
+ * double * out
+ *     Array receiving engine.size() values.
+ *
+ * const Metric & metric
+ *     Coordinate system.
+ *
+ * ------------
+ *  Exceptions
+ * ------------
+ * std::bad_alloc if temporary fields cannot be allocated.
+ */
+template <class Metric>
+void CurvilinearDivergence (const FieldEngine &    engine,
+                            const double      *         A,
+                            double            *       out,
+                            const Metric      &    metric = Metric())
+{
+    const MetricTable<Metric> table(engine, metric);
+
+    const size_t N1 = engine.n1(),
+                 N2 = engine.n2(),
+                 N  = engine.size();
+    const long   n  = (long) N;
+
+    std::vector<double> g(N), dg(N);
+
+    for (long p = 0; p < n; ++p){
+        out[p] = 0.0;
+    }
+
+    for (unsigned i = 0; i < 3; ++i){
+        const unsigned orders[3] = { i == 0, i == 1, i == 2 };
+
+        #pragma omp parallel for schedule(static) num_threads(engine.threadCount())
+        for (long p = 0; p < n; ++p){
+            const double * h = table.h(p % N1, (p / N1) % N2);
+
+            g[p] = h[(i+1) % 3] * h[(i+2) % 3] * A[3*p + i];
+        }
+
+        engine.derivative(orders, &g[0], &dg[0]);
+
+        #pragma omp parallel for schedule(static) num_threads(engine.threadCount())
+        for (long p = 0; p < n; ++p){
+            out[p] += dg[p];
+        }
+    }
+
+    #pragma omp parallel for schedule(static) num_threads(engine.threadCount())
+    for (long p = 0; p < n; ++p){
+        const double * h = table.h(p % N1, (p / N1) % N2);
+
+        out[p] /= h[0] * h[1] * h[2];
+    }
+}
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_CURVILINEAROPERATORS_H */
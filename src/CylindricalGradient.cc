@@ -1,7 +1,7 @@
 /*
  * File: CylindricalGradient.cc
  * Author(s): P Kuszaj
- * Last changed: 29.01.2015
+ * Last changed: 18.10.2026
  *
  * A source file providing CylindricalGradient class methods implementation
  * (declared in CylindricalGradient.h header file).
@@ -12,9 +12,9 @@
 namespace GridDiff
 {
 
-double CylindricalGradient::eval(const QGrid & rhoVals,
+QPoint CylindricalGradient::eval(const QGrid & rhoVals,
                                  const QGrid & phiVals,
-                                 const QGrid &   zVals)
+                                 const QGrid &   zVals) const
 {
     /*                 [ df/d(rho)       ]
        Lf(rho,phi,z) = [ df/d(phi) / rho ]
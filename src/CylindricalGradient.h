@@ -1,7 +1,7 @@
 /*
  * File: CylindricalGradient.h
  * Author(s): P Kuszaj
- * Last changed: 29.01.2015
+ * Last changed: 18.10.2026
  *
  * A header file providing CylindricalGradient class used for evaluating
  * gradient at a given point in cylindrical coordinate system using given
@@ -93,7 +93,7 @@ class CylindricalGradient : public Basic_3D_DiffOp
          */
         QPoint eval(const QGrid & rhoVals,
                     const QGrid & phiVals,
-                    const QGrid &   zVals);
+                    const QGrid &   zVals) const;
 
 }; /* class CylindricalGradient */
 
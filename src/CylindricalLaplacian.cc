@@ -1,7 +1,7 @@
 /*
  * File: CylindricalLaplacian.cc
  * Author(s): P Kuszaj
- * Last changed: 28.01.2015
+ * Last changed: 18.10.2026
  *
  * A source file providing CylindricalLaplacian class methods implementation
  * (declared in CylindricalLaplacian.h header file).
@@ -9,20 +9,33 @@
 
 #include "CylindricalLaplacian.h"
 
+#include <stdexcept> /* std::invalid_argument */
+
 namespace GridDiff
 {
 
 double CylindricalLaplacian::eval(const QGrid & rhoVals,
                                   const QGrid & phiVals,
-                                  const QGrid &   zVals)
+                                  const QGrid &   zVals) const
 {
     /* Lf(rho,phi,z) =   (1/rho) * df/d(rho)
                      + (1/rho^2) * d^2f/d(phi)^2
                      +             d^2f/d(rho)^2
                      +             d^2f/dz^2 */
-    return ( fEvalQ1Diff(1, rhoVals)
+
+    /* If max order too low, throw exception. */
+    if (mMaxOrder < 2){
+        throw std::invalid_argument("max order lower than 2");
+    }
+
+    /* Derivatives of orders 0,1,2 along rho. */
+    double drho[3];
+
+    fEvalQ1Diffs(rhoVals, drho, 2);
+
+    return ( drho[1]
            + fEvalQ2Diff(2, phiVals) / mQ0Point.q1 ) / mQ0Point.q1
-           + fEvalQ1Diff(2, rhoVals)
+           + drho[2]
            + fEvalQ3Diff(2, zVals);
 }
 
@@ -0,0 +1,188 @@
+/*
+ * File: FieldOperators.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing field-level operator classes methods
+ * implementation (declared in FieldOperators.h header file).
+ */
+
+#include "FieldOperators.h"
+
+#include <algorithm>  /* std::copy */
+#include <cmath>      /* sin, cos */
+
+namespace GridDiff
+{
+
+void CartesianGradientFieldOp::combineRow (const RowContext     &    row,
+                                           const double * const *      d,
+                                           double       * const *    out,
+                                           const ptrdiff_t      & stride) const
+{
+    /*             [ df/dx ]
+       Lf(x,y,z) = [ df/dy ]
+                   [ df/dz ] */
+    const double * dx = d[1];
+    const double * dy = d[3];
+    const double * dz = d[5];
+
+    /* Separate component arrays: one contiguous loop per component. */
+    if (stride == 1){
+        std::copy(dx, dx + row.length, out[0]);
+        std::copy(dy, dy + row.length, out[1]);
+        std::copy(dz, dz + row.length, out[2]);
+        return;
+    }
+
+    for (size_t j = 0; j < row.length; ++j){
+        out[0][j*stride] = dx[j];
+        out[1][j*stride] = dy[j];
+        out[2][j*stride] = dz[j];
+    }
+}
+
+
+void CartesianLaplacianFieldOp::combineRow (const RowContext     &    row,
+                                            const double * const *      d,
+                                            double       * const *    out,
+                                            const ptrdiff_t      & stride) const
+{
+    /* Lf(x,y,z) = d^2f/dx^2 + d^2f/dy^2 +  d^2f/dz^2 */
+    const double * dxx = d[2];
+    const double * dyy = d[5];
+    const double * dzz = d[8];
+
+    for (size_t j = 0; j < row.length; ++j){
+        out[0][j*stride] = dxx[j] + dyy[j] + dzz[j];
+    }
+}
+
+
+void CylindricalGradientFieldOp::combineRow (const RowContext     &    row,
+                                             const double * const *      d,
+                                             double       * const *    out,
+                                             const ptrdiff_t      & stride) const
+{
+    /*                 [ df/d(rho)       ]
+       Lf(rho,phi,z) = [ df/d(phi) / rho ]
+                       [     df/dz       ] */
+    const double * drho = d[1];
+    const double * dphi = d[3];
+    const double * dz   = d[5];
+
+    /* Separate component arrays: one contiguous loop per component. */
+    if (stride == 1){
+        double * g = out[1];
+
+        std::copy(drho, drho + row.length, out[0]);
+        for (size_t j = 0; j < row.length; ++j){
+            g[j] = dphi[j] / row.q1[j];
+        }
+        std::copy(dz, dz + row.length, out[2]);
+        return;
+    }
+
+    for (size_t j = 0; j < row.length; ++j){
+        out[0][j*stride] = drho[j];
+        out[1][j*stride] = dphi[j] / row.q1[j];
+        out[2][j*stride] = dz[j];
+    }
+}
+
+
+void CylindricalLaplacianFieldOp::combineRow (const RowContext     &    row,
+                                              const double * const *      d,
+                                              double       * const *    out,
+                                              const ptrdiff_t      & stride) const
+{
+    /* Lf(rho,phi,z) =   (1/rho) * df/d(rho)
+                     + (1/rho^2) * d^2f/d(phi)^2
+                     +             d^2f/d(rho)^2
+                     +             d^2f/dz^2 */
+    const double * drho   = d[1];
+    const double * drho2  = d[2];
+    const double * dphi2  = d[5];
+    const double * dz2    = d[8];
+
+    for (size_t j = 0; j < row.length; ++j){
+        const double rho = row.q1[j];
+
+        out[0][j*stride] = ( drho[j] + dphi2[j] / rho ) / rho
+                         + drho2[j]
+                         + dz2[j];
+    }
+}
+
+
+void SphericalGradientFieldOp::combineRow (const RowContext     &    row,
+                                           const double * const *      d,
+                                           double       * const *    out,
+                                           const ptrdiff_t      & stride) const
+{
+    /*                   [       df/dr                 ]
+       Lf(r,theta,phi) = [ df/d(theta) / r             ]
+                         [   df/d(phi) / (r*sin(theta))] */
+    const double * dr     = d[1];
+    const double * dtheta = d[3];
+    const double * dphi   = d[5];
+
+    /* theta is constant along the row. */
+    const double   s      = sin(row.q2);
+
+    /* Separate component arrays: one contiguous loop per component. */
+    if (stride == 1){
+        double * g2 = out[1];
+        double * g3 = out[2];
+
+        std::copy(dr, dr + row.length, out[0]);
+        for (size_t j = 0; j < row.length; ++j){
+            g2[j] = dtheta[j] / row.q1[j];
+        }
+        for (size_t j = 0; j < row.length; ++j){
+            g3[j] = dphi[j] / (row.q1[j] * s);
+        }
+        return;
+    }
+
+    for (size_t j = 0; j < row.length; ++j){
+        const double r = row.q1[j];
+
+        out[0][j*stride] = dr[j];
+        out[1][j*stride] = dtheta[j] / r;
+        out[2][j*stride] = dphi[j] / (r * s);
+    }
+}
+
+
+void SphericalLaplacianFieldOp::combineRow (const RowContext     &    row,
+                                            const double * const *      d,
+                                            double       * const *    out,
+                                            const ptrdiff_t      & stride) const
+{
+    /* Lf(r,theta,phi) = (1/r^2*sin(theta)^2) * d^2f/d(phi)^2
+                       +   (1/r^2*tan(theta)) * df/d(theta)
+                       +              (1/r^2) * d^2f/d(theta)^2
+                       +                (2/r) * df/dr
+                       +                        d^2f/dr^2 */
+    const double * dr      = d[1];
+    const double * dr2     = d[2];
+    const double * dtheta  = d[4];
+    const double * dtheta2 = d[5];
+    const double * dphi2   = d[8];
+
+    /* theta is constant along the row. */
+    const double   s       = sin(row.q2);
+    const double   c       = cos(row.q2);
+
+    for (size_t j = 0; j < row.length; ++j){
+        const double r   = row.q1[j];
+        const double ang = ( dphi2[j] / s + dtheta[j] * c ) / s
+                         + dtheta2[j];
+
+        out[0][j*stride] = ( ang / r + 2.0 * dr[j] ) / r
+                         + dr2[j];
+    }
+}
+
+} /* namespace GridDiff */
@@ -0,0 +1,175 @@
+/*
+ * File: FieldOperators.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing field-level counterparts of gradient and Laplace
+ * operator classes (see Gradients.h and Laplacians.h header files). They
+ * are evaluated at all nodes of a tensor grid by FieldEngine class. For
+ * further information please see field_operator.h header file.
+ */
+
+#ifndef GRIDDIFF_FIELDOPERATORS_H
+#define GRIDDIFF_FIELDOPERATORS_H
+
+#include "field_operator.h"  /* FieldOperator */
+
+namespace GridDiff
+{
+
+/*
+ * CartesianGradientFieldOp class
+ *
+ * Gradient in cartesian coordinate system (x, y, z). Three components.
+ */
+class CartesianGradientFieldOp : public FieldOperator
+{
+    public:
+        unsigned maxOrder   () const { return 1; }
+        unsigned components () const { return 3; }
+
+        bool uses (const unsigned & /* axis */,
+                   const unsigned &       order) const
+        {
+            return order == 1;
+        }
+
+        void combineRow (const RowContext     &    row,
+                         const double * const *      d,
+                         double       * const *    out,
+                         const ptrdiff_t      & stride) const;
+
+}; /* class CartesianGradientFieldOp */
+
+
+/*
+ * CartesianLaplacianFieldOp class
+ *
+ * Laplace operator in cartesian coordinate system (x, y, z).
+ */
+class CartesianLaplacianFieldOp : public FieldOperator
+{
+    public:
+        unsigned maxOrder   () const { return 2; }
+        unsigned components () const { return 1; }
+
+        bool uses (const unsigned & /* axis */,
+                   const unsigned &       order) const
+        {
+            return order == 2;
+        }
+
+        void combineRow (const RowContext     &    row,
+                         const double * const *      d,
+                         double       * const *    out,
+                         const ptrdiff_t      & stride) const;
+
+}; /* class CartesianLaplacianFieldOp */
+
+
+/*
+ * CylindricalGradientFieldOp class
+ *
+ * Gradient in cylindrical coordinate system (rho, phi, z). Three
+ * components. Diverges for rho == 0.
+ */
+class CylindricalGradientFieldOp : public FieldOperator
+{
+    public:
+        unsigned maxOrder   () const { return 1; }
+        unsigned components () const { return 3; }
+
+        bool uses (const unsigned & /* axis */,
+                   const unsigned &       order) const
+        {
+            return order == 1;
+        }
+
+        void combineRow (const RowContext     &    row,
+                         const double * const *      d,
+                         double       * const *    out,
+                         const ptrdiff_t      & stride) const;
+
+}; /* class CylindricalGradientFieldOp */
+
+
+/*
+ * CylindricalLaplacianFieldOp class
+ *
+ * Laplace operator in cylindrical coordinate system (rho, phi, z).
+ * Diverges for rho == 0.
+ */
+class CylindricalLaplacianFieldOp : public FieldOperator
+{
+    public:
+        unsigned maxOrder   () const { return 2; }
+        unsigned components () const { return 1; }
+
+        bool uses (const unsigned &  axis,
+                   const unsigned & order) const
+        {
+            return order == 2 || (axis == AXIS_Q1 && order == 1);
+        }
+
+        void combineRow (const RowContext     &    row,
+                         const double * const *      d,
+                         double       * const *    out,
+                         const ptrdiff_t      & stride) const;
+
+}; /* class CylindricalLaplacianFieldOp */
+
+
+/*
+ * SphericalGradientFieldOp class
+ *
+ * Gradient in spherical coordinate system (r, theta, phi). Three
+ * components. Diverges for r == 0 and theta == 0 or pi.
+ */
+class SphericalGradientFieldOp : public FieldOperator
+{
+    public:
+        unsigned maxOrder   () const { return 1; }
+        unsigned components () const { return 3; }
+
+        bool uses (const unsigned & /* axis */,
+                   const unsigned &       order) const
+        {
+            return order == 1;
+        }
+
+        void combineRow (const RowContext     &    row,
+                         const double * const *      d,
+                         double       * const *    out,
+                         const ptrdiff_t      & stride) const;
+
+}; /* class SphericalGradientFieldOp */
+
+
+/*
+ * SphericalLaplacianFieldOp class
+ *
+ * Laplace operator in spherical coordinate system (r, theta, phi).
+ * Diverges for r == 0 and theta == 0 or pi.
+ */
+class SphericalLaplacianFieldOp : public FieldOperator
+{
+    public:
+        unsigned maxOrder   () const { return 2; }
+        unsigned components () const { return 1; }
+
+        bool uses (const unsigned &  axis,
+                   const unsigned & order) const
+        {
+            return order == 2 || (axis != AXIS_Q3 && order == 1);
+        }
+
+        void combineRow (const RowContext     &    row,
+                         const double * const *      d,
+                         double       * const *    out,
+                         const ptrdiff_t      & stride) const;
+
+}; /* class SphericalLaplacianFieldOp */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_FIELDOPERATORS_H */
@@ -1,21 +1,21 @@
 /*
  * File: SphericalGradient.cc
  * Author(s): P Kuszaj
- * Last changed: 29.01.2015
+ * Last changed: 18.10.2026
  *
  * A source file providing SphericalGradient class methods implementation
  * (declared in SphericalGradient.h header file).
  */
 
 #include "SphericalGradient.h"
-#include <cmath > /* sin */
+#include <cmath> /* sin */
 
 namespace GridDiff
 {
 
-double SphericalGradient::eval(const QGrid &     rVals,
+QPoint SphericalGradient::eval(const QGrid &     rVals,
                                const QGrid & thetaVals,
-                               const QGrid &   phiVals)
+                               const QGrid &   phiVals) const
 {
     /*                 [       df/dr                 ]
        Lf(rho,phi,z) = [ df/d(theta) / r             ]
@@ -1,7 +1,7 @@
 /*
  * File: SphericalGradient.h
  * Author(s): P Kuszaj
- * Last changed: 29.01.2015
+ * Last changed: 18.10.2026
  *
  * A header file providing SphericalGradient class used for evaluating
  * gradient at a given point in spherical coordinate system using
@@ -92,9 +92,9 @@ class SphericalGradient : public Basic_3D_DiffOp
          * ------------
          * None.
          */
-        double eval(const QGrid &     rVals,
+        QPoint eval(const QGrid &     rVals,
                     const QGrid & thetaVals,
-                    const QGrid &   phiVals);
+                    const QGrid &   phiVals) const;
 
 }; /* class SphericalGradient */
 
@@ -1,21 +1,22 @@
 /*
  * File: SphericalLaplacian.cc
  * Author(s): P Kuszaj
- * Last changed: 28.01.2015
+ * Last changed: 18.10.2026
  *
  * A source file providing SphericalLaplacian class methods implementation
  * (declared in SphericalLaplacian.h header file).
  */
 
 #include "SphericalLaplacian.h"
-#include <cmath> /* sin, cos */
+#include <cmath>     /* sin, cos */
+#include <stdexcept> /* std::invalid_argument */
 
 namespace GridDiff
 {
 
 double SphericalLaplacian::eval(const QGrid &     rVals,
                                 const QGrid & thetaVals,
-                                const QGrid &   phiVals)
+                                const QGrid &   phiVals) const
 {
     /* Lf(r,theta,phi) = (1/r^2*sin(theta)^2) * d^2f/d(phi)^2
                        +   (1/r^2*tan(theta)) * df/d(theta)
@@ -24,22 +25,33 @@ double SphericalLaplacian::eval(const QGrid &     rVals,
                        +                        d^2f/dr^2 */
     double s,c,lap;
 
+    /* If max order too low, throw exception. */
+    if (mMaxOrder < 2){
+        throw std::invalid_argument("max order lower than 2");
+    }
+
+    /* Derivatives of orders 0,1,2 along r and theta. */
+    double dr[3], dtheta[3];
+
+    fEvalQ1Diffs(    rVals,     dr, 2);
+    fEvalQ2Diffs(thetaVals, dtheta, 2);
+
     s = sin(mQ0Point.q2); /* sin(theta) */
     c = cos(mQ0Point.q2); /* cos(theta) */
 
     lap = fEvalQ3Diff(2,   phiVals) / s
-        + fEvalQ2Diff(1, thetaVals) * c;
+        + dtheta[1]                 * c;
 
-    lap =                       lap / s;
-        + fEvalQ2Diff(2, thetaVals);
+    lap =                       lap / s
+        + dtheta[2];
 
-    lap =                       lap / mQ0Point.q1;
-        + fEvalQ1Diff(1,     rVals) * 2.0;
+    lap =                       lap / mQ0Point.q1
+        + dr[1]                     * 2.0;
 
-    lap =                       lap / mQ0Point.q1;
-        + fEvalQ1Diff(2,     rVals);
+    lap =                       lap / mQ0Point.q1
+        + dr[2];
 
-    return lap
+    return lap;
 }
 
 } /* namespace GridDiff */
@@ -1,7 +1,7 @@
 /*
  * File: SphericalLaplacian.h
  * Author(s): P Kuszaj
- * Last changed: 28.01.2015
+ * Last changed: 18.10.2026
  *
  * A header file providing SphericalLaplacian class used for evaluating
  * Laplace operator at a given point in spherical coordinate system using
@@ -90,11 +90,14 @@ class SphericalLaplacian : public Basic_3D_DiffOp
          * ------------
          *  Exceptions
          * ------------
-         * None.
+         * std::invalid_argument if max order of the operator (e.g. of
+         * another operator it was converted from) is lower than 2, or
+         * number of function values along any axis is not equal to number
+         * of its grid points.
          */
         double eval(const QGrid &     rVals,
                     const QGrid & thetaVals,
-                    const QGrid &   phiVals);
+                    const QGrid &   phiVals) const;
 
 }; /* class SphericalLaplacian */
 
@@ -0,0 +1,369 @@
+/*
+ * File: amr_hierarchy.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing AmrHierarchy class methods implementation
+ * (declared in amr_hierarchy.h header file).
+ */
+
+#include "amr_hierarchy.h"
+
+#include <algorithm>  /* std::min */
+#include <stdexcept>  /* std::invalid_argument */
+
+namespace GridDiff
+{
+
+namespace
+{
+
+/*
+ * Returns axis refined by inserting a node halfway between every two
+ * consecutive nodes.
+ */
+QGrid Refine (const QGrid & q)
+{
+    QGrid r(2 * q.size() - 1);
+
+    for (size_t i = 0; i < q.size(); ++i){
+        r[2*i] = q[i];
+        if (i + 1 < q.size()){
+            r[2*i + 1] = 0.5 * (q[i] + q[i+1]);
+        }
+    }
+    return r;
+}
+
+/*
+ * Checks whether node (g1,g2,g3) lies within box [lo, hi).
+ */
+bool InBox (const size_t * g, const size_t * lo, const size_t * hi)
+{
+    return lo[0] <= g[0] && g[0] < hi[0] &&
+           lo[1] <= g[1] && g[1] < hi[1] &&
+           lo[2] <= g[2] && g[2] < hi[2];
+}
+
+/*
+ * Returns position of node (g1,g2,g3) in a field of a patch.
+ */
+size_t PatchIndex (const AmrPatch & p, const size_t * g)
+{
+    return QFieldIndex(g[0] - p.elo[0], g[1] - p.elo[1], g[2] - p.elo[2],
+                       p.ehi[0] - p.elo[0], p.ehi[1] - p.elo[1]);
+}
+
+} /* anonymous namespace */
+
+
+const size_t AmrHierarchy::NO_INTERP;
+
+
+AmrHierarchy::AmrHierarchy (const QGrid    &    q1Coords,
+                            const QGrid    &    q2Coords,
+                            const QGrid    &    q3Coords,
+                            const unsigned &       width,
+                            const unsigned &    maxOrder,
+                            const unsigned & interpWidth)
+
+                          : mWidth       (width),
+                            mMaxOrder    (maxOrder),
+                            mInterpWidth (interpWidth ? interpWidth
+                                                      : width + maxOrder)
+{
+    /* Base grid (validates arguments). */
+    AmrPatch base(FieldEngine(q1Coords, q2Coords, q3Coords, width, maxOrder));
+
+    if (q1Coords.size() < mInterpWidth || q2Coords.size() < mInterpWidth ||
+        q3Coords.size() < mInterpWidth){
+        throw std::invalid_argument("base grid size < interpolation width");
+    }
+
+    base.level  = 0;
+    base.parent = 0;
+
+    for (unsigned a = 0; a < 3; ++a){
+        base.lo[a] = base.elo[a] = 0;
+        base.hi[a] = base.ehi[a] = base.engine.coords(a).size();
+    }
+
+    mLevelCoords.push_back(q1Coords);
+    mLevelCoords.push_back(q2Coords);
+    mLevelCoords.push_back(q3Coords);
+
+    mPatches    .push_back(base);
+    mCopies     .push_back(std::vector<size_t>());
+    mInterpNodes.push_back(std::vector<size_t>());
+    mInterpOf   .push_back(NO_INTERP);
+}
+
+
+size_t AmrHierarchy::addPatch (const size_t &  parent,
+                               const size_t *      lo,
+                               const size_t *      hi)
+{
+    /* If arguments invalid, throw exception. */
+    if (parent >= mPatches.size()){
+        throw std::invalid_argument("parent patch does not exist");
+    }
+
+    const AmrPatch & P     = mPatches[parent];
+    const unsigned   level = P.level + 1;
+    const size_t     G     = mWidth / 2;
+
+    /* Coordinates of a new level. */
+    if (mLevelCoords.size() < 3 * (level + 1)){
+        for (unsigned a = 0; a < 3; ++a){
+            mLevelCoords.push_back(Refine(mLevelCoords[3*(level-1) + a]));
+        }
+    }
+
+    size_t elo[3], ehi[3];
+
+    for (unsigned a = 0; a < 3; ++a){
+        const size_t n = mLevelCoords[3*level + a].size();
+
+        if (!(lo[a] < hi[a] && hi[a] <= n)){
+            throw std::invalid_argument("patch empty or outside domain");
+        }
+
+        elo[a] = (lo[a] > G) ? lo[a] - G : 0;
+        ehi[a] = std::min(hi[a] + G, n);
+
+        if (elo[a] < 2 * P.lo[a] || ehi[a] - 1 > 2 * (P.hi[a] - 1)){
+            throw std::invalid_argument("patch not nested in parent");
+        }
+        if (ehi[a] - elo[a] < mWidth){
+            throw std::invalid_argument("patch grid size < stencil width");
+        }
+        if (P.ehi[a] - P.elo[a] < mInterpWidth){
+            throw std::invalid_argument("parent size < interpolation width");
+        }
+    }
+
+    /* Patch grid. */
+    QGrid q[3];
+
+    for (unsigned a = 0; a < 3; ++a){
+        const QGrid & c = mLevelCoords[3*level + a];
+        q[a].assign(c.begin() + elo[a], c.begin() + ehi[a]);
+    }
+
+    AmrPatch patch(FieldEngine(q[0], q[1], q[2], mWidth, mMaxOrder));
+
+    patch.level  = level;
+    patch.parent = parent;
+
+    for (unsigned a = 0; a < 3; ++a){
+        patch.lo [a] = lo [a];
+        patch.hi [a] = hi [a];
+        patch.elo[a] = elo[a];
+        patch.ehi[a] = ehi[a];
+    }
+
+    mPatches    .push_back(patch);
+    mCopies     .push_back(std::vector<size_t>());
+    mInterpNodes.push_back(std::vector<size_t>());
+    mInterpOf   .push_back(NO_INTERP);
+
+    /* Ghost nodes of other patches of the level may now be covered by
+     * the new one. */
+    updateGhosts(level);
+
+    return mPatches.size() - 1;
+}
+
+
+void AmrHierarchy::updateGhosts (const unsigned & level)
+{
+    std::vector<size_t> same;
+
+    for (size_t p = 0; p < mPatches.size(); ++p){
+        if (mPatches[p].level == level){
+            same.push_back(p);
+        }
+    }
+
+    for (size_t s = 0; s < same.size(); ++s){
+        const size_t         p = same[s];
+        const AmrPatch     & A = mPatches[p];
+        std::vector<QPoint>  targets;
+        size_t               g[3];
+
+        mCopies[p]     .clear();
+        mInterpNodes[p].clear();
+
+        for (g[2] = A.elo[2]; g[2] < A.ehi[2]; ++g[2]){
+            for (g[1] = A.elo[1]; g[1] < A.ehi[1]; ++g[1]){
+                for (g[0] = A.elo[0]; g[0] < A.ehi[0]; ++g[0]){
+                    if (InBox(g, A.lo, A.hi)){
+                        continue;
+                    }
+
+                    /* Owned node of another patch of the level. */
+                    size_t src = p;
+
+                    for (size_t t = 0; t < same.size() && src == p; ++t){
+                        const AmrPatch & B = mPatches[same[t]];
+
+                        if (same[t] != p && InBox(g, B.lo, B.hi)){
+                            src = same[t];
+                        }
+                    }
+
+                    if (src != p){
+                        mCopies[p].push_back(src);
+                        mCopies[p].push_back(PatchIndex(mPatches[src], g));
+                        mCopies[p].push_back(PatchIndex(A, g));
+                        continue;
+                    }
+
+                    targets.push_back(QPoint(levelCoords(level, 0)[g[0]],
+                                             levelCoords(level, 1)[g[1]],
+                                             levelCoords(level, 2)[g[2]]));
+                    mInterpNodes[p].push_back(PatchIndex(A, g));
+                }
+            }
+        }
+
+        if (targets.empty()){
+            continue;
+        }
+
+        /* Interpolation from parent grid. */
+        const FieldEngine & e = mPatches[A.parent].engine;
+        const Regridder     r(e.coords(AXIS_Q1), e.coords(AXIS_Q2),
+                              e.coords(AXIS_Q3), targets, mInterpWidth);
+
+        if (mInterpOf[p] == NO_INTERP){
+            mInterpOf[p] = mInterp.size();
+            mInterp.push_back(r);
+        }
+        else {
+            mInterp[mInterpOf[p]] = r;
+        }
+    }
+}
+
+
+void AmrHierarchy::checkField (const AmrField & f) const
+{
+    if (f.size() != mPatches.size()){
+        throw std::invalid_argument("field does not match hierarchy");
+    }
+    for (size_t p = 0; p < mPatches.size(); ++p){
+        if (f[p].size() != mPatches[p].engine.size()){
+            throw std::invalid_argument("field does not match hierarchy");
+        }
+    }
+}
+
+
+size_t AmrHierarchy::points () const
+{
+    size_t n = 0;
+
+    for (size_t p = 0; p < mPatches.size(); ++p){
+        n += mPatches[p].engine.size();
+    }
+    return n;
+}
+
+
+AmrField AmrHierarchy::allocate () const
+{
+    AmrField f(mPatches.size());
+
+    for (size_t p = 0; p < mPatches.size(); ++p){
+        f[p].assign(mPatches[p].engine.size(), 0.0);
+    }
+    return f;
+}
+
+
+void AmrHierarchy::fillGhosts (AmrField & f) const
+{
+    /* If arguments invalid, throw exception. */
+    checkField(f);
+
+    std::vector<double> values;
+
+    /* Parents precede children, so they are complete when reached. */
+    for (size_t p = 1; p < mPatches.size(); ++p){
+        const std::vector<size_t> & c = mCopies[p];
+
+        for (size_t i = 0; i < c.size(); i += 3){
+            f[p][c[i+2]] = f[c[i]][c[i+1]];
+        }
+
+        const std::vector<size_t> & nodes = mInterpNodes[p];
+
+        if (nodes.empty()){
+            continue;
+        }
+
+        values.resize(nodes.size());
+        mInterp[mInterpOf[p]].apply(&f[mPatches[p].parent][0], &values[0]);
+
+        for (size_t i = 0; i < nodes.size(); ++i){
+            f[p][nodes[i]] = values[i];
+        }
+    }
+}
+
+
+void AmrHierarchy::restrictToParents (AmrField & f) const
+{
+    /* If arguments invalid, throw exception. */
+    checkField(f);
+
+    /* Children follow parents, so the finest patches come first. */
+    for (size_t p = mPatches.size() - 1; p > 0; --p){
+        const AmrPatch & A = mPatches[p];
+        const AmrPatch & P = mPatches[A.parent];
+        size_t           g[3], c[3];
+
+        for (g[2] = A.lo[2] + A.lo[2] % 2; g[2] < A.hi[2]; g[2] += 2){
+            for (g[1] = A.lo[1] + A.lo[1] % 2; g[1] < A.hi[1]; g[1] += 2){
+                for (g[0] = A.lo[0] + A.lo[0] % 2; g[0] < A.hi[0]; g[0] += 2){
+                    c[0] = g[0] / 2;
+                    c[1] = g[1] / 2;
+                    c[2] = g[2] / 2;
+
+                    f[A.parent][PatchIndex(P, c)] = f[p][PatchIndex(A, g)];
+                }
+            }
+        }
+    }
+}
+
+
+void AmrHierarchy::apply (const FieldOperator &   op,
+                          const AmrField      &    f,
+                          AmrField            &  out) const
+{
+    /* If arguments invalid, throw exception (before any patch is
+     * evaluated). */
+    checkField(f);
+
+    for (size_t p = 0; p < mPatches.size(); ++p){
+        const FieldEngine & e = mPatches[p].engine;
+
+        if (op.maxOrder() > e.plan(AXIS_Q1).maxOrder()){
+            throw std::invalid_argument("operator order higher than max");
+        }
+        if (!op.fits(e.n1(), e.n2(), e.n3())){
+            throw std::invalid_argument("operator does not fit grid");
+        }
+    }
+
+    out.resize(mPatches.size());
+
+    for (size_t p = 0; p < mPatches.size(); ++p){
+        out[p].resize(op.components() * mPatches[p].engine.size());
+        mPatches[p].engine.apply(op, &f[p][0], &out[p][0]);
+    }
+}
+
+} /* namespace GridDiff */
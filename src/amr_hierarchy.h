@@ -0,0 +1,307 @@
+/*
+ * File: amr_hierarchy.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing AmrHierarchy class used for block-structured
+ * adaptive mesh refinement: a base tensor grid covered by patches (tensor
+ * grids themselves) at several refinement levels. Operators are evaluated
+ * on every patch with FieldEngine class; ghost nodes of refined patches
+ * are filled by polynomial interpolation from coarser ones (see
+ * regridder.h header file).
+ */
+
+#ifndef GRIDDIFF_AMR_HIERARCHY_H
+#define GRIDDIFF_AMR_HIERARCHY_H
+
+#include "qobj.h"            /* QGrid */
+#include "field_engine.h"    /* FieldEngine */
+#include "field_operator.h"  /* FieldOperator */
+#include "regridder.h"       /* Regridder */
+
+#include <vector>            /* std::vector */
+
+namespace GridDiff
+{
+
+/*
+ * Field defined on all patches of a hierarchy: values of pth patch (at
+ * all nodes of its grid, including ghost nodes) are stored in pth vector.
+ */
+typedef std::vector< std::vector<double> > AmrField;
+
+/*
+ * AmrPatch struct
+ *
+ * A box of nodes at given refinement level, extended with ghost nodes.
+ * Node indices are those of the whole domain refined to patch level.
+ */
+struct AmrPatch
+{
+    /* Refinement level (0 for the base grid). */
+    unsigned    level;
+    /* Index of the parent patch (the patch itself for base grid). */
+    size_t      parent;
+    /* Owned nodes: [lo, hi) along every axis. */
+    size_t      lo[3], hi[3];
+    /* Nodes of patch grid (owned and ghost nodes): [elo, ehi) along
+     * every axis (ghost nodes do not extend beyond the domain). */
+    size_t      elo[3], ehi[3];
+    /* Engine of patch grid. */
+    FieldEngine engine;
+
+    AmrPatch (const FieldEngine & e) : engine(e) { }
+};
+
+/*
+ * AmrHierarchy class
+ *
+ * Level 0 consists of a single patch covering the whole base grid. Grid of
+ * level L+1 is obtained by refining every interval of level L grid into
+ * two (node 2i of level L+1 is node i of level L, node 2i+1 lies halfway
+ * between nodes i and i+1), so every axis can be nonuniform (e.g. radial
+ * axis of a spherical grid).
+ *
+ * Every patch of level L+1 has a parent patch of level L, which has to
+ * contain it (with its ghost nodes) within its owned nodes. Ghost layers
+ * are width/2 nodes wide, so stencils of all owned nodes lie within patch
+ * grids. Ghost node values are
+ *     * copied from owned nodes of another patch of the same level, if
+ *       there is one containing them,
+ *     * interpolated from parent patch grid otherwise (Fornberg weights
+ *       of order 0).
+ *
+ * Values at owned nodes are independent between patches;
+ * restrictToParents() copies values of refined patches to nodes of their
+ * parents they cover.
+ *
+ * Patches are usually placed only where a field is not smooth, so the
+ * total number of nodes is much lower than that of the whole domain at
+ * the finest level (see points()).
+ */
+class AmrHierarchy
+{
+    public:
+        /* Marks patches without interpolated ghost nodes. */
+        static const size_t NO_INTERP = (size_t) -1;
+
+    protected:
+        /* Grid point positions along q1, q2 and q3 axes of every level
+         * (3*level + axis). */
+        std::vector<QGrid>                  mLevelCoords;
+        /* Number of grid points used for every stencil. */
+        unsigned                            mWidth;
+        /* Highest derivative order of evaluated operators. */
+        unsigned                            mMaxOrder;
+        /* Number of grid points used for interpolation of ghost nodes. */
+        unsigned                            mInterpWidth;
+        /* Patches (parents before children). */
+        std::vector<AmrPatch>               mPatches;
+        /* Ghost nodes of every patch copied from other patches: triples
+         * of source patch, source node and target node (positions in
+         * patch fields). */
+        std::vector< std::vector<size_t> >  mCopies;
+        /* Ghost nodes of every patch interpolated from its parent (in
+         * order of interpolation targets). */
+        std::vector< std::vector<size_t> >  mInterpNodes;
+        /* Interpolation of every patch (index into mInterp, or
+         * NO_INTERP). */
+        std::vector<size_t>                 mInterpOf;
+        std::vector<Regridder>              mInterp;
+
+        /*
+         * updateGhosts()
+         *
+         * Rebuilds ghost node sources of all patches of given level.
+         */
+        void updateGhosts (const unsigned & level);
+
+        /*
+         * checkField()
+         *
+         * Throws std::invalid_argument if f is not a scalar field of the
+         * hierarchy.
+         */
+        void checkField (const AmrField & f) const;
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Constructor
+         *
+         * Creates a hierarchy with base grid only.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const QGrid & q1Coords
+         * const QGrid & q2Coords
+         * const QGrid & q3Coords
+         *     Base grid point positions along axes q1, q2 and q3. For each
+         *     axis those positions have to be strictly increasing.
+         *
+         * const unsigned & width
+         *     Number of grid points used for every stencil.
+         *
+         * const unsigned & maxOrder
+         *     Highest derivative order of evaluated operators.
+         *
+         * const unsigned & interpWidth
+         *     Number of grid points used for interpolation of ghost nodes
+         *     (0 means width + maxOrder). Interpolation errors are amplified
+         *     by derivative stencils (by h^-k for kth derivative), so ghost
+         *     nodes have to be interpolated with higher order than that of
+         *     stencils to preserve their accuracy.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if base grid is invalid (see FieldEngine
+         * constructor) or has fewer than interpWidth nodes along any axis.
+         */
+        AmrHierarchy (const QGrid    &    q1Coords,
+                      const QGrid    &    q2Coords,
+                      const QGrid    &    q3Coords,
+                      const unsigned &       width,
+                      const unsigned &    maxOrder,
+                      const unsigned & interpWidth = 0);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /*
+         * addPatch()
+         *
+         * Adds a patch one level finer than its parent.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const size_t & parent
+         *     Index of parent patch.
+         *
+         * const size_t * lo
+         * const size_t * hi
+         *     Owned nodes [lo, hi) along every axis, given as node indices
+         *     of the whole domain refined to patch level.
+         *
+         * ---------
+         *  Returns
+         * ---------
+         * Index of the new patch.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * parent does not exist
+         *     * Box is empty or exceeds the domain
+         *     * Box (with ghost nodes) is not contained in parent owned
+         *       nodes
+         *     * Patch grid has fewer than width nodes along any axis
+         *     * Parent grid has fewer than interpWidth nodes along any
+         *       axis
+         */
+        size_t addPatch (const size_t &  parent,
+                         const size_t *      lo,
+                         const size_t *      hi);
+
+        /* Number of patches. */
+        size_t patches () const { return mPatches.size(); }
+
+        /* pth patch. */
+        const AmrPatch & patch (const size_t & p) const
+        {
+            return mPatches[p];
+        }
+
+        /* Grid point positions along given axis of the whole domain at
+         * given level (levels up to the finest existing one). */
+        const QGrid & levelCoords (const unsigned & level,
+                                   const unsigned &  axis) const
+        {
+            return mLevelCoords[3*level + axis];
+        }
+
+        /* Total number of nodes of all patch grids (including ghost
+         * nodes). */
+        size_t points () const;
+
+        /*
+         * allocate()
+         *
+         * Returns a zero scalar field of the hierarchy (as accepted by
+         * fillGhosts(), restrictToParents() and apply()).
+         */
+        AmrField allocate () const;
+
+        /*
+         * fillGhosts()
+         *
+         * Sets ghost nodes of all patches (level by level, so parents are
+         * complete before their ghost nodes are interpolated).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if f is not a scalar field of the
+         * hierarchy.
+         */
+        void fillGhosts (AmrField & f) const;
+
+        /*
+         * restrictToParents()
+         *
+         * Copies values of owned nodes of every patch to coinciding nodes
+         * of its parent (finest patches first).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if f is not a scalar field of the
+         * hierarchy.
+         */
+        void restrictToParents (AmrField & f) const;
+
+        /*
+         * apply()
+         *
+         * Evaluates operator at every node of every patch grid (see
+         * FieldEngine::apply()). Only values at owned nodes are accurate
+         * (ghost node stencils are shifted inwards), and only if ghost
+         * nodes of f are up to date.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const FieldOperator & op
+         *     Evaluated operator.
+         *
+         * const AmrField & f
+         *     Scalar field of the hierarchy.
+         *
+         * AmrField & out
+         *     Field receiving op.components() values per node (resized if
+         *     needed).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * f is not a scalar field of the hierarchy
+         *     * Operator order is higher than the one given in constructor
+         *     * Operator does not fit the grid (see FieldOperator::fits())
+         */
+        void apply (const FieldOperator &   op,
+                    const AmrField      &    f,
+                    AmrField            &  out) const;
+
+}; /* class AmrHierarchy */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_AMR_HIERARCHY_H */
@@ -0,0 +1,270 @@
+/*
+ * File: autotuner.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing AutoTuner class methods implementation (declared
+ * in autotuner.h header file).
+ */
+
+#include "autotuner.h"
+#include "util.h"     /* MonotonicSeconds */
+
+#include <cmath>      /* sin */
+#include <fstream>    /* std::ifstream, std::ofstream */
+#include <sstream>    /* std::istringstream, std::ostringstream */
+#include <stdexcept>  /* std::invalid_argument, std::runtime_error */
+#include <vector>     /* std::vector */
+
+
+#ifdef _OPENMP
+#include <omp.h>      /* omp_get_max_threads */
+#endif
+
+namespace GridDiff
+{
+
+namespace
+{
+
+/*
+ * Returns number of threads available for evaluation.
+ */
+unsigned MaxThreads ()
+{
+#ifdef _OPENMP
+    return (unsigned) omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/*
+ * Appends value to candidate list, unless it is already there.
+ */
+void AddCandidate (std::vector<size_t> & list, const size_t & value)
+{
+    for (size_t i = 0; i < list.size(); ++i){
+        if (list[i] == value){ return; }
+    }
+    list.push_back(value);
+}
+
+} /* anonymous namespace */
+
+
+AutoTuner::AutoTuner (const std::string &    path,
+                      const unsigned    & repeats)
+
+                    : mPath    (path),
+                      mRepeats (repeats)
+{
+    /* If one of arguments is invalid, throw exception. */
+    if (repeats == 0){
+        throw std::invalid_argument("zero tuning repeats");
+    }
+
+    if (path.empty()){
+        return;
+    }
+
+    std::ifstream file(path.c_str());
+    std::string   line;
+
+    while (std::getline(file, line)){
+        if (line.empty() || line[0] == '#'){
+            continue;
+        }
+
+        std::istringstream is(line);
+        std::string        name;
+        unsigned           width, maxThreads, kernel;
+        size_t             n1, n2, n3;
+        FieldEngineConfig  config;
+
+        if (!(is >> name >> width >> n1 >> n2 >> n3 >> maxThreads
+                 >> config.tile1 >> config.tile2 >> config.tile3
+                 >> config.threads >> kernel) || kernel > FIELD_KERNEL_DOT){
+            throw std::runtime_error("malformed tuning file");
+        }
+
+        config.kernel = (FieldKernel) kernel;
+
+        std::ostringstream os;
+        os << name << ' ' << width << ' ' << n1 << ' ' << n2 << ' ' << n3
+           << ' ' << maxThreads;
+
+        mCache[os.str()] = config;
+    }
+}
+
+
+std::string AutoTuner::key (const std::string & name,
+                            const FieldEngine & engine)
+{
+    std::ostringstream os;
+
+    os << name                           << ' '
+       << engine.plan(AXIS_Q1).width()   << ' '
+       << engine.n1()                    << ' '
+       << engine.n2()                    << ' '
+       << engine.n3()                    << ' '
+       << MaxThreads();
+
+    return os.str();
+}
+
+
+double AutoTuner::time (FieldEngine             & engine,
+                        const FieldOperator     &     op,
+                        const FieldEngineConfig & config,
+                        const double            *      f,
+                        double                  *    out) const
+{
+    engine.setConfig(config);
+
+    /* Warm-up evaluation (thread creation, page faults). */
+    engine.apply(op, f, out);
+
+    double best = 0.0;
+
+    for (unsigned r = 0; r < mRepeats; ++r){
+        const double t0 = MonotonicSeconds();
+        engine.apply(op, f, out);
+        const double t  = MonotonicSeconds() - t0;
+
+        if (r == 0 || t < best){ best = t; }
+    }
+
+    return best;
+}
+
+
+bool AutoTuner::lookup (const std::string & name,
+                        const FieldEngine & engine,
+                        FieldEngineConfig & config) const
+{
+    std::map<std::string, FieldEngineConfig>::const_iterator it =
+        mCache.find(key(name, engine));
+
+    if (it == mCache.end()){
+        return false;
+    }
+
+    config = it->second;
+    return true;
+}
+
+
+FieldEngineConfig AutoTuner::tune (FieldEngine         & engine,
+                                   const FieldOperator &     op,
+                                   const std::string   &   name)
+{
+    /* If arguments invalid, throw exception. */
+    if (name.empty() || name.find_first_of(" \t\r\n") != std::string::npos){
+        throw std::invalid_argument("invalid operator name");
+    }
+
+    const bool        blocking = engine.config().temporalBlocking;
+    FieldEngineConfig best;
+
+    /* Stored configuration. */
+    if (lookup(name, engine, best)){
+        best.temporalBlocking = blocking;
+        engine.setConfig(best);
+        return best;
+    }
+
+    /* Synthetic field; values do not affect timings, as long as they are
+     * not denormal. */
+    const size_t        N = engine.size();
+    std::vector<double> f(N), out(N * op.components());
+
+    for (size_t i = 0; i < N; ++i){
+        f[i] = 1.0 + sin(1e-3 * i);
+    }
+
+    /* Candidate values of every parameter. */
+    const unsigned      nth = MaxThreads();
+    std::vector<size_t> threads, kernels, tiles2, tiles1, tiles3;
+
+    for (unsigned t = nth; t >= 1; t /= 2){
+        AddCandidate(threads, t);
+        if (threads.size() == 3){ break; }
+    }
+
+    AddCandidate(kernels, FIELD_KERNEL_ACCUMULATE);
+    AddCandidate(kernels, FIELD_KERNEL_DOT);
+
+    for (size_t t = 1; t < engine.n2(); t *= 2){
+        AddCandidate(tiles2, t);
+    }
+    AddCandidate(tiles2, engine.n2());
+
+    AddCandidate(tiles1, 0);
+    for (size_t t = 32; t < engine.n1(); t *= 4){
+        AddCandidate(tiles1, t);
+    }
+
+    for (size_t t = 1; t <= 4 && t < engine.n3(); t *= 2){
+        AddCandidate(tiles3, t);
+    }
+
+    /* Parameters are tuned one at a time. */
+    best.threads          = nth;
+    best.temporalBlocking = blocking;
+
+    double bestTime = time(engine, op, best, &f[0], &out[0]);
+
+    for (unsigned param = 0; param < 5; ++param){
+        const std::vector<size_t> & list = (param == 0) ? threads
+                                         : (param == 1) ? kernels
+                                         : (param == 2) ? tiles2
+                                         : (param == 3) ? tiles1
+                                         :                tiles3;
+
+        for (size_t c = 0; c < list.size(); ++c){
+            FieldEngineConfig candidate = best;
+
+            switch (param){
+                case 0:  candidate.threads = (unsigned) list[c];       break;
+                case 1:  candidate.kernel  = (FieldKernel) list[c];    break;
+                case 2:  candidate.tile2   = list[c];                  break;
+                case 3:  candidate.tile1   = list[c];                  break;
+                default: candidate.tile3   = list[c];                  break;
+            }
+
+            const double t = time(engine, op, candidate, &f[0], &out[0]);
+
+            if (t < bestTime){
+                bestTime = t;
+                best     = candidate;
+            }
+        }
+    }
+
+    engine.setConfig(best);
+
+    /* Storing result. */
+    const std::string k = key(name, engine);
+    mCache[k] = best;
+
+    if (!mPath.empty()){
+        std::ofstream file(mPath.c_str(), std::ios::app);
+
+        file << k            << ' '
+             << best.tile1   << ' '
+             << best.tile2   << ' '
+             << best.tile3   << ' '
+             << best.threads << ' '
+             << (unsigned) best.kernel << '\n';
+
+        if (!file){
+            throw std::runtime_error("cannot write tuning file");
+        }
+    }
+
+    return best;
+}
+
+} /* namespace GridDiff */
@@ -0,0 +1,156 @@
+/*
+ * File: autotuner.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing AutoTuner class used for choosing FieldEngine
+ * tuning parameters (see FieldEngineConfig struct in field_engine.h header
+ * file) by timing candidate configurations. Chosen configurations are kept
+ * in a tuning file, so they are timed only once per operator, stencil width
+ * and grid shape.
+ */
+
+#ifndef GRIDDIFF_AUTOTUNER_H
+#define GRIDDIFF_AUTOTUNER_H
+
+#include "field_engine.h"    /* FieldEngine, FieldEngineConfig */
+#include "field_operator.h"  /* FieldOperator */
+
+#include <map>               /* std::map */
+#include <string>            /* std::string */
+
+namespace GridDiff
+{
+
+/*
+ * AutoTuner class
+ *
+ * Tuning file is a text file with one line per tuned case:
+ *
+ *     operator width n1 n2 n3 maxthreads tile1 tile2 tile3 threads kernel
+ *
+ * where maxthreads is the number of threads available when tuning (results
+ * are not reused on machines with different thread counts). Lines starting
+ * with '#' are ignored.
+ */
+class AutoTuner
+{
+    protected:
+        /* Tuning file path (empty if results are not stored). */
+        std::string                               mPath;
+        /* Tuned configurations by case key. */
+        std::map<std::string, FieldEngineConfig> mCache;
+        /* Number of timed evaluations per candidate. */
+        unsigned                                  mRepeats;
+
+        /*
+         * key()
+         *
+         * Case key of given operator name and engine.
+         */
+        static std::string key (const std::string & name,
+                                const FieldEngine & engine);
+
+        /*
+         * time()
+         *
+         * Best time (in seconds) of evaluating operator with given
+         * configuration.
+         */
+        double time (FieldEngine             & engine,
+                     const FieldOperator     &     op,
+                     const FieldEngineConfig & config,
+                     const double            *      f,
+                     double                  *    out) const;
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Constructor
+         *
+         * Loads tuning file (if exists).
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const std::string & path
+         *     Tuning file path. If empty, results are kept in memory only.
+         *
+         * const unsigned & repeats
+         *     Number of timed evaluations per candidate configuration (the
+         *     best one counts).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if repeats is zero.
+         * std::runtime_error if tuning file exists, but is malformed.
+         */
+        AutoTuner (const std::string &    path,
+                   const unsigned    & repeats = 3);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /*
+         * lookup()
+         *
+         * Finds tuned configuration of given case.
+         *
+         * ---------
+         *  Returns
+         * ---------
+         * true (and sets config) if configuration was found.
+         */
+        bool lookup (const std::string & name,
+                     const FieldEngine & engine,
+                     FieldEngineConfig & config) const;
+
+        /*
+         * tune()
+         *
+         * Sets engine configuration best for evaluating given operator.
+         * If the case was tuned before, stored configuration is used
+         * without timing. Otherwise parameters are tuned one at a time
+         * (threads, kernel, tile2, tile1, tile3; every one with the best
+         * values of previous ones) by timing FieldEngine::apply() on
+         * a synthetic field, and the result is appended to tuning file.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * FieldEngine & engine
+         *     Tuned engine. Its temporalBlocking setting is kept.
+         *
+         * const FieldOperator & op
+         *     Evaluated operator.
+         *
+         * const std::string & name
+         *     Operator name identifying the case (cannot contain
+         *     whitespace).
+         *
+         * ---------
+         *  Returns
+         * ---------
+         * Chosen configuration.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if name is empty or contains whitespace.
+         * std::runtime_error if tuning file cannot be written.
+         * Exceptions thrown by FieldEngine::apply().
+         */
+        FieldEngineConfig tune (FieldEngine         & engine,
+                                const FieldOperator &     op,
+                                const std::string   &   name);
+
+}; /* class AutoTuner */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_AUTOTUNER_H */
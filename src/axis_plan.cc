@@ -0,0 +1,194 @@
+/*
+ * File: axis_plan.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing AxisPlan class methods implementation
+ * (declared in axis_plan.h header file).
+ */
+
+#include "axis_plan.h"
+#include "fornberg_nderivs.h" /* FornbergNumDerivsCoeffs,
+                                 FornbergCoeffsSymmetry,
+                                 FornbergSymmetrizeCoeffs */
+#include "util.h"             /* IsIncreasing */
+
+#include <algorithm>          /* std::min */
+#include <stdexcept>          /* std::invalid_argument */
+
+namespace GridDiff
+{
+
+namespace
+{
+
+/* Largest relative difference of mirrored coefficients of symmetric
+ * stencils (rounding errors of coefficients and of grid point positions
+ * of uniformly spaced grids stay well below it). */
+const double SYMMETRY_TOLERANCE = 1e-10;
+
+} /* anonymous namespace */
+
+
+AxisPlan::AxisPlan ()
+{
+    mSize     = 0;
+    mWidth    = 0;
+    mMaxOrder = 0;
+}
+
+
+AxisPlan::AxisPlan (const QGrid    &   coords,
+                    const unsigned &    width,
+                    const unsigned & maxOrder)
+{
+    /* Initializing members (in case of exception occurrence). */
+    mSize     = 0;
+    mWidth    = 0;
+    mMaxOrder = 0;
+
+    /* If one of arguments is invalid, throw exception. */
+    if (width <= maxOrder){
+        throw std::invalid_argument("stencil width <= max deriv. order");
+    }
+
+    if (coords.size() < width){
+        throw std::invalid_argument("grid size < stencil width");
+    }
+
+    if (!IsIncreasing(coords)){
+        throw std::invalid_argument("grid not strictly increasing");
+    }
+
+    /* Setting members to argument values. */
+    mSize     = coords.size();
+    mWidth    = width;
+    mMaxOrder = maxOrder;
+
+    mStarts  .resize(mSize);
+    mSymmetry.resize(mSize * (maxOrder+1));
+    mCoeffs = StencilTable((maxOrder+1) * width);
+
+    /* Choosing stencils (centered, shifted inwards near boundaries) and
+     * calculating coefficients up to the derivative of order maxOrder.
+     * Coefficients are evaluated (and checked for symmetry) in parallel
+     * for chunks of nodes and then added to the table in order. */
+    const long   n     = (long) mSize;
+    const long   last  = n - (long) width;
+    const size_t row   = (maxOrder+1) * width;
+    const long   chunk = 4096;
+
+    std::vector<double> coeffs(std::min(n, chunk) * row);
+
+    for (long c0 = 0; c0 < n; c0 += chunk){
+        const long c1 = std::min(n, c0 + chunk);
+
+        #pragma omp parallel for schedule(static)
+        for (long i = c0; i < c1; ++i){
+            long s = i - (long) ((width-1) / 2);
+
+            if (s < 0)   { s = 0; }
+            if (s > last){ s = last; }
+
+            mStarts[i] = (size_t) s;
+
+            FornbergNumDerivsCoeffs(&coeffs[(i - c0) * row],
+                                    coords[i], &coords[s],
+                                    width, maxOrder+1);
+
+            for (unsigned k = 0; k <= maxOrder; ++k){
+                double  * c   = &coeffs[(i - c0) * row + k * width];
+                const int sym = FornbergCoeffsSymmetry(c, width,
+                                                       SYMMETRY_TOLERANCE);
+
+                FornbergSymmetrizeCoeffs(c, width, sym);
+                mSymmetry[i * (maxOrder+1) + k] = (unsigned char) sym;
+            }
+        }
+
+        for (long i = c0; i < c1; ++i){
+            mCoeffs.append(&coeffs[(i - c0) * row]);
+        }
+    }
+
+    mCoeffs.shrink();
+}
+
+AxisPlan::AxisPlan (const unsigned            &    width,
+                    const unsigned            & maxOrder,
+                    const std::vector<size_t> &   starts,
+                    const StencilTable        &   coeffs)
+{
+    /* Initializing members (in case of exception occurrence). */
+    mSize     = 0;
+    mWidth    = 0;
+    mMaxOrder = 0;
+
+    /* If one of arguments is invalid, throw exception. */
+    if (width <= maxOrder){
+        throw std::invalid_argument("stencil width <= max deriv. order");
+    }
+
+    if (starts.size() != coeffs.size() || starts.size() < width){
+        throw std::invalid_argument("invalid plan size");
+    }
+
+    if (coeffs.length() != (maxOrder+1) * width || coeffs.floatRows() != 0){
+        throw std::invalid_argument("invalid plan coefficients");
+    }
+
+    for (size_t i = 0; i < starts.size(); ++i){
+        if (starts[i] > starts.size() - width){
+            throw std::invalid_argument("stencil exceeds grid");
+        }
+    }
+
+    /* Setting members to argument values. */
+    mSize     = starts.size();
+    mWidth    = width;
+    mMaxOrder = maxOrder;
+    mStarts   = starts;
+    mCoeffs   = coeffs;
+
+    /* Symmetries of restored coefficients (already made exact when the
+     * plan was built). */
+    mSymmetry.resize(mSize * (maxOrder+1));
+
+    for (size_t i = 0; i < mSize; ++i){
+        for (unsigned k = 0; k <= maxOrder; ++k){
+            mSymmetry[i * (maxOrder+1) + k] = (unsigned char)
+                FornbergCoeffsSymmetry(coeffs.doubleRow(i) + k * width,
+                                       width, 0.0);
+        }
+    }
+}
+
+
+size_t AxisPlan::reachBelow () const
+{
+    size_t reach = 0;
+
+    for (size_t i = 0; i < mSize; ++i){
+        if (i - mStarts[i] > reach){
+            reach = i - mStarts[i];
+        }
+    }
+
+    return reach;
+}
+
+
+size_t AxisPlan::reachAbove () const
+{
+    size_t reach = 0;
+
+    for (size_t i = 0; i < mSize; ++i){
+        if (mStarts[i] + mWidth - 1 - i > reach){
+            reach = mStarts[i] + mWidth - 1 - i;
+        }
+    }
+
+    return reach;
+}
+
+} /* namespace GridDiff */
@@ -0,0 +1,200 @@
+/*
+ * File: axis_plan.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing AxisPlan class. It holds Fornberg coefficients
+ * for evaluating derivatives at every node of a one-dimensional grid using
+ * a fixed number of neighbouring grid nodes (stencil width). It is used by
+ * field-level evaluation classes (see field_engine.h header file).
+ */
+
+#ifndef GRIDDIFF_AXIS_PLAN_H
+#define GRIDDIFF_AXIS_PLAN_H
+
+#include "qobj.h"           /* QGrid */
+#include "stencil_table.h"  /* StencilTable */
+
+#include <vector>           /* std::vector */
+
+namespace GridDiff
+{
+
+/*
+ * AxisPlan class
+ *
+ * For every node i of a grid axis, a stencil of width consecutive grid
+ * nodes starting at start(i) is chosen. Stencils are centered at i, but
+ * shifted inwards near axis boundaries (one-sided stencils), so every node
+ * can be evaluated. Coefficients c(k,j) for derivative orders
+ * k=0,...,maxOrder are calculated with FornbergNumDerivsCoeffs and stored
+ * per node in the same layout the function produces (all coefficients of
+ * order k contiguous). Derivative of order k at node i is then equal to:
+ *
+ *     sum over j < width of coeffs(i,k)[j] * f(start(i) + j)
+ *
+ * Since coefficients are evaluated separately for every node, grid points
+ * can be arbitrarily spaced. Coefficients of a node are stored in
+ * a StencilTable, so nodes of uniformly spaced parts of the grid share
+ * them.
+ *
+ * Coefficients of every node and order are checked for symmetry (see
+ * FornbergCoeffsSymmetry): centered stencils of uniformly spaced parts of
+ * the grid have symmetric coefficients of even and antisymmetric ones of
+ * odd derivatives. Such coefficients are made exactly (anti)symmetric and
+ * marked (see symmetry()), so evaluation can add (subtract) values of
+ * mirrored stencil nodes first and halve the number of multiplications.
+ */
+class AxisPlan
+{
+    protected:
+        /* Number of grid nodes. */
+        size_t                     mSize;
+        /* Number of grid nodes used for every stencil. */
+        unsigned                   mWidth;
+        /* Highest derivative order. */
+        unsigned                   mMaxOrder;
+        /* First stencil node for every grid node. */
+        std::vector<size_t>        mStarts;
+        /* Coefficients; (mMaxOrder+1)*mWidth values for every node. */
+        StencilTable               mCoeffs;
+        /* Symmetry of coefficients of every node and order (FORNBERG_*
+         * values of fornberg_nderivs.h; mMaxOrder+1 values per node). */
+        std::vector<unsigned char> mSymmetry;
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Default constructor
+         *
+         * Creates an empty plan (of zero size).
+         */
+        AxisPlan ();
+
+        /*
+         * Constructor
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const QGrid & coords
+         *     Grid point positions along axis. Have to be strictly
+         *     increasing.
+         *
+         * const unsigned & width
+         *     Number of grid points used for every stencil.
+         *
+         * const unsigned & maxOrder
+         *     Highest derivative order.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * width <= maxOrder
+         *     * coords is of size < width
+         *     * coords is not strictly increasing
+         */
+        AxisPlan (const QGrid    &   coords,
+                  const unsigned &    width,
+                  const unsigned & maxOrder);
+
+        /*
+         * Constructor
+         *
+         * Restores a plan from its stencil starts and coefficients (e.g.
+         * read from a file, see plan_file.h header file).
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const unsigned & width
+         *     Number of grid points used for every stencil.
+         *
+         * const unsigned & maxOrder
+         *     Highest derivative order.
+         *
+         * const std::vector<size_t> & starts
+         *     First stencil node of every grid node.
+         *
+         * const StencilTable & coeffs
+         *     Coefficients of every grid node (see coeffs()).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * width <= maxOrder
+         *     * starts and coeffs have different sizes, smaller than width
+         *     * any stencil exceeds the grid
+         *     * coeffs rows are not (maxOrder+1)*width double values
+         */
+        AxisPlan (const unsigned            &    width,
+                  const unsigned            & maxOrder,
+                  const std::vector<size_t> &   starts,
+                  const StencilTable        &   coeffs);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /* Number of grid nodes. */
+        size_t   size     () const { return mSize; }
+
+        /* Number of grid nodes used for every stencil. */
+        unsigned width    () const { return mWidth; }
+
+        /* Highest derivative order. */
+        unsigned maxOrder () const { return mMaxOrder; }
+
+        /* First stencil node of ith grid node. */
+        size_t   start    (const size_t & i) const { return mStarts[i]; }
+
+        /* Pointer to width coefficients of kth derivative at ith node. */
+        const double * coeffs (const size_t   & i,
+                               const unsigned & k) const
+        {
+            return mCoeffs.doubleRow(i) + k * mWidth;
+        }
+
+        /* Coefficients of every node. */
+        const StencilTable & table () const { return mCoeffs; }
+
+        /* Symmetry of coefficients of kth derivative at ith node
+         * (FORNBERG_GENERAL, FORNBERG_SYMMETRIC or FORNBERG_ANTISYMMETRIC;
+         * see fornberg_nderivs.h header file). */
+        int symmetry (const size_t   & i,
+                      const unsigned & k) const
+        {
+            return mSymmetry[i * (mMaxOrder+1) + k];
+        }
+
+        /* Number of distinct coefficient rows (at most size()). */
+        size_t rows () const { return mCoeffs.doubleRows(); }
+
+        /* Number of bytes taken by stencil starts, coefficients and
+         * their symmetries. */
+        size_t memoryFootprint () const
+        {
+            return mStarts.size() * sizeof(size_t) +
+                   mCoeffs.memoryFootprint()       +
+                   mSymmetry.size();
+        }
+
+        /*
+         * reachBelow(), reachAbove()
+         *
+         * Largest distance (in grid nodes) between a node and the first
+         * (reachBelow) or the last (reachAbove) node of its stencil.
+         */
+        size_t reachBelow () const;
+        size_t reachAbove () const;
+
+}; /* class AxisPlan */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_AXIS_PLAN_H */
@@ -1,7 +1,7 @@
 /*
  * File: basic_3D_diffop.cc
  * Author(s): P Kuszaj
- * Last changed: 28.01.2015
+ * Last changed: 18.10.2026
  *
  * A source file providing Basic_3D_DiffOp class methods implementation
  * (declared in basic_3D_diffop.h header file).
@@ -10,7 +10,8 @@
 #include "basic_3D_diffop.h"
 #include "fornberg_nderivs.h" /* FornbergNumDerivsCoeffs,
                                  FornbergGetCoeffList,
-                                 FornbergKDerivEval */
+                                 FornbergKDerivEval,
+                                 FornbergDerivsEval */
 
 #include <cstring>            /* memcpy */
 #include <stdexcept>          /* std::invalid_argument */
@@ -18,6 +19,36 @@
 namespace GridDiff
 {
 
+namespace
+{
+
+/*
+ * Evaluates mixed derivative of orders ka and kb along axes a and b (with
+ * na and nb grid points) from values at the tensor subgrid (a index
+ * running fastest), using sum factorization.
+ */
+double EvalMixedDiff (const double   * coeffsA,
+                      const size_t   &      na,
+                      const unsigned &      ka,
+                      const double   * coeffsB,
+                      const size_t   &      nb,
+                      const unsigned &      kb,
+                      const QGrid    &    vals)
+{
+    const double * ca = coeffsA + ka * na;
+    const double * cb = coeffsB + kb * nb;
+    double         d  = 0.0;
+
+    for (size_t b = 0; b < nb; ++b){
+        d += cb[b] * FornbergKDerivEval(ca, &vals[b * na], na);
+    }
+
+    return d;
+}
+
+} /* anonymous namespace */
+
+
 Basic_3D_DiffOp::Basic_3D_DiffOp (const QPoint   &  q0Point,
                                   const QGrid    & q1Coords,
                                   const QGrid    & q2Coords,
@@ -169,9 +200,9 @@ Basic_3D_DiffOp & Basic_3D_DiffOp::operator= (const Basic_3D_DiffOp & other)
         mQ3Coords = other.mQ3Coords;
 
         /* If coefficient pointers aren't NULL, free memory. */
-        if (pQ1Coeffs != NULL) { delete [] pQ1Coeffs; }
-        if (pQ2Coeffs != NULL) { delete [] pQ2Coeffs; }
-        if (pQ3Coeffs != NULL) { delete [] pQ3Coeffs; }
+        if (pQ1Coeffs != NULL) { delete [] pQ1Coeffs; pQ1Coeffs = NULL; }
+        if (pQ2Coeffs != NULL) { delete [] pQ2Coeffs; pQ2Coeffs = NULL; }
+        if (pQ3Coeffs != NULL) { delete [] pQ3Coeffs; pQ3Coeffs = NULL; }
 
         /* If other has non-null pointers to coefficients, allocate
          * memory. */
@@ -217,7 +248,7 @@ Basic_3D_DiffOp & Basic_3D_DiffOp::operator= (const Basic_3D_DiffOp & other)
 
 
 double Basic_3D_DiffOp::fEvalQ1Diff (const unsigned &  order,
-                                     const QGrid    & q1Vals)
+                                     const QGrid    & q1Vals) const
 {
     /* If arguments invalid, throw exception. */
     if (order > mMaxOrder){
@@ -233,9 +264,9 @@ double Basic_3D_DiffOp::fEvalQ1Diff (const unsigned &  order,
     }
 
     /* Extract proper coefficients. */
-    double * q1_k_coeffs = FornbergGetCoeffList(pQ1Coeffs,
-                                                mQ1Coords.size(),
-                                                order);
+    const double * q1_k_coeffs = FornbergGetCoeffList(pQ1Coeffs,
+                                                      mQ1Coords.size(),
+                                                      order);
     
     /* Return partial derivative of given order. */
     return FornbergKDerivEval(q1_k_coeffs,
@@ -244,7 +275,7 @@ double Basic_3D_DiffOp::fEvalQ1Diff (const unsigned &  order,
 
 
 double Basic_3D_DiffOp::fEvalQ2Diff (const unsigned &  order,
-                                     const QGrid    & q2Vals)
+                                     const QGrid    & q2Vals) const
 {
     /* If arguments invalid, throw exception. */
     if (order > mMaxOrder){
@@ -260,9 +291,9 @@ double Basic_3D_DiffOp::fEvalQ2Diff (const unsigned &  order,
     }
 
     /* Extract proper coefficients. */
-    double * q2_k_coeffs = FornbergGetCoeffList(pQ2Coeffs,
-                                                mQ2Coords.size(),
-                                                order);
+    const double * q2_k_coeffs = FornbergGetCoeffList(pQ2Coeffs,
+                                                      mQ2Coords.size(),
+                                                      order);
     
     /* Return partial derivative of given order. */
     return FornbergKDerivEval(q2_k_coeffs,
@@ -271,7 +302,7 @@ double Basic_3D_DiffOp::fEvalQ2Diff (const unsigned &  order,
 
 
 double Basic_3D_DiffOp::fEvalQ3Diff (const unsigned &  order,
-                                     const QGrid    & q3Vals)
+                                     const QGrid    & q3Vals) const
 {
     /* If arguments invalid, throw exception. */
     if (order > mMaxOrder){
@@ -287,13 +318,166 @@ double Basic_3D_DiffOp::fEvalQ3Diff (const unsigned &  order,
     }
 
     /* Extract proper coefficients. */
-    double * q3_k_coeffs = FornbergGetCoeffList(pQ3Coeffs,
-                                                mQ3Coords.size(),
-                                                order);
+    const double * q3_k_coeffs = FornbergGetCoeffList(pQ3Coeffs,
+                                                      mQ3Coords.size(),
+                                                      order);
     
     /* Return partial derivative of given order. */
     return FornbergKDerivEval(q3_k_coeffs,
                               &q3Vals[0], q3Vals.size());
 }
 
+
+void Basic_3D_DiffOp::fEvalQ1Diffs (const QGrid & q1Vals,
+                                    double      *  diffs) const
+{
+    fEvalQ1Diffs(q1Vals, diffs, mMaxOrder);
+}
+
+
+void Basic_3D_DiffOp::fEvalQ1Diffs (const QGrid    &   q1Vals,
+                                    double         *    diffs,
+                                    const unsigned & maxOrder) const
+{
+    /* If arguments invalid, throw exception. */
+    if (maxOrder > mMaxOrder){
+        throw std::invalid_argument("given order higher than max");
+    }
+
+    if (q1Vals.size() < mQ1Coords.size()){
+        throw std::invalid_argument("too little values at grid points given");
+    }
+
+    if (q1Vals.size() > mQ1Coords.size()){
+        throw std::invalid_argument("too much values at grid points given");
+    }
+
+    /* Evaluate derivatives of orders 0,...,maxOrder (rows of lower
+     * orders come first in coefficient table). */
+    FornbergDerivsEval(pQ1Coeffs, &q1Vals[0], q1Vals.size(),
+                       maxOrder+1, diffs);
+}
+
+
+void Basic_3D_DiffOp::fEvalQ2Diffs (const QGrid & q2Vals,
+                                    double      *  diffs) const
+{
+    fEvalQ2Diffs(q2Vals, diffs, mMaxOrder);
+}
+
+
+void Basic_3D_DiffOp::fEvalQ2Diffs (const QGrid    &   q2Vals,
+                                    double         *    diffs,
+                                    const unsigned & maxOrder) const
+{
+    /* If arguments invalid, throw exception. */
+    if (maxOrder > mMaxOrder){
+        throw std::invalid_argument("given order higher than max");
+    }
+
+    if (q2Vals.size() < mQ2Coords.size()){
+        throw std::invalid_argument("too little values at grid points given");
+    }
+
+    if (q2Vals.size() > mQ2Coords.size()){
+        throw std::invalid_argument("too much values at grid points given");
+    }
+
+    /* Evaluate derivatives of orders 0,...,maxOrder (rows of lower
+     * orders come first in coefficient table). */
+    FornbergDerivsEval(pQ2Coeffs, &q2Vals[0], q2Vals.size(),
+                       maxOrder+1, diffs);
+}
+
+
+void Basic_3D_DiffOp::fEvalQ3Diffs (const QGrid & q3Vals,
+                                    double      *  diffs) const
+{
+    fEvalQ3Diffs(q3Vals, diffs, mMaxOrder);
+}
+
+
+void Basic_3D_DiffOp::fEvalQ3Diffs (const QGrid    &   q3Vals,
+                                    double         *    diffs,
+                                    const unsigned & maxOrder) const
+{
+    /* If arguments invalid, throw exception. */
+    if (maxOrder > mMaxOrder){
+        throw std::invalid_argument("given order higher than max");
+    }
+
+    if (q3Vals.size() < mQ3Coords.size()){
+        throw std::invalid_argument("too little values at grid points given");
+    }
+
+    if (q3Vals.size() > mQ3Coords.size()){
+        throw std::invalid_argument("too much values at grid points given");
+    }
+
+    /* Evaluate derivatives of orders 0,...,maxOrder (rows of lower
+     * orders come first in coefficient table). */
+    FornbergDerivsEval(pQ3Coeffs, &q3Vals[0], q3Vals.size(),
+                       maxOrder+1, diffs);
+}
+
+
+double Basic_3D_DiffOp::fEvalQ12Diff (const unsigned &  order1,
+                                      const unsigned &  order2,
+                                      const QGrid    & q12Vals) const
+{
+    /* If arguments invalid, throw exception. */
+    if (order1 > mMaxOrder || order2 > mMaxOrder){
+        throw std::invalid_argument("given order higher than max");
+    }
+
+    if (q12Vals.size() != mQ1Coords.size() * mQ2Coords.size()){
+        throw std::invalid_argument("wrong number of subgrid values given");
+    }
+
+    /* Return mixed partial derivative of given orders. */
+    return EvalMixedDiff(pQ1Coeffs, mQ1Coords.size(), order1,
+                         pQ2Coeffs, mQ2Coords.size(), order2,
+                         q12Vals);
+}
+
+
+double Basic_3D_DiffOp::fEvalQ13Diff (const unsigned &  order1,
+                                      const unsigned &  order3,
+                                      const QGrid    & q13Vals) const
+{
+    /* If arguments invalid, throw exception. */
+    if (order1 > mMaxOrder || order3 > mMaxOrder){
+        throw std::invalid_argument("given order higher than max");
+    }
+
+    if (q13Vals.size() != mQ1Coords.size() * mQ3Coords.size()){
+        throw std::invalid_argument("wrong number of subgrid values given");
+    }
+
+    /* Return mixed partial derivative of given orders. */
+    return EvalMixedDiff(pQ1Coeffs, mQ1Coords.size(), order1,
+                         pQ3Coeffs, mQ3Coords.size(), order3,
+                         q13Vals);
+}
+
+
+double Basic_3D_DiffOp::fEvalQ23Diff (const unsigned &  order2,
+                                      const unsigned &  order3,
+                                      const QGrid    & q23Vals) const
+{
+    /* If arguments invalid, throw exception. */
+    if (order2 > mMaxOrder || order3 > mMaxOrder){
+        throw std::invalid_argument("given order higher than max");
+    }
+
+    if (q23Vals.size() != mQ2Coords.size() * mQ3Coords.size()){
+        throw std::invalid_argument("wrong number of subgrid values given");
+    }
+
+    /* Return mixed partial derivative of given orders. */
+    return EvalMixedDiff(pQ2Coeffs, mQ2Coords.size(), order2,
+                         pQ3Coeffs, mQ3Coords.size(), order3,
+                         q23Vals);
+}
+
 } /* namespace GridDiff */
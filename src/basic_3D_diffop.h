@@ -1,7 +1,7 @@
 /*
  * File: basic_3D_diffop.h
  * Author(s): P Kuszaj
- * Last changed: 28.01.2015
+ * Last changed: 18.10.2026
  *
  * A header file providing Basic_3D_DiffOp class. It can be used as
  * a parent class for defining partial differential operators classes
@@ -29,7 +29,8 @@ namespace GridDiff
  *
  * Class holds position, at which calculations will be performed (mQ0Point),
  * grid points coordinates along a paricular axis (it is assumed, that grid
- * points differs from mQ0Point in at most one coordinate value),
+ * points differs from mQ0Point in at most one coordinate value, except for
+ * mixed derivatives evaluated on tensor subgrids of two axes),
  * coefficients used in discrete dervatives calculation (automatically
  * optimized) and maximal derivative order.
  *
@@ -59,7 +60,15 @@ namespace GridDiff
  *     L(q1Vals,q2Vals,q3Vals) = 1.50 * fEvalQ1Diff(2, q1Vals)
  *                             + 2.00 * fEvalQ2Diff(1, q2Vals)
  *                             - 0.25 * fEvalQ3Diff(3, q3Vals)
- * with qiVals being function values for grid points on qi axis.
+ * with qiVals being function values for grid points on qi axis. If several
+ * orders along the same axis are needed, fEvalQiDiffs (i=1,2,3) evaluate
+ * all of them in a single pass over function values.
+ *
+ * All evaluation methods (fEvalQiDiff, fEvalQiDiffs, fEvalQijDiff and
+ * eval() methods of child classes) are const and only read coefficients
+ * calculated by the constructor, so a single instance can be shared by
+ * many threads evaluating concurrently (as long as it is not assigned to
+ * at the same time); there is no need to copy it for every thread.
  */
 class Basic_3D_DiffOp
 {
@@ -112,11 +121,123 @@ class Basic_3D_DiffOp
          *     * qiVals size not equal to number of grid points along qi axis
          */
         double fEvalQ1Diff (const unsigned &  order,
-                            const QGrid    & q1Vals);
+                            const QGrid    & q1Vals) const;
         double fEvalQ2Diff (const unsigned &  order,
-                            const QGrid    & q2Vals);
+                            const QGrid    & q2Vals) const;
         double fEvalQ3Diff (const unsigned &  order,
-                            const QGrid    & q3Vals);
+                            const QGrid    & q3Vals) const;
+
+        /*
+         * fEvalQiDiffs() (i=1,2,3)
+         *
+         * Evaluates all numerical partial derivatives of orders
+         * 0,...,mMaxOrder along qi axis in a single pass over given
+         * function values. Should be used instead of fEvalQiDiff() if
+         * several orders along the same axis are needed.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const QGrid & qiVals
+         *     Function values at grid points on qi axis (see fEvalQiDiff()).
+         *
+         * double * diffs
+         *     Array receiving mMaxOrder+1 values: diffs[k] is the partial
+         *     derivative d^k/dqi^k at mQ0Point.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if qiVals size not equal to number of grid
+         * points along qi axis.
+         */
+        void fEvalQ1Diffs (const QGrid & q1Vals, double * diffs) const;
+        void fEvalQ2Diffs (const QGrid & q2Vals, double * diffs) const;
+        void fEvalQ3Diffs (const QGrid & q3Vals, double * diffs) const;
+
+        /*
+         * fEvalQiDiffs() (i=1,2,3)
+         *
+         * Evaluates numerical partial derivatives of orders 0,...,maxOrder
+         * only (see fEvalQiDiffs() above), e.g. when an operator uses
+         * orders up to 2 of a table generated for higher ones.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const QGrid & qiVals
+         *     Function values at grid points on qi axis (see fEvalQiDiff()).
+         *
+         * double * diffs
+         *     Array receiving maxOrder+1 values: diffs[k] is the partial
+         *     derivative d^k/dqi^k at mQ0Point.
+         *
+         * const unsigned & maxOrder
+         *     Highest evaluated order.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * maxOrder is higher than mMaxOrder
+         *     * qiVals size not equal to number of grid points along qi axis
+         */
+        void fEvalQ1Diffs (const QGrid    &   q1Vals,
+                           double         *    diffs,
+                           const unsigned & maxOrder) const;
+        void fEvalQ2Diffs (const QGrid    &   q2Vals,
+                           double         *    diffs,
+                           const unsigned & maxOrder) const;
+        void fEvalQ3Diffs (const QGrid    &   q3Vals,
+                           double         *    diffs,
+                           const unsigned & maxOrder) const;
+
+        /*
+         * fEvalQijDiff() (ij=12,13,23)
+         *
+         * Returns mixed numerical partial derivative d^(ki+kj)/dqi^ki dqj^kj
+         * using function values at nodes of the tensor subgrid spanned by
+         * mQiCoords and mQjCoords (the remaining coordinate equal to that
+         * of mQ0Point). Coefficients are tensor products of those used by
+         * fEvalQiDiff() and fEvalQjDiff(), but they are applied by sum
+         * factorization: first along qi axis for every qj grid point, then
+         * along qj axis.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const unsigned & orderi
+         * const unsigned & orderj
+         *     Derivative orders along qi and qj axes. Cannot be larger than
+         *     mMaxOrder.
+         *
+         * const QGrid & qijVals
+         *     Function values at subgrid nodes: value at (mQiCoords[a],
+         *     mQjCoords[b]) is qijVals[a + mQiCoords.size()*b]. Has to be of
+         *     size mQiCoords.size()*mQjCoords.size().
+         *
+         * ---------
+         *  Returns
+         * ---------
+         * Double value equal to numerical mixed partial derivative at
+         * mQ0Point.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * Any of given orders larger than allowed (order > mMaxOrder)
+         *     * qijVals size not equal to number of subgrid nodes
+         */
+        double fEvalQ12Diff (const unsigned &  order1,
+                             const unsigned &  order2,
+                             const QGrid    & q12Vals) const;
+        double fEvalQ13Diff (const unsigned &  order1,
+                             const unsigned &  order3,
+                             const QGrid    & q13Vals) const;
+        double fEvalQ23Diff (const unsigned &  order2,
+                             const unsigned &  order3,
+                             const QGrid    & q23Vals) const;
 
     public:
         /*************
@@ -198,6 +319,28 @@ class Basic_3D_DiffOp
          */
         Basic_3D_DiffOp & operator= (const Basic_3D_DiffOp & other);
 
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /* Highest derivative order. */
+        unsigned maxOrder () const { return mMaxOrder; }
+
+        /*
+         * coeffTableSize()
+         *
+         * Number of coefficients stored for qi axis (i = axis+1), i.e.
+         * number of grid points along the axis times mMaxOrder+1.
+         */
+        size_t coeffTableSize (const unsigned & axis) const
+        {
+            const QGrid & c = (axis == 0) ? mQ1Coords
+                            : (axis == 1) ? mQ2Coords
+                            :               mQ3Coords;
+
+            return c.size() * (mMaxOrder + 1);
+        }
+
 }; /* class Basic_3D_DiffOp */
 
 } /* namespace GridDiff */
@@ -0,0 +1,229 @@
+/*
+ * File: bricked_field.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing BrickedField class methods implementation
+ * (declared in bricked_field.h header file).
+ */
+
+#include "bricked_field.h"
+#include "morton.h"   /* MortonKey */
+
+#include <algorithm>  /* std::sort, std::copy, std::fill, std::min, std::max */
+#include <stdexcept>  /* std::invalid_argument */
+#include <utility>    /* std::pair, std::make_pair */
+
+namespace GridDiff
+{
+
+BrickedField::BrickedField (const FieldEngine &     engine,
+                            const unsigned    & components,
+                            const unsigned    &      brick)
+{
+    /* If one of arguments is invalid, throw exception. */
+    if (components == 0){
+        throw std::invalid_argument("zero field components");
+    }
+
+    unsigned width = 0;
+
+    for (unsigned a = 0; a < 3; ++a){
+        width = std::max(width, engine.plan(a).width());
+    }
+
+    if (brick < width){
+        throw std::invalid_argument("brick extent < stencil width");
+    }
+
+    /* Setting members. */
+    mGhost      = width / 2;
+    mComponents = components;
+
+    const size_t n[3] = { engine.n1(), engine.n2(), engine.n3() };
+
+    for (unsigned a = 0; a < 3; ++a){
+        mN[a]  = n[a];
+        mB[a]  = std::min((size_t) brick, n[a]);
+        mNb[a] = (n[a] + mB[a] - 1) / mB[a];
+        mP[a]  = mB[a] + 2 * mGhost;
+    }
+
+    mBrickValues = mP[0] * mP[1] * mP[2] * components;
+
+    /* Morton order of brick positions. */
+    typedef std::pair<unsigned long long, size_t> Key;
+
+    const size_t     nb = mNb[0] * mNb[1] * mNb[2];
+    std::vector<Key> keys(nb);
+
+    for (size_t b = 0; b < nb; ++b){
+        const size_t b1 = b % mNb[0],
+                     b2 = (b / mNb[0]) % mNb[1],
+                     b3 = b / (mNb[0] * mNb[1]);
+
+        keys[b] = std::make_pair(MortonKey(b1, b2, b3), b);
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    mPos .resize(3 * nb);
+    mSlot.resize(nb);
+
+    for (size_t s = 0; s < nb; ++s){
+        const size_t b = keys[s].second;
+
+        mPos[3*s]     = b % mNb[0];
+        mPos[3*s + 1] = (b / mNb[0]) % mNb[1];
+        mPos[3*s + 2] = b / (mNb[0] * mNb[1]);
+        mSlot[b]      = s;
+    }
+
+    mData.assign(nb * mBrickValues, 0.0);
+}
+
+
+size_t BrickedField::owner (const unsigned & axis, const size_t & i) const
+{
+    return std::min(i / mB[axis], mNb[axis] - 1);
+}
+
+
+void BrickedField::origin (const size_t & b, size_t * o) const
+{
+    for (unsigned a = 0; a < 3; ++a){
+        const size_t p = mPos[3*b + a];
+        o[a] = (p == mNb[a] - 1) ? mN[a] - mB[a] : p * mB[a];
+    }
+}
+
+
+void BrickedField::fromRowMajor (const double * f)
+{
+    const long   nb = (long) bricks();
+    const long   G  = (long) mGhost;
+    const size_t C  = mComponents;
+
+    #pragma omp parallel for schedule(static)
+    for (long b = 0; b < nb; ++b){
+        size_t o[3];
+        origin(b, o);
+
+        /* Range of padded row within the grid. */
+        const long lo1 = std::max(-G, -(long) o[0]);
+        const long hi1 = std::min((long) (mB[0] + G),
+                                  (long) (mN[0] - o[0]));
+
+        for (long l3 = -G; l3 < (long) mB[2] + G; ++l3){
+            for (long l2 = -G; l2 < (long) mB[1] + G; ++l2){
+                const long g2 = (long) o[1] + l2,
+                           g3 = (long) o[2] + l3;
+                double   * v  = brick(b) + local(-G, l2, l3) * C;
+
+                if (g2 < 0 || g2 >= (long) mN[1] ||
+                    g3 < 0 || g3 >= (long) mN[2]){
+                    std::fill(v, v + mP[0] * C, 0.0);
+                    continue;
+                }
+
+                const double * src = f + QFieldIndex(o[0] + lo1, g2, g3,
+                                                     mN[0], mN[1]) * C;
+
+                std::fill(v, v + (lo1 + G) * C, 0.0);
+                std::copy(src, src + (hi1 - lo1) * C, v + (lo1 + G) * C);
+                std::fill(v + (hi1 + G) * C, v + mP[0] * C, 0.0);
+            }
+        }
+    }
+}
+
+
+void BrickedField::toRowMajor (double * f) const
+{
+    const long   nb = (long) bricks();
+    const size_t C  = mComponents;
+
+    #pragma omp parallel for schedule(static)
+    for (long b = 0; b < nb; ++b){
+        size_t o[3], lo[3], hi[3];
+        origin(b, o);
+
+        /* Owned nodes. */
+        for (unsigned a = 0; a < 3; ++a){
+            lo[a] = mPos[3*b + a] * mB[a];
+            hi[a] = std::min(lo[a] + mB[a], mN[a]);
+        }
+
+        for (size_t g3 = lo[2]; g3 < hi[2]; ++g3){
+            for (size_t g2 = lo[1]; g2 < hi[1]; ++g2){
+                const double * v = brick(b)
+                                 + local((long) (lo[0] - o[0]),
+                                         (long) (g2 - o[1]),
+                                         (long) (g3 - o[2])) * C;
+
+                std::copy(v, v + (hi[0] - lo[0]) * C,
+                          f + QFieldIndex(lo[0], g2, g3, mN[0], mN[1]) * C);
+            }
+        }
+    }
+}
+
+
+void BrickedField::exchangeGhosts ()
+{
+    const long   nb = (long) bricks();
+    const long   G  = (long) mGhost;
+    const size_t C  = mComponents;
+
+    /* Every brick writes only nodes it does not own and reads only nodes
+     * owned by other bricks, so bricks can be processed in parallel. */
+    #pragma omp parallel for schedule(static)
+    for (long b = 0; b < nb; ++b){
+        size_t o[3];
+        origin(b, o);
+
+        const long lo1 = std::max(-G, -(long) o[0]);
+        const long hi1 = std::min((long) (mB[0] + G),
+                                  (long) (mN[0] - o[0]));
+
+        for (long l3 = -G; l3 < (long) mB[2] + G; ++l3){
+            const long g3 = (long) o[2] + l3;
+            if (g3 < 0 || g3 >= (long) mN[2]){ continue; }
+
+            for (long l2 = -G; l2 < (long) mB[1] + G; ++l2){
+                const long g2 = (long) o[1] + l2;
+                if (g2 < 0 || g2 >= (long) mN[1]){ continue; }
+
+                const size_t p2 = owner(1, g2),
+                             p3 = owner(2, g3);
+
+                /* Segments of the row owned by consecutive bricks. */
+                for (long l1 = lo1; l1 < hi1; ){
+                    const size_t g1  = o[0] + l1;
+                    const size_t p1  = owner(0, g1);
+                    const size_t s   = mSlot[p1 + mNb[0] * (p2 + mNb[1] * p3)];
+                    const size_t end = (p1 == mNb[0] - 1) ? mN[0]
+                                                          : (p1 + 1) * mB[0];
+                    const long   len = std::min(hi1, (long) (end - o[0])) - l1;
+
+                    if (s != (size_t) b){
+                        size_t so[3];
+                        origin(s, so);
+
+                        const double * src = brick(s)
+                                           + local((long) (g1 - so[0]),
+                                                   g2 - (long) so[1],
+                                                   g3 - (long) so[2]) * C;
+
+                        std::copy(src, src + len * C,
+                                  brick(b) + local(l1, l2, l3) * C);
+                    }
+
+                    l1 += len;
+                }
+            }
+        }
+    }
+}
+
+} /* namespace GridDiff */
@@ -0,0 +1,209 @@
+/*
+ * File: bricked_field.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing BrickedField class, a container storing fields
+ * of FieldEngine grid in small dense 3D bricks with ghost layers, ordered
+ * along a Morton curve. For further information please see field_engine.h
+ * header file.
+ */
+
+#ifndef GRIDDIFF_BRICKED_FIELD_H
+#define GRIDDIFF_BRICKED_FIELD_H
+
+#include "field_engine.h"  /* FieldEngine */
+
+#include <vector>          /* std::vector */
+
+namespace GridDiff
+{
+
+/*
+ * BrickedField class
+ *
+ * In the default layout (see qobj.h header file) stencil nodes along q3
+ * axis are n1*n2 values apart, so every one of them lies on a different
+ * memory page for large grids. In the bricked layout the grid is divided
+ * into bricks of brick^3 nodes (fewer along axes shorter than brick).
+ * Every brick is stored contiguously, padded with ghost layers of
+ * ghost() nodes on every side, which hold copies of neighbouring nodes;
+ * within a brick the layout is the default one with padded extents. Any
+ * stencil of a node of a brick lies entirely within its padded box, so
+ * neighbours are accessed with constant offsets (without any boundary
+ * checks), and a whole stencil spans at most a few pages.
+ *
+ * Bricks start at multiples of brick along every axis, except the last one
+ * along an axis, which is shifted back so that it ends at the last grid
+ * node (it overlaps its predecessor if the grid size is not a multiple of
+ * brick). Stencils shifted inwards at grid boundaries then also stay
+ * within padded boxes. Every node is owned by a single brick (the last one
+ * owns only nodes not covered by its predecessor).
+ *
+ * Bricks are stored in Morton (Z-curve) order of their positions, so
+ * neighbouring bricks are close in memory as well.
+ *
+ * All components of a node are stored consecutively (as in Field3D).
+ *
+ * Evaluation writes only nodes of bricks, so ghost layers of a field
+ * updated in bricked layout have to be refreshed with exchangeGhosts()
+ * before it is used as input again.
+ */
+class BrickedField
+{
+    protected:
+        /* Number of grid points along every axis. */
+        size_t               mN[3];
+        /* Brick extents along every axis. */
+        size_t               mB[3];
+        /* Number of bricks along every axis. */
+        size_t               mNb[3];
+        /* Padded brick extents along every axis. */
+        size_t               mP[3];
+        /* Ghost layer width. */
+        size_t               mGhost;
+        /* Number of values per grid node. */
+        unsigned             mComponents;
+        /* Number of values of a padded brick. */
+        size_t               mBrickValues;
+        /* Positions (brick indices along every axis) of bricks in storage
+         * order. */
+        std::vector<size_t>  mPos;
+        /* Storage index of brick at position (b1,b2,b3), found at
+         * b1 + nb1*(b2 + nb2*b3). */
+        std::vector<size_t>  mSlot;
+        /* Values of all bricks. */
+        std::vector<double>  mData;
+
+        /*
+         * owner()
+         *
+         * Returns position of the brick owning node i along given axis.
+         */
+        size_t owner (const unsigned & axis, const size_t & i) const;
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Constructor
+         *
+         * Creates a zero field with ghost layers wide enough for stencils
+         * of engine plans (width/2 nodes).
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const FieldEngine & engine
+         *     Engine whose grid and plans are used.
+         *
+         * const unsigned & components
+         *     Number of values per grid node.
+         *
+         * const unsigned & brick
+         *     Brick extent.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * components is zero
+         *     * brick is lower than stencil width of any axis
+         */
+        BrickedField (const FieldEngine &     engine,
+                      const unsigned    & components = 1,
+                      const unsigned    &      brick = 8);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /* Number of grid points along given axis. */
+        size_t n (const unsigned & axis) const { return mN[axis]; }
+
+        /* Brick extent and padded brick extent along given axis. */
+        size_t brickExtent  (const unsigned & axis) const { return mB[axis]; }
+        size_t paddedExtent (const unsigned & axis) const { return mP[axis]; }
+
+        /* Ghost layer width. */
+        size_t ghost () const { return mGhost; }
+
+        /* Number of values per grid node. */
+        unsigned components () const { return mComponents; }
+
+        /* Number of bricks. */
+        size_t bricks () const { return mPos.size() / 3; }
+
+        /* Number of values stored (including ghost layers). */
+        size_t storageSize () const { return mData.size(); }
+
+        /*
+         * origin()
+         *
+         * Indices (along q1, q2 and q3 axes) of the first node of bth brick
+         * in storage order.
+         */
+        void origin (const size_t & b, size_t * o) const;
+
+        /*
+         * brick()
+         *
+         * Returns pointer to values of bth brick (in storage order). Value
+         * of component c of node with local indices (l1,l2,l3) (ghost
+         * layers have negative local indices or ones not lower than brick
+         * extent) is found at
+         *
+         *     brick(b)[local(l1,l2,l3) * components() + c]
+         */
+        double       * brick (const size_t & b)
+        {
+            return &mData[b * mBrickValues];
+        }
+        const double * brick (const size_t & b) const
+        {
+            return &mData[b * mBrickValues];
+        }
+
+        /* Position of node with local indices (l1,l2,l3) within a padded
+         * brick. */
+        size_t local (const long & l1, const long & l2, const long & l3) const
+        {
+            return (size_t) (l1 + (long) mGhost)
+                 + mP[0] * ( (size_t) (l2 + (long) mGhost)
+                           + mP[1] * (size_t) (l3 + (long) mGhost) );
+        }
+
+        /*
+         * fromRowMajor()
+         *
+         * Sets all nodes (including ghost layers) from a field stored in
+         * the default layout (components()*size() values, all components
+         * of a node stored consecutively). Ghost nodes outside the grid
+         * are set to zero. Bricks are processed in parallel.
+         */
+        void fromRowMajor (const double * f);
+
+        /*
+         * toRowMajor()
+         *
+         * Copies nodes of the field to the default layout (see
+         * fromRowMajor()). Bricks are processed in parallel.
+         */
+        void toRowMajor (double * f) const;
+
+        /*
+         * exchangeGhosts()
+         *
+         * Copies every node not owned by a brick (ghost nodes and nodes of
+         * the overlapping part of the last brick along an axis) from its
+         * owner.
+         */
+        void exchangeGhosts ();
+
+}; /* class BrickedField */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_BRICKED_FIELD_H */
@@ -0,0 +1,419 @@
+/*
+ * File: compact_engine.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing CompactAxis and CompactEngine classes methods
+ * implementation (declared in compact_engine.h header file).
+ */
+
+#include "compact_engine.h"
+#include "util.h"     /* IsIncreasing */
+
+#include <algorithm>  /* std::min, std::swap */
+#include <cmath>      /* fabs */
+#include <stdexcept>  /* std::invalid_argument */
+
+namespace GridDiff
+{
+
+namespace
+{
+
+/* Number of q1 lines solved together (transposed into a buffer). */
+const size_t Q1_BLOCK = 16;
+
+/*
+ * Solves dense n x n system A x = b (A stored row by row) by Gaussian
+ * elimination with partial pivoting. Solution overwrites b. Returns false
+ * if the system is singular.
+ */
+bool SolveDense (std::vector<double> & A,
+                 std::vector<double> & b,
+                 const size_t        & n)
+{
+    for (size_t c = 0; c < n; ++c){
+        size_t p = c;
+
+        for (size_t r = c + 1; r < n; ++r){
+            if (fabs(A[r*n + c]) > fabs(A[p*n + c])){ p = r; }
+        }
+        if (A[p*n + c] == 0.0){
+            return false;
+        }
+
+        if (p != c){
+            for (size_t j = 0; j < n; ++j){
+                std::swap(A[p*n + j], A[c*n + j]);
+            }
+            std::swap(b[p], b[c]);
+        }
+
+        for (size_t r = c + 1; r < n; ++r){
+            const double f = A[r*n + c] / A[c*n + c];
+
+            for (size_t j = c; j < n; ++j){
+                A[r*n + j] -= f * A[c*n + j];
+            }
+            b[r] -= f * b[c];
+        }
+    }
+
+    for (size_t c = n; c-- > 0; ){
+        double s = b[c];
+
+        for (size_t j = c + 1; j < n; ++j){
+            s -= A[c*n + j] * b[j];
+        }
+        b[c] = s / A[c*n + c];
+    }
+
+    return true;
+}
+
+/*
+ * Returns kth derivative of t^p at t.
+ */
+double MonomialDeriv (const unsigned & p, const unsigned & k, const double & t)
+{
+    if (p < k){
+        return 0.0;
+    }
+
+    double c = 1.0;
+
+    for (unsigned j = 0; j < k; ++j){
+        c *= p - j;
+    }
+    for (unsigned j = k; j < p; ++j){
+        c *= t;
+    }
+    return c;
+}
+
+} /* anonymous namespace */
+
+
+CompactAxis::CompactAxis () : mSize(0), mSpan(0) { }
+
+
+CompactAxis::CompactAxis (const QGrid    & coords,
+                          const unsigned &  order,
+                          const unsigned &  width)
+{
+    /* If one of arguments is invalid, throw exception. */
+    if (order != 1 && order != 2){
+        throw std::invalid_argument("compact scheme order not 1 or 2");
+    }
+    if (width != 3 && width != 5){
+        throw std::invalid_argument("compact scheme width not 3 or 5");
+    }
+    if (coords.size() <= width){
+        throw std::invalid_argument("grid size <= compact scheme width");
+    }
+    if (!IsIncreasing(coords)){
+        throw std::invalid_argument("grid not strictly increasing");
+    }
+
+    /* Setting members. */
+    const size_t n = coords.size();
+
+    mSize = n;
+    mSpan = width + 1;
+
+    mStarts  .resize(n);
+    mWeights .assign(n * mSpan, 0.0);
+    mLower   .assign(n, 0.0);
+    mUpper   .assign(n, 0.0);
+    mInvPivot.resize(n);
+    mUpperMod.resize(n);
+
+    /* Coefficients of every node. Unknowns are right hand side weights
+     * followed by left hand side coefficients of neighbours; equations
+     * require exactness for t^p, p = 0, 1, ..., in coordinates t scaled by
+     * mean spacing of right hand side nodes (for conditioning). */
+    for (size_t i = 0; i < n; ++i){
+        const unsigned nb   = (i > 0) + (i + 1 < n);
+        const unsigned cnt  = (nb == 2) ? width : width + 1;
+        const unsigned N    = cnt + nb;
+        long           s    = (long) i - (long) (cnt - 1) / 2;
+
+        if (s < 0)                    { s = 0; }
+        if (s > (long) (n - cnt))     { s = (long) (n - cnt); }
+
+        const double   h    = (coords[s + cnt - 1] - coords[s]) / (cnt - 1);
+        size_t         nbrs[2];
+        unsigned       k    = 0;
+
+        if (i > 0)    { nbrs[k++] = i - 1; }
+        if (i + 1 < n){ nbrs[k++] = i + 1; }
+
+        std::vector<double> A(N * N), b(N, 0.0);
+
+        for (unsigned p = 0; p < N; ++p){
+            for (unsigned j = 0; j < cnt; ++j){
+                const double t = (coords[s + j] - coords[i]) / h;
+                A[p*N + j] = MonomialDeriv(p, 0, t);
+            }
+            for (unsigned q = 0; q < nb; ++q){
+                const double t = (coords[nbrs[q]] - coords[i]) / h;
+                A[p*N + cnt + q] = -MonomialDeriv(p, order, t);
+            }
+            b[p] = MonomialDeriv(p, order, 0.0);
+        }
+
+        if (!SolveDense(A, b, N)){
+            throw std::invalid_argument("singular compact scheme");
+        }
+
+        /* Weights are stored at their position within a window of mSpan
+         * nodes, which has to fit within the grid. */
+        const double scale = (order == 1) ? 1.0 / h : 1.0 / (h * h);
+        const size_t first = std::min((size_t) s, n - mSpan);
+
+        mStarts[i] = first;
+
+        for (unsigned j = 0; j < cnt; ++j){
+            mWeights[i * mSpan + (s - first) + j] = b[j] * scale;
+        }
+        for (unsigned q = 0; q < nb; ++q){
+            if (nbrs[q] < i){ mLower[i] = b[cnt + q]; }
+            else            { mUpper[i] = b[cnt + q]; }
+        }
+    }
+
+    /* Factorization. */
+    mInvPivot[0] = 1.0;
+    mUpperMod[0] = mUpper[0];
+
+    for (size_t i = 1; i < n; ++i){
+        const double pivot = 1.0 - mLower[i] * mUpperMod[i-1];
+
+        if (pivot == 0.0){
+            throw std::invalid_argument("singular compact scheme");
+        }
+
+        mInvPivot[i] = 1.0 / pivot;
+        mUpperMod[i] = mUpper[i] * mInvPivot[i];
+    }
+}
+
+
+void CompactAxis::solve (double          *      b,
+                         const size_t    & stride,
+                         const size_t    &  count) const
+{
+    /* Forward elimination. */
+    for (size_t i = 1; i < mSize; ++i){
+        const double   l   = mLower[i];
+        const double   inv = mInvPivot[i];
+        const double * bp  = b + (i - 1) * stride;
+        double       * bi  = b + i * stride;
+
+        for (size_t j = 0; j < count; ++j){
+            bi[j] = (bi[j] - l * bp[j]) * inv;
+        }
+    }
+
+    /* Back substitution. */
+    for (size_t i = mSize - 1; i-- > 0; ){
+        const double   u  = mUpperMod[i];
+        const double * bn = b + (i + 1) * stride;
+        double       * bi = b + i * stride;
+
+        for (size_t j = 0; j < count; ++j){
+            bi[j] -= u * bn[j];
+        }
+    }
+}
+
+
+CompactEngine::CompactEngine (const QGrid    & q1Coords,
+                              const QGrid    & q2Coords,
+                              const QGrid    & q3Coords,
+                              const unsigned &    width)
+
+                            : mQ1Coords (q1Coords),
+                              mQ2Coords (q2Coords),
+                              mQ3Coords (q3Coords)
+{
+    const QGrid * q[3] = { &mQ1Coords, &mQ2Coords, &mQ3Coords };
+
+    for (unsigned axis = 0; axis < 3; ++axis){
+        for (unsigned order = 1; order <= 2; ++order){
+            mAxes[2*axis + order - 1] = CompactAxis(*q[axis], order, width);
+        }
+    }
+}
+
+
+void CompactEngine::derivative (const unsigned &  axis,
+                                const unsigned & order,
+                                const double   *     f,
+                                double         *   out) const
+{
+    /* If arguments invalid, throw exception. */
+    if (axis > AXIS_Q3 || order < 1 || order > 2){
+        throw std::invalid_argument("invalid compact derivative");
+    }
+    if (f == out){
+        throw std::invalid_argument("input and output fields are the same");
+    }
+
+    const CompactAxis & s     = scheme(axis, order);
+    const unsigned      w     = s.span();
+    const size_t        N1    = n1(),
+                        N2    = n2(),
+                        N3    = n3();
+    const size_t        plane = N1 * N2;
+
+    if (axis == AXIS_Q1){
+        /* Blocks of rows are transposed, so lines are interleaved. */
+        const long rows   = (long) (N2 * N3);
+        const long blocks = (rows + (long) Q1_BLOCK - 1) / (long) Q1_BLOCK;
+
+        #pragma omp parallel
+        {
+            std::vector<double> buf(N1 * Q1_BLOCK);
+
+            #pragma omp for schedule(static)
+            for (long bl = 0; bl < blocks; ++bl){
+                const size_t r0  = (size_t) bl * Q1_BLOCK;
+                const size_t cnt = std::min(Q1_BLOCK, (size_t) rows - r0);
+
+                for (size_t i = 0; i < N1; ++i){
+                    const double * c  = s.weights(i);
+                    const size_t   st = s.start(i);
+
+                    for (size_t r = 0; r < cnt; ++r){
+                        const double * v = f + (r0 + r) * N1 + st;
+                        double         a = 0.0;
+
+                        for (unsigned j = 0; j < w; ++j){
+                            a += c[j] * v[j];
+                        }
+                        buf[i * Q1_BLOCK + r] = a;
+                    }
+                }
+
+                s.solve(&buf[0], Q1_BLOCK, cnt);
+
+                for (size_t r = 0; r < cnt; ++r){
+                    double * o = out + (r0 + r) * N1;
+
+                    for (size_t i = 0; i < N1; ++i){
+                        o[i] = buf[i * Q1_BLOCK + r];
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    /* Along q2 (within every plane) and q3 (within every q1-q3 slice)
+     * lines of a row are contiguous. */
+    const size_t step  = (axis == AXIS_Q2) ? N1    : plane;
+    const size_t n     = (axis == AXIS_Q2) ? N2    : N3;
+    const long   lines = (axis == AXIS_Q2) ? (long) N3 : (long) N2;
+    const size_t jump  = (axis == AXIS_Q2) ? plane : N1;
+
+    #pragma omp parallel for schedule(static)
+    for (long l = 0; l < lines; ++l){
+        const double * fl = f   + (size_t) l * jump;
+        double       * ol = out + (size_t) l * jump;
+
+        for (size_t i = 0; i < n; ++i){
+            const double * c = s.weights(i);
+            const double * v = fl + s.start(i) * step;
+            double       * o = ol + i * step;
+
+            for (size_t j = 0; j < N1; ++j){
+                o[j] = c[0] * v[j];
+            }
+            for (unsigned b = 1; b < w; ++b){
+                const double * vb = v + b * step;
+
+                for (size_t j = 0; j < N1; ++j){
+                    o[j] += c[b] * vb[j];
+                }
+            }
+        }
+
+        s.solve(ol, step, N1);
+    }
+}
+
+
+void CompactEngine::apply (const FieldOperator & op,
+                           const double        *  f,
+                           double              * out) const
+{
+    /* If arguments invalid, throw exception. */
+    if (op.maxOrder() > 2){
+        throw std::invalid_argument("operator order higher than 2");
+    }
+
+    if (!op.fits(n1(), n2(), n3())){
+        throw std::invalid_argument("operator does not fit grid");
+    }
+
+    const unsigned m     = op.maxOrder();
+    const unsigned ncomp = op.components();
+    const size_t   N1    = n1(),
+                   N2    = n2(),
+                   N3    = n3();
+
+    /* Whole-field derivatives used by the operator. */
+    std::vector< std::vector<double> > derivs(3 * (m + 1));
+
+    for (unsigned axis = 0; axis < 3; ++axis){
+        for (unsigned k = 1; k <= m; ++k){
+            if (op.uses(axis, k)){
+                derivs[axis*(m+1) + k].resize(size());
+                derivative(axis, k, f, &derivs[axis*(m+1) + k][0]);
+            }
+        }
+    }
+
+    const long rows = (long) (N2 * N3);
+
+    #pragma omp parallel
+    {
+        std::vector<const double *> d(3 * (m + 1), (const double *) NULL);
+        std::vector<double *>       o(ncomp, (double *) NULL);
+        RowContext                  row;
+
+        #pragma omp for schedule(static)
+        for (long r = 0; r < rows; ++r){
+            const size_t i2   = (size_t) r % N2;
+            const size_t i3   = (size_t) r / N2;
+            const size_t node = QFieldIndex(0, i2, i3, N1, N2);
+
+            for (unsigned axis = 0; axis < 3; ++axis){
+                d[axis*(m+1)] = f + node;
+
+                for (unsigned k = 1; k <= m; ++k){
+                    const std::vector<double> & v = derivs[axis*(m+1) + k];
+                    d[axis*(m+1) + k] = v.empty() ? NULL : &v[node];
+                }
+            }
+
+            row.i1     = 0;
+            row.i2     = i2;
+            row.i3     = i3;
+            row.length = N1;
+            row.node   = node;
+            row.q1     = &mQ1Coords[0];
+            row.q2     = mQ2Coords[i2];
+            row.q3     = mQ3Coords[i3];
+
+            for (unsigned c = 0; c < ncomp; ++c){
+                o[c] = out + node * ncomp + c;
+            }
+
+            op.combineRow(row, &d[0], &o[0], (ptrdiff_t) ncomp);
+        }
+    }
+}
+
+} /* namespace GridDiff */
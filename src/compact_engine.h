@@ -0,0 +1,276 @@
+/*
+ * File: compact_engine.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing CompactAxis and CompactEngine classes used for
+ * evaluating differential operators (described by FieldOperator child
+ * classes) with compact (Pade) finite difference schemes instead of the
+ * explicit stencils used by FieldEngine class.
+ */
+
+#ifndef GRIDDIFF_COMPACT_ENGINE_H
+#define GRIDDIFF_COMPACT_ENGINE_H
+
+#include "qobj.h"            /* QGrid, QFieldIndex */
+#include "field_operator.h"  /* FieldOperator */
+
+#include <vector>            /* std::vector */
+
+namespace GridDiff
+{
+
+/*
+ * CompactAxis class
+ *
+ * Compact scheme for kth derivative (k = 1 or 2) along one grid axis.
+ * Derivatives d at all nodes are coupled by a tridiagonal system
+ *
+ *     lower(i) d(i-1) + d(i) + upper(i) d(i+1)
+ *         = sum over j < span() of weights(i)[j] * f(start(i) + j)
+ *
+ * The right hand side uses width nodes centered at i (width+1 nodes at the
+ * first and the last node, which have a single neighbour). For every node
+ * all coefficients are found by requiring the scheme to be exact for
+ * polynomials of the highest possible degree (width+1 for interior nodes),
+ * so grid points can be arbitrarily spaced. On uniform grids classic Pade
+ * schemes are recovered, e.g. for width 3
+ *
+ *     d'(i-1)/4  + d'(i)  + d'(i+1)/4  = 3/4 (f(i+1) - f(i-1)) / h
+ *     d''(i-1)/10 + d''(i) + d''(i+1)/10 = 6/5 (f(i+1) - 2f(i) + f(i-1)) / h^2
+ *
+ * which are 4th order accurate with 3-point right hand sides (explicit
+ * stencils of the same order need 5 points). Width 5 gives 6th order.
+ *
+ * The system is factorized once (Thomas algorithm without pivoting).
+ */
+class CompactAxis
+{
+    protected:
+        /* Number of grid nodes. */
+        size_t                mSize;
+        /* Number of right hand side weights per node. */
+        unsigned              mSpan;
+        /* First right hand side node for every grid node. */
+        std::vector<size_t>   mStarts;
+        /* Right hand side weights; mSpan values for every node (unused
+         * ones set to zero). */
+        std::vector<double>   mWeights;
+        /* Left hand side coefficients. */
+        std::vector<double>   mLower,
+                              mUpper;
+        /* Factorization: inverse pivots and modified upper coefficients. */
+        std::vector<double>   mInvPivot,
+                              mUpperMod;
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Default constructor
+         *
+         * Creates an empty scheme (of zero size).
+         */
+        CompactAxis ();
+
+        /*
+         * Constructor
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const QGrid & coords
+         *     Grid point positions along axis. Have to be strictly
+         *     increasing.
+         *
+         * const unsigned & order
+         *     Derivative order (1 or 2).
+         *
+         * const unsigned & width
+         *     Number of right hand side nodes of interior nodes (3 or 5).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * order is not 1 or 2
+         *     * width is not 3 or 5
+         *     * coords is of size <= width
+         *     * coords is not strictly increasing
+         */
+        CompactAxis (const QGrid    & coords,
+                     const unsigned &  order,
+                     const unsigned &  width);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /* Number of grid nodes. */
+        size_t size () const { return mSize; }
+
+        /* Number of right hand side weights per node. */
+        unsigned span () const { return mSpan; }
+
+        /* First right hand side node of ith node. */
+        size_t start (const size_t & i) const { return mStarts[i]; }
+
+        /* Right hand side weights of ith node. */
+        const double * weights (const size_t & i) const
+        {
+            return &mWeights[i * mSpan];
+        }
+
+        /* Left hand side coefficients of ith node. */
+        double lower (const size_t & i) const { return mLower[i]; }
+        double upper (const size_t & i) const { return mUpper[i]; }
+
+        /*
+         * solve()
+         *
+         * Solves the system for count lines at once, in place. Right hand
+         * side of line j at node i is b[i*stride + j] (lines are
+         * interleaved, so the innermost loop runs over contiguous values
+         * and vectorizes).
+         */
+        void solve (double          *      b,
+                    const size_t    & stride,
+                    const size_t    &  count) const;
+
+}; /* class CompactAxis */
+
+
+/*
+ * CompactEngine class
+ *
+ * Evaluates operators at every node of a tensor grid, like FieldEngine
+ * class, but with partial derivatives of orders 1 and 2 given by compact
+ * schemes (see CompactAxis class). Since every derivative depends on the
+ * whole grid line, derivatives used by an operator are evaluated for the
+ * whole field first (one field per derivative), and combined by
+ * FieldOperator::combineRow() afterwards. Every existing operator (e.g.
+ * CartesianGradientFieldOp or CartesianLaplacianFieldOp) can then be
+ * evaluated with either engine.
+ *
+ * Line solves are batched:
+ *     * along q2 and q3 axes, lines of a whole row (all i1) are solved
+ *       together, interleaved as they are stored;
+ *     * along q1 axis, blocks of rows are transposed into a buffer, so
+ *       lines of a block are interleaved, and solved together.
+ * Lines (or blocks) are distributed between threads.
+ */
+class CompactEngine
+{
+    protected:
+        /* Grid point coordinates at qi axis (i=1,2,3). */
+        QGrid             mQ1Coords,
+                          mQ2Coords,
+                          mQ3Coords;
+        /* Schemes of first and second derivatives (2*axis + order-1). */
+        CompactAxis       mAxes[6];
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Constructor
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const QGrid & q1Coords
+         * const QGrid & q2Coords
+         * const QGrid & q3Coords
+         *     Grid point positions along axes q1, q2 and q3. For each axis
+         *     those positions have to be strictly increasing.
+         *
+         * const unsigned & width
+         *     Number of right hand side nodes of interior nodes (3 or 5).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if arguments are invalid (see CompactAxis
+         * constructor).
+         */
+        CompactEngine (const QGrid    & q1Coords,
+                       const QGrid    & q2Coords,
+                       const QGrid    & q3Coords,
+                       const unsigned &    width = 3);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /* Number of grid points along q1, q2 and q3 axes. */
+        size_t n1 () const { return mQ1Coords.size(); }
+        size_t n2 () const { return mQ2Coords.size(); }
+        size_t n3 () const { return mQ3Coords.size(); }
+
+        /* Total number of grid points. */
+        size_t size () const { return n1() * n2() * n3(); }
+
+        /* Scheme of given axis (AXIS_Q1, AXIS_Q2 or AXIS_Q3) and order (1
+         * or 2). */
+        const CompactAxis & scheme (const unsigned &  axis,
+                                    const unsigned & order) const
+        {
+            return mAxes[2*axis + order - 1];
+        }
+
+        /*
+         * derivative()
+         *
+         * Evaluates kth partial derivative along given axis at every grid
+         * node.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const unsigned & axis
+         *     Axis (AXIS_Q1, AXIS_Q2 or AXIS_Q3).
+         *
+         * const unsigned & order
+         *     Derivative order (1 or 2).
+         *
+         * const double * f
+         *     Function values at grid nodes (size() values).
+         *
+         * double * out
+         *     Array receiving size() values. Cannot be the same as f.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if axis or order is invalid, or f and out
+         * are the same.
+         */
+        void derivative (const unsigned &  axis,
+                         const unsigned & order,
+                         const double   *     f,
+                         double         *   out) const;
+
+        /*
+         * apply()
+         *
+         * Evaluates operator at every grid node (see FieldEngine::apply()).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if operator order is higher than 2, or operator
+         * does not fit the grid (see FieldOperator::fits()).
+         */
+        void apply (const FieldOperator & op,
+                    const double        *  f,
+                    double              * out) const;
+
+}; /* class CompactEngine */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_COMPACT_ENGINE_H */
@@ -0,0 +1,167 @@
+/*
+ * File: field3d.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing Field3D class methods and PinWorkerThreads
+ * function implementation (declared in field3d.h header file).
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE           /* CPU_SET, pthread_setaffinity_np */
+#endif
+
+#include "field3d.h"
+
+#include <cstring>            /* memset */
+#include <new>                /* std::bad_alloc */
+#include <stdexcept>          /* std::invalid_argument */
+#include <vector>             /* std::vector */
+
+#include <stdlib.h>           /* posix_memalign, free */
+#include <unistd.h>           /* sysconf */
+#include <sys/mman.h>         /* madvise */
+
+#ifdef __linux__
+#include <pthread.h>          /* pthread_setaffinity_np */
+#include <sched.h>            /* sched_getaffinity */
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>              /* omp_get_thread_num, omp_get_num_threads */
+#endif
+
+namespace GridDiff
+{
+
+namespace
+{
+
+/* Alignment of field memory. */
+const size_t CACHE_LINE_SIZE = 64;
+const size_t HUGE_PAGE_SIZE  = 2 * 1024 * 1024;
+
+} /* anonymous namespace */
+
+
+Field3D::Field3D (const FieldEngine    &     engine,
+                  const unsigned       & components,
+                  const FieldPlacement &  placement,
+                  const bool           &  hugePages)
+{
+    /* Initializing members (in case of exception occurrence). */
+    pData       = NULL;
+    mSize       = 0;
+    mComponents = 0;
+
+    /* If one of arguments is invalid, throw exception. */
+    if (components == 0){
+        throw std::invalid_argument("zero field components");
+    }
+
+    const size_t bytes = engine.size() * components * sizeof(double);
+    const size_t align = hugePages ? HUGE_PAGE_SIZE : CACHE_LINE_SIZE;
+    void       * mem   = NULL;
+
+    /* Allocating memory. Pages are not touched yet (for large
+     * allocations), so they are not placed on any NUMA node. */
+    if (posix_memalign(&mem, align, bytes ? bytes : align) != 0){
+        throw std::bad_alloc();
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (hugePages){
+        madvise(mem, bytes, MADV_HUGEPAGE);
+    }
+#endif
+
+    pData       = static_cast<double *>(mem);
+    mSize       = engine.size() * components;
+    mComponents = components;
+
+    /* Touching pages according to placement policy. */
+    if (placement == FIELD_PLACEMENT_LOCAL){
+        engine.firstTouch(pData, components);
+    }
+    else if (placement == FIELD_PLACEMENT_INTERLEAVED){
+        const size_t page   = hugePages ? HUGE_PAGE_SIZE
+                                        : (size_t) sysconf(_SC_PAGESIZE);
+        const long   npages = (long) ((bytes + page - 1) / page);
+        char       * base   = static_cast<char *>(mem);
+
+        #pragma omp parallel num_threads(engine.threadCount())
+        {
+            long tid = 0, nth = 1;
+#ifdef _OPENMP
+            tid = omp_get_thread_num();
+            nth = omp_get_num_threads();
+#endif
+            for (long p = tid; p < npages; p += nth){
+                const size_t lo = p * page;
+                const size_t hi = (lo + page < bytes) ? lo + page : bytes;
+
+                std::memset(base + lo, 0, hi - lo);
+            }
+        }
+    }
+    else {
+        std::memset(mem, 0, bytes);
+    }
+}
+
+
+Field3D::~Field3D ()
+{
+    /* Free memory only if pointer isn't NULL. */
+    if (pData != NULL) { free(pData); }
+}
+
+
+bool PinWorkerThreads (const FieldEngine & engine)
+{
+#ifdef __linux__
+    /* CPUs available to the process. */
+    cpu_set_t        available;
+    std::vector<int> cpus;
+
+    if (sched_getaffinity(0, sizeof(available), &available) != 0){
+        return false;
+    }
+
+    for (int c = 0; c < CPU_SETSIZE; ++c){
+        if (CPU_ISSET(c, &available)){
+            cpus.push_back(c);
+        }
+    }
+
+    if (cpus.empty()){
+        return false;
+    }
+
+    bool pinned = true;
+
+    #pragma omp parallel num_threads(engine.threadCount())
+    {
+        int tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        cpu_set_t set;
+
+        CPU_ZERO(&set);
+        CPU_SET(cpus[tid % cpus.size()], &set);
+
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0){
+            #pragma omp critical
+            pinned = false;
+        }
+    }
+
+    return pinned;
+#else
+    (void) engine;
+    return false;
+#endif
+}
+
+} /* namespace GridDiff */
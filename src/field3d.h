@@ -0,0 +1,155 @@
+/*
+ * File: field3d.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing Field3D class, an aligned container for fields
+ * evaluated with FieldEngine class, with NUMA-aware page placement. It
+ * also provides PinWorkerThreads function binding evaluation threads to
+ * CPUs. For further information please see field_engine.h header file.
+ */
+
+#ifndef GRIDDIFF_FIELD3D_H
+#define GRIDDIFF_FIELD3D_H
+
+#include "field_engine.h"  /* FieldEngine */
+
+namespace GridDiff
+{
+
+/*
+ * Page placement policies used by Field3D class. Linux places every memory
+ * page on the NUMA node of the thread which touches it first.
+ *
+ *     FIELD_PLACEMENT_LOCAL        pages of every tile are touched by the
+ *                                  thread which evaluates it in
+ *                                  FieldEngine::apply()
+ *     FIELD_PLACEMENT_INTERLEAVED  pages are touched by all threads in
+ *                                  round-robin order
+ *     FIELD_PLACEMENT_NAIVE        all pages are touched by the calling
+ *                                  thread
+ */
+enum FieldPlacement
+{
+    FIELD_PLACEMENT_LOCAL,
+    FIELD_PLACEMENT_INTERLEAVED,
+    FIELD_PLACEMENT_NAIVE
+};
+
+/*
+ * Field3D class
+ *
+ * Holds components*size() values of a field defined at nodes of
+ * FieldEngine grid (all components of a node stored consecutively).
+ * Memory is aligned to cache line size (or to huge page size, if
+ * transparent huge pages are requested) and initialized to zero according
+ * to a chosen page placement policy. Placement matches tile distribution
+ * of the engine configuration at construction time; the same number of
+ * threads should be used for evaluation.
+ *
+ * Copying is not allowed, since it would not preserve placement.
+ */
+class Field3D
+{
+    protected:
+        /* Field values. */
+        double   * pData;
+        /* Number of values. */
+        size_t     mSize;
+        /* Number of values per grid node. */
+        unsigned   mComponents;
+
+    private:
+        Field3D (const Field3D & other);
+        Field3D & operator= (const Field3D & other);
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Constructor
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const FieldEngine & engine
+         *     Engine whose grid and tile distribution is used.
+         *
+         * const unsigned & components
+         *     Number of values per grid node.
+         *
+         * const FieldPlacement & placement
+         *     Page placement policy.
+         *
+         * const bool & hugePages
+         *     If true, memory is aligned to 2 MiB and transparent huge pages
+         *     are requested for it (if supported by the system).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if components is zero.
+         * std::bad_alloc if memory cannot be allocated.
+         */
+        Field3D (const FieldEngine    &     engine,
+                 const unsigned       & components = 1,
+                 const FieldPlacement &  placement = FIELD_PLACEMENT_LOCAL,
+                 const bool           &  hugePages = false);
+
+        /*
+         * Destructor
+         */
+        ~Field3D ();
+
+        /*************
+         * OPERATORS *
+         ************/
+
+        double       & operator[] (const size_t & i)       { return pData[i]; }
+        const double & operator[] (const size_t & i) const { return pData[i]; }
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /* Pointer to field values. */
+        double       * data ()       { return pData; }
+        const double * data () const { return pData; }
+
+        /* Number of values. */
+        size_t size () const { return mSize; }
+
+        /* Number of values per grid node. */
+        unsigned components () const { return mComponents; }
+
+}; /* class Field3D */
+
+
+/*
+ * PinWorkerThreads()
+ *
+ * Binds every thread of engine thread team to a single CPU (threads are
+ * assigned to CPUs available to the process in order). GNU OpenMP runtime
+ * reuses threads between parallel regions of the same size, so binding
+ * stays in effect for subsequent evaluations. Setting OMP_PROC_BIND and
+ * OMP_PLACES environment variables has similar effect.
+ *
+ * -----------
+ *  Arguments
+ * -----------
+ * const FieldEngine & engine
+ *     Engine whose thread count is used.
+ *
+ * ---------
+ *  Returns
+ * ---------
+ * True if all threads were bound. False otherwise (or if not supported by
+ * the system).
+ */
+bool PinWorkerThreads (const FieldEngine & engine);
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_FIELD3D_H */
@@ -0,0 +1,1843 @@
+/*
+ * File: field_engine.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing FieldEngine class methods implementation
+ * (declared in field_engine.h header file).
+ */
+
+#include "field_engine.h"
+#include "bricked_field.h"    /* BrickedField */
+#include "field_graph.h"      /* FieldGraph */
+#include "fornberg_nderivs.h" /* FORNBERG_GENERAL,
+                                 FORNBERG_ANTISYMMETRIC */
+
+#include <algorithm>  /* std::min, std::max, std::copy, std::fill */
+#include <stdexcept>  /* std::invalid_argument */
+#include <vector>     /* std::vector */
+
+#ifdef _OPENMP
+#include <omp.h>      /* omp_get_max_threads */
+#endif
+
+namespace GridDiff
+{
+
+namespace
+{
+
+/*
+ * StepFieldOp class
+ *
+ * Wraps a scalar operator L, evaluating f + alpha * Lf instead.
+ */
+class StepFieldOp : public FieldOperator
+{
+    private:
+        const FieldOperator & mOp;
+        double                mAlpha;
+
+    public:
+        StepFieldOp (const FieldOperator & op, const double & alpha)
+            : mOp(op), mAlpha(alpha) { }
+
+        unsigned maxOrder   () const { return mOp.maxOrder(); }
+        unsigned components () const { return 1; }
+
+        bool uses (const unsigned & axis, const unsigned & order) const
+        {
+            return mOp.uses(axis, order);
+        }
+
+        bool fits (const size_t & n1,
+                   const size_t & n2,
+                   const size_t & n3) const
+        {
+            return mOp.fits(n1, n2, n3);
+        }
+
+        void combineRow (const RowContext     &    row,
+                         const double * const *      d,
+                         double       * const *    out,
+                         const ptrdiff_t      & stride) const
+        {
+            mOp.combineRow(row, d, out, stride);
+
+            for (size_t j = 0; j < row.length; ++j){
+                out[0][j*stride] = d[0][j] + mAlpha * out[0][j*stride];
+            }
+        }
+
+}; /* class StepFieldOp */
+
+
+/*
+ * CheckOperator()
+ *
+ * Throws std::invalid_argument if an operator cannot be evaluated with
+ * given axis plans (order too high, or grid not fitting, see
+ * FieldOperator::fits()).
+ */
+void CheckOperator (const FieldOperator &    op,
+                    const AxisPlan      * plans)
+{
+    if (op.maxOrder() > plans[AXIS_Q1].maxOrder()){
+        throw std::invalid_argument("operator order higher than max");
+    }
+
+    if (!op.fits(plans[AXIS_Q1].size(), plans[AXIS_Q2].size(),
+                 plans[AXIS_Q3].size())){
+        throw std::invalid_argument("operator does not fit grid");
+    }
+}
+
+
+/*
+ * TileLayout struct
+ *
+ * Division of a grid into tiles according to FieldEngineConfig. Tiles are
+ * numbered with q1 tile index varying fastest.
+ */
+struct TileLayout
+{
+    size_t n[3], t[3], nb[3];
+
+    TileLayout (const FieldEngineConfig & config,
+                const size_t & N1, const size_t & N2, const size_t & N3)
+    {
+        const size_t tiles[3] = { config.tile1, config.tile2, config.tile3 };
+
+        n[0] = N1; n[1] = N2; n[2] = N3;
+
+        for (unsigned a = 0; a < 3; ++a){
+            t[a]  = (tiles[a] && tiles[a] < n[a]) ? tiles[a] : n[a];
+            nb[a] = (n[a] + t[a] - 1) / t[a];
+        }
+    }
+
+    /* Total number of tiles. */
+    long count () const { return (long) (nb[0] * nb[1] * nb[2]); }
+
+    /* Node index ranges [lo,hi) of given tile along every axis. */
+    void box (const long & tile, size_t * lo, size_t * hi) const
+    {
+        const size_t b[3] = { (size_t) tile % nb[0],
+                              ((size_t) tile / nb[0]) % nb[1],
+                              (size_t) tile / (nb[0] * nb[1]) };
+
+        for (unsigned a = 0; a < 3; ++a){
+            lo[a] = b[a] * t[a];
+            hi[a] = std::min(lo[a] + t[a], n[a]);
+        }
+    }
+};
+
+
+/* Largest size of rings of intermediate planes kept by a thread during
+ * a wavefront sweep of applySteps() (about the size of a per-core L2
+ * cache). */
+const size_t WAVEFRONT_RING_BYTES = 1 << 20;
+
+
+/*
+ * WavefrontTiles()
+ *
+ * Chooses extents b1 and b2 of q1-q2 tiles of a wavefront sweep. Rings of
+ * a tile (planes planes of (b1+2*h1)*(b2+2*h2) nodes, h1 and h2 being
+ * halo widths) should take at most WAVEFRONT_RING_BYTES and there should
+ * be at least threads tiles. Starting with whole planes, the larger extent
+ * is halved until both conditions hold, but extents are not reduced below
+ * four times their halo widths (so recomputed halo nodes add at most
+ * about 60% to the work of a sweep).
+ */
+void WavefrontTiles (const size_t &      N1,
+                     const size_t &      N2,
+                     const size_t &      h1,
+                     const size_t &      h2,
+                     const size_t &  planes,
+                     const size_t & threads,
+                     size_t       &      b1,
+                     size_t       &      b2)
+{
+    const size_t m1 = std::max<size_t>(4 * h1, 8);
+    const size_t m2 = std::max<size_t>(4 * h2, 8);
+
+    b1 = N1;
+    b2 = N2;
+
+    for (;;){
+        const size_t bytes = planes * std::min(N1, b1 + 2 * h1)
+                                    * std::min(N2, b2 + 2 * h2)
+                                    * sizeof(double);
+        const size_t tiles = ((N1 + b1 - 1) / b1) * ((N2 + b2 - 1) / b2);
+
+        if (bytes <= WAVEFRONT_RING_BYTES && tiles >= threads){
+            return;
+        }
+
+        const bool can1 = b1 / 2 >= m1;
+        const bool can2 = b2 / 2 >= m2;
+
+        if (can2 && (b2 >= b1 || !can1)){
+            b2 = (b2 + 1) / 2;
+        }
+        else if (can1){
+            b1 = (b1 + 1) / 2;
+        }
+        else {
+            return;
+        }
+    }
+}
+
+
+/*
+ * WavefrontDepth()
+ *
+ * Returns the largest number of steps (at most steps) that can be swept
+ * together, i.e. for which rings of tiles chosen by WavefrontTiles() take
+ * at most WAVEFRONT_RING_BYTES (halos grow with the number of steps), or
+ * 1 if there is none. R planes per step are kept in rings.
+ */
+unsigned WavefrontDepth (const AxisPlan &      p1,
+                         const AxisPlan &      p2,
+                         const size_t   &       R,
+                         const size_t   & threads,
+                         const unsigned &   steps)
+{
+    const size_t N1 = p1.size();
+    const size_t N2 = p2.size();
+    const size_t r1 = std::max(p1.reachBelow(), p1.reachAbove());
+    const size_t r2 = std::max(p2.reachBelow(), p2.reachAbove());
+
+    for (unsigned g = steps; g > 1; --g){
+        const size_t h1 = (g - 1) * r1;
+        const size_t h2 = (g - 1) * r2;
+
+        size_t b1, b2;
+        WavefrontTiles(N1, N2, h1, h2, (g - 1) * R, threads, b1, b2);
+
+        const size_t bytes = (g - 1) * R * std::min(N1, b1 + 2 * h1)
+                                         * std::min(N2, b2 + 2 * h2)
+                                         * sizeof(double);
+
+        if (bytes <= WAVEFRONT_RING_BYTES){
+            return g;
+        }
+    }
+    return 1;
+}
+
+
+/*
+ * RowScratch struct
+ *
+ * Per-thread buffers used for evaluating partial derivatives of a row
+ * (including a row of function values converted to doubles, if needed).
+ */
+struct RowScratch
+{
+    std::vector<double>         values;
+    std::vector<const double *> d;
+    std::vector<double *>       out;
+    std::vector<unsigned>       orders;
+    std::vector<double *>       rows;
+    std::vector<double>         acc;
+    std::vector<const void *>   taps;
+    std::vector<unsigned>       kinds;
+
+    RowScratch (const FieldOperator & op, const size_t & length)
+        : values((3 * op.maxOrder() + 1) * length),
+          d     (3 * (op.maxOrder()+1), (const double *) NULL),
+          out   (op.components(), (double *) NULL),
+          orders(op.maxOrder() + 1),
+          rows  (op.maxOrder() + 1, (double *) NULL),
+          acc   (op.maxOrder() + 1),
+          kinds (op.maxOrder() + 1) { }
+};
+
+
+/*
+ * PairedOrders()
+ *
+ * Returns true if coefficients of all nk orders at ith node of an axis
+ * are symmetric or antisymmetric (see AxisPlan::symmetry()), so values of
+ * mirrored stencil nodes can be combined before multiplication. Sets
+ * kinds[q] to 1 for antisymmetric and to 0 for symmetric coefficients of
+ * order orders[q].
+ */
+bool PairedOrders (const AxisPlan &      p,
+                   const size_t   &      i,
+                   const unsigned * orders,
+                   const unsigned &     nk,
+                   unsigned       *  kinds)
+{
+    for (unsigned q = 0; q < nk; ++q){
+        const int sym = p.symmetry(i, orders[q]);
+
+        if (sym == FORNBERG_GENERAL){
+            return false;
+        }
+        kinds[q] = (sym == FORNBERG_ANTISYMMETRIC);
+    }
+    return true;
+}
+
+
+/*
+ * StencilSum()
+ *
+ * Returns sum of c[a] * v[a*e] over w stencil nodes. For symmetric
+ * (antisymmetric) coefficients, values of mirrored nodes are added
+ * (subtracted) first, so only (w+1)/2 products are evaluated.
+ */
+template <class T>
+inline double StencilSum (const double    *        c,
+                          const T         *        v,
+                          const ptrdiff_t &        e,
+                          const unsigned  &        w,
+                          const int       & symmetry)
+{
+    double s = 0.0;
+
+    if (symmetry == FORNBERG_GENERAL){
+        for (unsigned a = 0; a < w; ++a){
+            s += c[a] * v[a*e];
+        }
+    }
+    else if (symmetry == FORNBERG_ANTISYMMETRIC){
+        for (unsigned a = 0; a < w/2; ++a){
+            s += c[a] * ((double) v[a*e] - v[(w-1-a)*e]);
+        }
+    }
+    else {
+        for (unsigned a = 0; a < w/2; ++a){
+            s += c[a] * ((double) v[a*e] + v[(w-1-a)*e]);
+        }
+        if (w % 2 == 1){
+            s += c[w/2] * v[(w/2)*e];
+        }
+    }
+    return s;
+}
+
+
+/*
+ * PairedAxpy()
+ *
+ * Adds c * (u[x*e] + v[x*e]) (or c * (u[x*e] - v[x*e]) if anti is true)
+ * to r[x] for n values, i.e. contribution of two mirrored stencil nodes
+ * sharing their coefficient.
+ */
+template <class T>
+inline void PairedAxpy (double          *    r,
+                        const double    &    c,
+                        const T         *    u,
+                        const T         *    v,
+                        const ptrdiff_t &    e,
+                        const size_t    &    n,
+                        const bool      & anti)
+{
+    if (anti){
+        for (size_t x = 0; x < n; ++x){
+            r[x] += c * ((double) u[x*e] - v[x*e]);
+        }
+    }
+    else {
+        for (size_t x = 0; x < n; ++x){
+            r[x] += c * ((double) u[x*e] + v[x*e]);
+        }
+    }
+}
+
+
+/*
+ * RowLoader struct
+ *
+ * Provides function values of a row as contiguous doubles. Values of
+ * contiguous double fields are used in place; others are converted.
+ */
+template <class T, bool UNIT>
+struct RowLoader
+{
+    static const double * load (const T         *   v,
+                                const ptrdiff_t &   e,
+                                const size_t    & len,
+                                double          * buf)
+    {
+        for (size_t j = 0; j < len; ++j){
+            buf[j] = v[j*e];
+        }
+        return buf;
+    }
+};
+
+template <>
+struct RowLoader<double, true>
+{
+    static const double * load (const double    * v,
+                                const ptrdiff_t &,
+                                const size_t    &,
+                                double          *)
+    {
+        return v;
+    }
+};
+
+
+/*
+ * EvalRowDerivs()
+ *
+ * Evaluates partial derivatives used by an operator for a row of length
+ * nodes starting at (i1,i2,i3) node. Input field is given by pointers to
+ * its q3 planes; within a plane value at (i1,i2) is found at i1*s1 + i2*s2
+ * (s1 is assumed to be 1 if UNIT is true). Kernel selects evaluation
+ * order along q2 and q3 axes. Sets scratch.d pointers accordingly.
+ */
+template <class T, bool UNIT>
+void EvalRowDerivs (const AxisPlan       *  plans,
+                    const FieldOperator  &     op,
+                    const T * const      *     in,
+                    const ptrdiff_t      &     s1,
+                    const ptrdiff_t      &     s2,
+                    const size_t         &     i1,
+                    const size_t         & length,
+                    const size_t         &     i2,
+                    const size_t         &     i3,
+                    const FieldKernel    &  kernel,
+                    RowScratch           & scratch)
+{
+    const unsigned  m     = op.maxOrder();
+    const ptrdiff_t e     = UNIT ? 1 : s1;
+    const ptrdiff_t off   = (ptrdiff_t) i1 * e + (ptrdiff_t) i2 * s2;
+    double        * buf   = &scratch.values[0];
+    const double  * frow  = RowLoader<T, UNIT>::load(in[i3] + off, e, length,
+                                                     buf + 3 * m * length);
+
+    for (unsigned axis = 0; axis < 3; ++axis){
+        const AxisPlan & p  = plans[axis];
+        const unsigned   w  = p.width();
+        unsigned         nk = 0;
+
+        /* Orders used along the axis; all of them are evaluated in
+         * a single pass over function values. */
+        scratch.d[axis*(m+1)] = frow;
+
+        for (unsigned k = 1; k <= m; ++k){
+            if (!op.uses(axis, k)){
+                scratch.d[axis*(m+1)+k] = NULL;
+                continue;
+            }
+
+            scratch.orders[nk] = k;
+            scratch.rows  [nk] = buf;
+            scratch.d[axis*(m+1)+k] = buf;
+
+            buf += length;
+            ++nk;
+        }
+
+        if (nk == 0){
+            continue;
+        }
+
+        double * const * rows = &scratch.rows[0];
+        double         * acc  = &scratch.acc[0];
+
+        if (axis == AXIS_Q1){
+            /* Coefficients change along the row. */
+            const T * prow = in[i3] + (ptrdiff_t) i2 * s2;
+
+            for (size_t j = 0; j < length; ++j){
+                const double * c = p.coeffs(i1+j, 0);
+                const T      * v = prow + (ptrdiff_t) p.start(i1+j) * e;
+
+                for (unsigned q = 0; q < nk; ++q){
+                    acc[q] = 0.0;
+                }
+
+                if (PairedOrders(p, i1+j, &scratch.orders[0], nk,
+                                 &scratch.kinds[0])){
+                    /* Sums and differences of mirrored node values are
+                     * shared by all orders. */
+                    for (unsigned a = 0; a < w/2; ++a){
+                        const double va    = v[a*e];
+                        const double vb    = v[(w-1-a)*e];
+                        const double pv[2] = { va + vb, va - vb };
+
+                        for (unsigned q = 0; q < nk; ++q){
+                            acc[q] += c[scratch.orders[q]*w + a]
+                                    * pv[scratch.kinds[q]];
+                        }
+                    }
+
+                    if (w % 2 == 1){
+                        const double vm = v[(w/2)*e];
+
+                        for (unsigned q = 0; q < nk; ++q){
+                            if (!scratch.kinds[q]){
+                                acc[q] += c[scratch.orders[q]*w + w/2] * vm;
+                            }
+                        }
+                    }
+                }
+                else {
+                    for (unsigned a = 0; a < w; ++a){
+                        const double va = v[a*e];
+
+                        for (unsigned q = 0; q < nk; ++q){
+                            acc[q] += c[scratch.orders[q]*w + a] * va;
+                        }
+                    }
+                }
+
+                for (unsigned q = 0; q < nk; ++q){
+                    rows[q][j] = acc[q];
+                }
+            }
+        }
+        else {
+            /* Coefficients are constant along the row; by default rows of
+             * stencil nodes are accumulated one at a time. */
+            const size_t   i      = (axis == AXIS_Q2) ? i2 : i3;
+            const double * c      = p.coeffs(i, 0);
+            const size_t   s      = p.start(i);
+            const bool     paired = PairedOrders(p, i, &scratch.orders[0],
+                                                 nk, &scratch.kinds[0]);
+
+            /* Pointers to rows of stencil nodes. */
+            scratch.taps.resize(w);
+
+            for (unsigned b = 0; b < w; ++b){
+                scratch.taps[b] = (axis == AXIS_Q2)
+                                ? in[i3]  + (ptrdiff_t) i1 * e
+                                          + (ptrdiff_t) (s+b) * s2
+                                : in[s+b] + off;
+            }
+
+            if (kernel == FIELD_KERNEL_DOT){
+                /* Every node is evaluated separately (output is written
+                 * once; stencil rows are read concurrently). */
+                for (size_t j = 0; j < length; ++j){
+                    for (unsigned q = 0; q < nk; ++q){
+                        acc[q] = 0.0;
+                    }
+
+                    /* Mirrored nodes of symmetric stencils are paired. */
+                    const unsigned nb = paired ? (w+1)/2 : w;
+
+                    for (unsigned b = 0; b < nb; ++b){
+                        const double vb = static_cast<const T *>
+                                              (scratch.taps[b])[j*e];
+
+                        if (!paired){
+                            for (unsigned q = 0; q < nk; ++q){
+                                acc[q] += c[scratch.orders[q]*w + b] * vb;
+                            }
+                            continue;
+                        }
+
+                        if (2*b+1 == w){
+                            for (unsigned q = 0; q < nk; ++q){
+                                if (!scratch.kinds[q]){
+                                    acc[q] += c[scratch.orders[q]*w + b]
+                                            * vb;
+                                }
+                            }
+                            continue;
+                        }
+
+                        const double vm    = static_cast<const T *>
+                                                 (scratch.taps[w-1-b])[j*e];
+                        const double pv[2] = { vb + vm, vb - vm };
+
+                        for (unsigned q = 0; q < nk; ++q){
+                            acc[q] += c[scratch.orders[q]*w + b]
+                                    * pv[scratch.kinds[q]];
+                        }
+                    }
+
+                    for (unsigned q = 0; q < nk; ++q){
+                        rows[q][j] = acc[q];
+                    }
+                }
+                continue;
+            }
+
+            for (unsigned q = 0; q < nk; ++q){
+                for (size_t j = 0; j < length; ++j){
+                    rows[q][j] = 0.0;
+                }
+            }
+
+            if (paired){
+                /* Rows of mirrored nodes are added (subtracted) while
+                 * they are multiplied by their common coefficient. */
+                for (unsigned b = 0; b < w/2; ++b){
+                    const T * u = static_cast<const T *>(scratch.taps[b]);
+                    const T * v = static_cast<const T *>
+                                      (scratch.taps[w-1-b]);
+
+                    for (unsigned q = 0; q < nk; ++q){
+                        PairedAxpy(rows[q], c[scratch.orders[q]*w + b],
+                                   u, v, e, length, scratch.kinds[q] != 0);
+                    }
+                }
+
+                if (w % 2 == 1){
+                    const T * v = static_cast<const T *>(scratch.taps[w/2]);
+
+                    for (unsigned q = 0; q < nk; ++q){
+                        const double cm = c[scratch.orders[q]*w + w/2];
+
+                        if (scratch.kinds[q]){
+                            continue;
+                        }
+                        for (size_t j = 0; j < length; ++j){
+                            rows[q][j] += cm * v[j*e];
+                        }
+                    }
+                }
+                continue;
+            }
+
+            for (unsigned b = 0; b < w; ++b){
+                const T * v = static_cast<const T *>(scratch.taps[b]);
+
+                for (unsigned q = 0; q < nk; ++q){
+                    acc[q] = c[scratch.orders[q]*w + b];
+                }
+
+                if (nk == 1){
+                    double * r0 = rows[0];
+
+                    for (size_t j = 0; j < length; ++j){
+                        r0[j] += acc[0] * v[j*e];
+                    }
+                }
+                else if (nk == 2){
+                    double * r0 = rows[0];
+                    double * r1 = rows[1];
+
+                    for (size_t j = 0; j < length; ++j){
+                        const double vj = v[j*e];
+
+                        r0[j] += acc[0] * vj;
+                        r1[j] += acc[1] * vj;
+                    }
+                }
+                else {
+                    for (size_t j = 0; j < length; ++j){
+                        const double vj = v[j*e];
+
+                        for (unsigned q = 0; q < nk; ++q){
+                            rows[q][j] += acc[q] * vj;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * AxisPass()
+ *
+ * Applies kth derivative stencils of one axis to a whole field (one pass
+ * of sum factorization). Input is contiguous; value of node n is written
+ * to out[n*ostride].
+ */
+void AxisPass (const AxisPlan  &       p,
+               const unsigned  &    axis,
+               const unsigned  &       k,
+               const double    *      in,
+               double          *     out,
+               const ptrdiff_t & ostride,
+               const size_t    &      N1,
+               const size_t    &      N2,
+               const size_t    &      N3,
+               const int       & threads)
+{
+    const unsigned w     = p.width();
+    const size_t   plane = N1 * N2;
+    const long     rows  = (long) (N2 * N3);
+
+    #pragma omp parallel for schedule(static) num_threads(threads)
+    for (long r = 0; r < rows; ++r){
+        const size_t   i2   = r % N2;
+        const size_t   i3   = r / N2;
+        const double * irow = in  + i2 * N1 + i3 * plane;
+        double       * orow = out + (i2 * N1 + i3 * plane) * ostride;
+
+        if (axis == AXIS_Q1){
+            for (size_t j = 0; j < N1; ++j){
+                orow[j*ostride] = StencilSum(p.coeffs(j, k),
+                                             irow + p.start(j), 1, w,
+                                             p.symmetry(j, k));
+            }
+        }
+        else {
+            const size_t   i    = (axis == AXIS_Q2) ? i2 : i3;
+            const size_t   step = (axis == AXIS_Q2) ? N1 : plane;
+            const double * c    = p.coeffs(i, k);
+            const double * v0   = irow - (ptrdiff_t) (i * step)
+                                       + (ptrdiff_t) (p.start(i) * step);
+            const int      sym  = p.symmetry(i, k);
+
+            for (size_t j = 0; j < N1; ++j){
+                orow[j*ostride] = StencilSum(c, v0 + j, (ptrdiff_t) step,
+                                             w, sym);
+            }
+        }
+    }
+}
+
+/*
+ * EvalRowDerivsInterleaved()
+ *
+ * Evaluates partial derivatives used by an operator for a row of K
+ * interleaved fields (value of field k at node n stored at n*K + k; in
+ * holds pointers to q3 planes). Derivative rows are interleaved the same
+ * way (length*K values each) and pointed to by scratch.d; the innermost
+ * loops run over fields or over whole rows of values (along q2 and q3
+ * axes interleaved rows are contiguous).
+ */
+void EvalRowDerivsInterleaved (const AxisPlan         *  plans,
+                               const FieldOperator    &     op,
+                               const double * const   *     in,
+                               const size_t           &      K,
+                               const size_t           &     N1,
+                               const size_t           &     i1,
+                               const size_t           & length,
+                               const size_t           &     i2,
+                               const size_t           &     i3,
+                               RowScratch             & scratch)
+{
+    const unsigned m     = op.maxOrder();
+    const size_t   L     = length * K;
+    const size_t   off   = (i1 + N1 * i2) * K;
+    double       * buf   = &scratch.values[0];
+
+    for (unsigned axis = 0; axis < 3; ++axis){
+        const AxisPlan & p  = plans[axis];
+        const unsigned   w  = p.width();
+        unsigned         nk = 0;
+
+        scratch.d[axis*(m+1)] = in[i3] + off;
+
+        for (unsigned k = 1; k <= m; ++k){
+            if (!op.uses(axis, k)){
+                scratch.d[axis*(m+1)+k] = NULL;
+                continue;
+            }
+
+            scratch.orders[nk] = k;
+            scratch.rows  [nk] = buf;
+            scratch.d[axis*(m+1)+k] = buf;
+
+            buf += L;
+            ++nk;
+        }
+
+        for (unsigned q = 0; q < nk; ++q){
+            std::fill(scratch.rows[q], scratch.rows[q] + L, 0.0);
+        }
+
+        if (nk == 0){
+            continue;
+        }
+
+        if (axis == AXIS_Q1){
+            /* Coefficients change along the row; fields share them. */
+            const double * prow = in[i3] + N1 * i2 * K;
+
+            for (size_t j = 0; j < length; ++j){
+                const double * c = p.coeffs(i1+j, 0);
+                const double * v = prow + p.start(i1+j) * K;
+
+                for (unsigned q = 0; q < nk; ++q){
+                    const double * cq  = c + scratch.orders[q] * w;
+                    double       * r   = scratch.rows[q] + j * K;
+                    const int      sym = p.symmetry(i1+j, scratch.orders[q]);
+
+                    if (sym != FORNBERG_GENERAL){
+                        /* Mirrored nodes paired (middle coefficient of
+                         * antisymmetric stencils is zero). */
+                        for (unsigned a = 0; a < w/2; ++a){
+                            PairedAxpy(r, cq[a], v + a * K,
+                                       v + (w-1-a) * K, 1, K,
+                                       sym == FORNBERG_ANTISYMMETRIC);
+                        }
+                        if (w % 2 == 1 && sym != FORNBERG_ANTISYMMETRIC){
+                            const double * vm = v + (w/2) * K;
+
+                            for (size_t f = 0; f < K; ++f){
+                                r[f] += cq[w/2] * vm[f];
+                            }
+                        }
+                        continue;
+                    }
+
+                    for (unsigned a = 0; a < w; ++a){
+                        const double   ca = cq[a];
+                        const double * va = v + a * K;
+
+                        for (size_t f = 0; f < K; ++f){
+                            r[f] += ca * va[f];
+                        }
+                    }
+                }
+            }
+        }
+        else {
+            /* Interleaved rows are contiguous; rows of mirrored nodes of
+             * symmetric stencils are paired. */
+            const size_t   i      = (axis == AXIS_Q2) ? i2 : i3;
+            const double * c      = p.coeffs(i, 0);
+            const size_t   s      = p.start(i);
+            const bool     paired = PairedOrders(p, i, &scratch.orders[0],
+                                                 nk, &scratch.kinds[0]);
+            const unsigned nb     = paired ? (w+1)/2 : w;
+
+            for (unsigned b = 0; b < nb; ++b){
+                const size_t   t = s + w-1-b;
+                const double * v = (axis == AXIS_Q2)
+                                 ? in[i3]  + (i1 + N1 * (s+b)) * K
+                                 : in[s+b] + off;
+                const double * u = (axis == AXIS_Q2)
+                                 ? in[i3]  + (i1 + N1 * t) * K
+                                 : in[t]   + off;
+
+                for (unsigned q = 0; q < nk; ++q){
+                    const double   cb = c[scratch.orders[q] * w + b];
+                    double       * r  = scratch.rows[q];
+
+                    if (paired && 2*b+1 < w){
+                        PairedAxpy(r, cb, v, u, 1, L, scratch.kinds[q] != 0);
+                        continue;
+                    }
+                    if (paired && scratch.kinds[q]){
+                        continue;
+                    }
+
+                    for (size_t x = 0; x < L; ++x){
+                        r[x] += cb * v[x];
+                    }
+                }
+            }
+        }
+    }
+}
+
+} /* anonymous namespace */
+
+
+FieldEngine::FieldEngine (const QGrid    & q1Coords,
+                          const QGrid    & q2Coords,
+                          const QGrid    & q3Coords,
+                          const unsigned &    width,
+                          const unsigned & maxOrder)
+
+                        : mQ1Coords (q1Coords),
+                          mQ2Coords (q2Coords),
+                          mQ3Coords (q3Coords)
+{
+    mPlans[AXIS_Q1] = AxisPlan(q1Coords, width, maxOrder);
+    mPlans[AXIS_Q2] = AxisPlan(q2Coords, width, maxOrder);
+    mPlans[AXIS_Q3] = AxisPlan(q3Coords, width, maxOrder);
+}
+
+
+FieldEngine::FieldEngine (const QGrid    & q1Coords,
+                          const QGrid    & q2Coords,
+                          const QGrid    & q3Coords,
+                          const AxisPlan *    plans)
+
+                        : mQ1Coords (q1Coords),
+                          mQ2Coords (q2Coords),
+                          mQ3Coords (q3Coords)
+{
+    /* If one of arguments is invalid, throw exception. */
+    if (plans[AXIS_Q1].size() != q1Coords.size() ||
+        plans[AXIS_Q2].size() != q2Coords.size() ||
+        plans[AXIS_Q3].size() != q3Coords.size()){
+        throw std::invalid_argument("plan size differs from grid size");
+    }
+
+    if (plans[AXIS_Q2].maxOrder() != plans[AXIS_Q1].maxOrder() ||
+        plans[AXIS_Q3].maxOrder() != plans[AXIS_Q1].maxOrder()){
+        throw std::invalid_argument("plans of different max orders");
+    }
+
+    mPlans[AXIS_Q1] = plans[AXIS_Q1];
+    mPlans[AXIS_Q2] = plans[AXIS_Q2];
+    mPlans[AXIS_Q3] = plans[AXIS_Q3];
+}
+
+
+int FieldEngine::threadCount () const
+{
+#ifdef _OPENMP
+    return mConfig.threads ? (int) mConfig.threads : omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+
+const QGrid & FieldEngine::coords (const unsigned & axis) const
+{
+    if (axis == AXIS_Q1){ return mQ1Coords; }
+    if (axis == AXIS_Q2){ return mQ2Coords; }
+    return mQ3Coords;
+}
+
+
+void FieldEngine::firstTouch (double         *          f,
+                              const unsigned & components) const
+{
+    const size_t     N1    = n1(),
+                     N2    = n2(),
+                     N3    = n3();
+    const TileLayout tiles(mConfig, N1, N2, N3);
+    const long       nt    = tiles.count();
+
+    #pragma omp parallel num_threads(threadCount())
+    {
+        size_t lo[3], hi[3];
+
+        #pragma omp for schedule(static)
+        for (long t = 0; t < nt; ++t){
+            tiles.box(t, lo, hi);
+
+            for (size_t i3 = lo[AXIS_Q3]; i3 < hi[AXIS_Q3]; ++i3){
+                for (size_t i2 = lo[AXIS_Q2]; i2 < hi[AXIS_Q2]; ++i2){
+                    double * v = f + QFieldIndex(lo[AXIS_Q1], i2, i3, N1, N2)
+                                   * components;
+
+                    std::fill(v, v + (hi[AXIS_Q1] - lo[AXIS_Q1]) * components,
+                              0.0);
+                }
+            }
+        }
+    }
+}
+
+
+template <class T, bool UNIT>
+void FieldEngine::applyView (const FieldOperator &       op,
+                             const T             *        f,
+                             const ptrdiff_t     * strides,
+                             double * const      *      out,
+                             const ptrdiff_t     & ostride) const
+{
+    /* If arguments invalid, throw exception. */
+    CheckOperator(op, mPlans);
+
+    const size_t     N1    = n1(),
+                     N2    = n2(),
+                     N3    = n3();
+    const unsigned   ncomp = op.components();
+    const TileLayout tiles(mConfig, N1, N2, N3);
+    const long       nt    = tiles.count();
+
+    /* Pointers to q3 planes of input field. */
+    std::vector<const T *> in(N3);
+    for (size_t i3 = 0; i3 < N3; ++i3){
+        in[i3] = f + (ptrdiff_t) i3 * strides[AXIS_Q3];
+    }
+
+    #pragma omp parallel num_threads(threadCount())
+    {
+        RowScratch scratch(op, tiles.t[AXIS_Q1]);
+        RowContext row;
+        size_t     lo[3], hi[3];
+
+        #pragma omp for schedule(static)
+        for (long t = 0; t < nt; ++t){
+            tiles.box(t, lo, hi);
+
+            for (size_t i3 = lo[AXIS_Q3]; i3 < hi[AXIS_Q3]; ++i3){
+                for (size_t i2 = lo[AXIS_Q2]; i2 < hi[AXIS_Q2]; ++i2){
+                    const size_t i1  = lo[AXIS_Q1];
+                    const size_t len = hi[AXIS_Q1] - i1;
+
+                    EvalRowDerivs<T, UNIT>(mPlans, op, &in[0],
+                                           strides[AXIS_Q1],
+                                           strides[AXIS_Q2],
+                                           i1, len, i2, i3,
+                                           mConfig.kernel, scratch);
+
+                    row.i1     = i1;
+                    row.i2     = i2;
+                    row.i3     = i3;
+                    row.length = len;
+                    row.node   = QFieldIndex(i1, i2, i3, N1, N2);
+                    row.q1     = &mQ1Coords[i1];
+                    row.q2     = mQ2Coords[i2];
+                    row.q3     = mQ3Coords[i3];
+
+                    for (unsigned c = 0; c < ncomp; ++c){
+                        scratch.out[c] = out[c] + row.node * ostride;
+                    }
+
+                    op.combineRow(row, &scratch.d[0], &scratch.out[0],
+                                  ostride);
+                }
+            }
+        }
+    }
+}
+
+
+void FieldEngine::apply (const FieldOperator & op,
+                         const double        *  f,
+                         double              * out) const
+{
+    const FieldView view = { f, FIELD_FLOAT64,
+                             { 1, (ptrdiff_t) n1(),
+                               (ptrdiff_t) (n1() * n2()) } };
+
+    apply(op, view, out);
+}
+
+
+void FieldEngine::apply (const FieldOperator & op,
+                         const FieldView     &  f,
+                         double              * out) const
+{
+    const unsigned        ncomp = op.components();
+    const ptrdiff_t       os    = (ptrdiff_t) ncomp;
+    std::vector<double *> o(ncomp);
+
+    for (unsigned c = 0; c < ncomp; ++c){
+        o[c] = out + c;
+    }
+
+    if (f.type == FIELD_FLOAT64){
+        const double * v = static_cast<const double *>(f.data);
+
+        if (f.strides[AXIS_Q1] == 1){
+            applyView<double, true> (op, v, f.strides, &o[0], os);
+        }
+        else {
+            applyView<double, false>(op, v, f.strides, &o[0], os);
+        }
+    }
+    else {
+        const float * v = static_cast<const float *>(f.data);
+
+        if (f.strides[AXIS_Q1] == 1){
+            applyView<float, true> (op, v, f.strides, &o[0], os);
+        }
+        else {
+            applyView<float, false>(op, v, f.strides, &o[0], os);
+        }
+    }
+}
+
+
+void FieldEngine::applyComponents (const FieldOperator &   op,
+                                   const double        *    f,
+                                   double * const      *  out) const
+{
+    const ptrdiff_t strides[3] = { 1,
+                                   (ptrdiff_t) n1(),
+                                   (ptrdiff_t) (n1() * n2()) };
+
+    applyView<double, true>(op, f, strides, out, 1);
+}
+
+
+void FieldEngine::apply (const FieldOperator &  op,
+                         const BrickedField  &   f,
+                         BrickedField        & out) const
+{
+    /* If arguments invalid, throw exception. */
+    CheckOperator(op, mPlans);
+
+    if (&f == &out){
+        throw std::invalid_argument("input and output fields are the same");
+    }
+
+    if (f.components() != 1 || out.components() != op.components()){
+        throw std::invalid_argument("wrong number of field components");
+    }
+
+    const size_t N[3] = { n1(), n2(), n3() };
+
+    for (unsigned a = 0; a < 3; ++a){
+        if (f.n(a) != N[a] || out.n(a) != N[a] ||
+            out.brickExtent(a) != f.brickExtent(a)){
+            throw std::invalid_argument("bricked fields do not match grid");
+        }
+        if (f.brickExtent(a) < mPlans[a].width() &&
+            f.brickExtent(a) < N[a]){
+            throw std::invalid_argument("brick extent < stencil width");
+        }
+        if (f.ghost() < mPlans[a].width() / 2){
+            throw std::invalid_argument("ghost layers too thin");
+        }
+    }
+
+    const unsigned  ncomp = op.components();
+    const size_t    G     = f.ghost();
+    const ptrdiff_t P1    = (ptrdiff_t) f.paddedExtent(AXIS_Q1);
+    const ptrdiff_t P12   = P1 * (ptrdiff_t) f.paddedExtent(AXIS_Q2);
+    const size_t    B1    = f.brickExtent(AXIS_Q1),
+                    B2    = f.brickExtent(AXIS_Q2),
+                    B3    = f.brickExtent(AXIS_Q3);
+    const long      nb    = (long) f.bricks();
+
+    #pragma omp parallel num_threads(threadCount())
+    {
+        RowScratch                  scratch(op, B1);
+        RowContext                  row;
+        std::vector<const double *> in(N[AXIS_Q3], (const double *) NULL);
+        size_t                      o[3];
+
+        #pragma omp for schedule(static)
+        for (long b = 0; b < nb; ++b){
+            f.origin(b, o);
+
+            /* Plane pointers, such that in[i3] + i1 + i2*P1 addresses
+             * global node (i1,i2,i3) within padded box of the brick. */
+            const double * base = f.brick(b);
+            const size_t   lo3  = (o[2] >= G) ? o[2] - G : 0;
+            const size_t   hi3  = std::min(o[2] + B3 + G, N[AXIS_Q3]);
+
+            for (size_t i3 = lo3; i3 < hi3; ++i3){
+                in[i3] = base + ((ptrdiff_t) (i3 + G) - (ptrdiff_t) o[2]) * P12
+                              + ((ptrdiff_t) G - (ptrdiff_t) o[0])
+                              + ((ptrdiff_t) G - (ptrdiff_t) o[1]) * P1;
+            }
+
+            double * obase = out.brick(b);
+
+            for (size_t i3 = o[2]; i3 < o[2] + B3; ++i3){
+                for (size_t i2 = o[1]; i2 < o[1] + B2; ++i2){
+                    EvalRowDerivs<double, true>(mPlans, op, &in[0], 1, P1,
+                                                o[0], B1, i2, i3,
+                                                mConfig.kernel, scratch);
+
+                    row.i1     = o[0];
+                    row.i2     = i2;
+                    row.i3     = i3;
+                    row.length = B1;
+                    row.node   = QFieldIndex(o[0], i2, i3, N[0], N[1]);
+                    row.q1     = &mQ1Coords[o[0]];
+                    row.q2     = mQ2Coords[i2];
+                    row.q3     = mQ3Coords[i3];
+
+                    const size_t l = out.local(0, (long) (i2 - o[1]),
+                                                  (long) (i3 - o[2]));
+
+                    for (unsigned c = 0; c < ncomp; ++c){
+                        scratch.out[c] = obase + l * ncomp + c;
+                    }
+
+                    op.combineRow(row, &scratch.d[0], &scratch.out[0],
+                                  (ptrdiff_t) ncomp);
+                }
+            }
+        }
+    }
+}
+
+
+void FieldEngine::applySteps (const FieldOperator &    op,
+                              const double        & alpha,
+                              const unsigned      & steps,
+                              const double        *     f,
+                              double              *   out) const
+{
+    /* If arguments invalid, throw exception. */
+    CheckOperator(op, mPlans);
+
+    if (op.components() != 1){
+        throw std::invalid_argument("operator is not scalar");
+    }
+
+    if (f == out){
+        throw std::invalid_argument("input and output fields are the same");
+    }
+
+    const StepFieldOp step(op, alpha);
+
+    if (steps == 0){
+        std::copy(f, f + size(), out);
+        return;
+    }
+
+    /* Separate sweeps; intermediate results alternate between out and
+     * a temporary field, so that the last one is written to out. */
+    if (!mConfig.temporalBlocking || steps == 1){
+        std::vector<double> tmp(steps > 1 ? size() : 0);
+        const double      * src = f;
+
+        for (unsigned s = 0; s < steps; ++s){
+            double * dst = ((steps - 1 - s) % 2 == 0) ? out : &tmp[0];
+
+            apply(step, src, dst);
+            src = dst;
+        }
+        return;
+    }
+
+    /* Temporally blocked sweeps of groups of at most depth steps (more
+     * steps would need too large halos to keep their rings in cache);
+     * results of groups alternate between out and a temporary field, like
+     * those of separate sweeps. */
+    const unsigned depth  = WavefrontDepth(mPlans[AXIS_Q1], mPlans[AXIS_Q2],
+                                           mPlans[AXIS_Q3].width() + 1,
+                                           (size_t) threadCount(), steps);
+    const unsigned groups = (steps + depth - 1) / depth;
+
+    std::vector<double> tmp(groups > 1 ? size() : 0);
+    const double      * src = f;
+
+    for (unsigned g = 0; g < groups; ++g){
+        const unsigned k   = std::min(depth, steps - g * depth);
+        double       * dst = ((groups - 1 - g) % 2 == 0) ? out : &tmp[0];
+
+        if (k == 1){
+            apply(step, src, dst);
+        }
+        else {
+            applyWavefront(step, k, src, dst);
+        }
+        src = dst;
+    }
+}
+
+
+void FieldEngine::applyWavefront (const FieldOperator &  step,
+                                  const unsigned      & steps,
+                                  const double        *     f,
+                                  double              *   out) const
+{
+    const size_t N1    = n1(),
+                 N2    = n2(),
+                 N3    = n3();
+    const size_t plane = N1 * N2;
+
+    /* Wavefront sweeps over overlapped q1-q2 tiles. Every thread sweeps
+     * its tiles separately: step s (s=1,...,steps-1) results of a tile are
+     * kept in a private ring of R planes (plane i3 in slot i3 % R), step 0
+     * is the input field and the last step is written directly to out.
+     * Step s covers the tile extended by the stencil reach of steps-s
+     * steps (its halo), so neighbouring tiles recompute halo nodes, with
+     * exactly the same operations, instead of exchanging them. */
+    const AxisPlan & p1  = mPlans[AXIS_Q1];
+    const AxisPlan & p2  = mPlans[AXIS_Q2];
+    const AxisPlan & p3  = mPlans[AXIS_Q3];
+    const size_t     R   = p3.width() + 1;
+    const size_t     t1  = TileLayout(mConfig, N1, N2, N3).t[AXIS_Q1];
+    const int        nth = threadCount();
+    const size_t     h1  = (steps - 1) * std::max(p1.reachBelow(),
+                                                  p1.reachAbove());
+    const size_t     h2  = (steps - 1) * std::max(p2.reachBelow(),
+                                                  p2.reachAbove());
+
+    size_t b1, b2;
+    WavefrontTiles(N1, N2, h1, h2, (steps - 1) * R, (size_t) nth, b1, b2);
+
+    const size_t nb1  = (N1 + b1 - 1) / b1;
+    const long   nt   = (long) (nb1 * ((N2 + b2 - 1) / b2));
+    const size_t slot = std::min(N1, b1 + 2 * h1) * std::min(N2, b2 + 2 * h2);
+
+    #pragma omp parallel num_threads(nth)
+    {
+        RowScratch scratch(step, t1);
+        RowContext row;
+
+        std::vector<double>         ring((steps - 1) * R * slot);
+        std::vector<const double *> src(steps * N3);
+        std::vector<double *>       dst(steps * N3);
+
+        /* Node ranges [lo,hi) of every step along q1 and q2 axes and row
+         * strides of step results. */
+        std::vector<size_t> lo1(steps + 1), hi1(steps + 1),
+                            lo2(steps + 1), hi2(steps + 1),
+                            rs (steps + 1, N1);
+
+        #pragma omp for schedule(dynamic, 1)
+        for (long tile = 0; tile < nt; ++tile){
+            lo1[steps] = (tile % nb1) * b1;
+            lo2[steps] = (tile / nb1) * b2;
+            hi1[steps] = std::min(lo1[steps] + b1, N1);
+            hi2[steps] = std::min(lo2[steps] + b2, N2);
+
+            for (unsigned s = steps; s > 1; --s){
+                lo1[s-1] = p1.start(lo1[s]);
+                lo2[s-1] = p2.start(lo2[s]);
+                hi1[s-1] = p1.start(hi1[s] - 1) + p1.width();
+                hi2[s-1] = p2.start(hi2[s] - 1) + p2.width();
+                rs [s-1] = hi1[s-1] - lo1[s-1];
+            }
+
+            /* Plane pointers of every step, such that node (i1,i2) of
+             * a plane is at i1 + rs[s]*i2 (ring slots only hold nodes of
+             * the step range, other nodes are never accessed). */
+            for (size_t i3 = 0; i3 < N3; ++i3){
+                src[i3] = f + i3 * plane;
+                dst[(steps-1)*N3 + i3] = out + i3 * plane;
+            }
+            for (unsigned s = 1; s < steps; ++s){
+                for (size_t i3 = 0; i3 < N3; ++i3){
+                    double * pl = &ring[((s-1) * R + i3 % R) * slot]
+                                - (lo1[s] + rs[s] * lo2[s]);
+
+                    src[s*N3 + i3]     = pl;
+                    dst[(s-1)*N3 + i3] = pl;
+                }
+            }
+
+            /* Number of planes done for every step. */
+            std::vector<size_t> done(steps + 1, 0);
+            done[0] = N3;
+
+            while (done[steps] < N3){
+                for (unsigned s = steps; s >= 1; --s){
+                    for (;;){
+                        const size_t z = done[s];
+
+                        /* Plane has to be missing, planes of previous step
+                         * it depends on have to be available and its ring
+                         * slot cannot be needed by the next step anymore. */
+                        if (z >= N3){
+                            break;
+                        }
+                        if (done[s-1] < p3.start(z) + p3.width()){
+                            break;
+                        }
+                        if (s < steps && done[s+1] < N3
+                                      && z >= p3.start(done[s+1]) + R){
+                            break;
+                        }
+
+                        const double * const * in = &src[(s-1) * N3];
+                        double               * pl = dst[(s-1) * N3 + z];
+
+                        for (size_t i2 = lo2[s]; i2 < hi2[s]; ++i2){
+                            for (size_t a = lo1[s]; a < hi1[s]; a += t1){
+                                const size_t len = std::min(t1, hi1[s] - a);
+
+                                EvalRowDerivs<double, true>(mPlans, step, in,
+                                                            1, (ptrdiff_t)
+                                                               rs[s-1],
+                                                            a, len, i2, z,
+                                                            mConfig.kernel,
+                                                            scratch);
+
+                                row.i1     = a;
+                                row.i2     = i2;
+                                row.i3     = z;
+                                row.length = len;
+                                row.node   = QFieldIndex(a, i2, z, N1, N2);
+                                row.q1     = &mQ1Coords[a];
+                                row.q2     = mQ2Coords[i2];
+                                row.q3     = mQ3Coords[z];
+
+                                scratch.out[0] = pl + a + rs[s] * i2;
+
+                                step.combineRow(row, &scratch.d[0],
+                                                &scratch.out[0], 1);
+                            }
+                        }
+
+                        ++done[s];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void FieldEngine::derivative (const unsigned * orders,
+                              const double   *      f,
+                              double         *    out) const
+{
+    /* If arguments invalid, throw exception. */
+    for (unsigned a = 0; a < 3; ++a){
+        if (orders[a] > mPlans[a].maxOrder()){
+            throw std::invalid_argument("given order higher than max");
+        }
+    }
+
+    if (f == out){
+        throw std::invalid_argument("input and output fields are the same");
+    }
+
+    const size_t N1 = n1(),
+                 N2 = n2(),
+                 N3 = n3();
+
+    /* Axes with nonzero orders; passes alternate between out and
+     * a temporary field, so that the last one is written to out. */
+    unsigned axes[3], np = 0;
+
+    for (unsigned a = 0; a < 3; ++a){
+        if (orders[a] > 0){ axes[np++] = a; }
+    }
+
+    if (np == 0){
+        std::copy(f, f + size(), out);
+        return;
+    }
+
+    std::vector<double> tmp(np > 1 ? size() : 0);
+    const double      * src = f;
+
+    for (unsigned q = 0; q < np; ++q){
+        double * dst = ((np - 1 - q) % 2 == 0) ? out : &tmp[0];
+
+        AxisPass(mPlans[axes[q]], axes[q], orders[axes[q]], src, dst, 1,
+                 N1, N2, N3, threadCount());
+        src = dst;
+    }
+}
+
+
+void FieldEngine::hessian (const double *   f,
+                           double       * out) const
+{
+    /* If arguments invalid, throw exception. */
+    if (mPlans[AXIS_Q1].maxOrder() < 2){
+        throw std::invalid_argument("max order lower than 2");
+    }
+
+    const size_t N1  = n1(),
+                 N2  = n2(),
+                 N3  = n3();
+    const int    nth = threadCount();
+
+    /* Second derivatives along single axes. */
+    AxisPass(mPlans[AXIS_Q1], AXIS_Q1, 2, f, out + 0, 6, N1, N2, N3, nth);
+    AxisPass(mPlans[AXIS_Q2], AXIS_Q2, 2, f, out + 1, 6, N1, N2, N3, nth);
+    AxisPass(mPlans[AXIS_Q3], AXIS_Q3, 2, f, out + 2, 6, N1, N2, N3, nth);
+
+    /* Mixed derivatives; df/dq1 is shared by d2f/dq1dq2 and d2f/dq1dq3. */
+    std::vector<double> t(size());
+
+    AxisPass(mPlans[AXIS_Q1], AXIS_Q1, 1, f,     &t[0],   1, N1, N2, N3, nth);
+    AxisPass(mPlans[AXIS_Q2], AXIS_Q2, 1, &t[0], out + 3, 6, N1, N2, N3, nth);
+    AxisPass(mPlans[AXIS_Q3], AXIS_Q3, 1, &t[0], out + 4, 6, N1, N2, N3, nth);
+
+    AxisPass(mPlans[AXIS_Q2], AXIS_Q2, 1, f,     &t[0],   1, N1, N2, N3, nth);
+    AxisPass(mPlans[AXIS_Q3], AXIS_Q3, 1, &t[0], out + 5, 6, N1, N2, N3, nth);
+}
+
+void FieldEngine::applyBatch (const FieldOperator &    op,
+                              const unsigned      &     K,
+                              const double * const *    f,
+                              double       * const *  out) const
+{
+    /* If arguments invalid, throw exception. */
+    CheckOperator(op, mPlans);
+
+    const size_t     N1    = n1(),
+                     N2    = n2(),
+                     N3    = n3();
+    const unsigned   ncomp = op.components();
+    const TileLayout tiles(mConfig, N1, N2, N3);
+    const long       nt    = tiles.count();
+
+    /* Pointers to q3 planes of input fields. */
+    std::vector<const double *> in(K * N3);
+    for (unsigned k = 0; k < K; ++k){
+        for (size_t i3 = 0; i3 < N3; ++i3){
+            in[k*N3 + i3] = f[k] + i3 * N1 * N2;
+        }
+    }
+
+    #pragma omp parallel num_threads(threadCount())
+    {
+        RowScratch scratch(op, tiles.t[AXIS_Q1]);
+        RowContext row;
+        size_t     lo[3], hi[3];
+
+        #pragma omp for schedule(static)
+        for (long t = 0; t < nt; ++t){
+            tiles.box(t, lo, hi);
+
+            for (size_t i3 = lo[AXIS_Q3]; i3 < hi[AXIS_Q3]; ++i3){
+                for (size_t i2 = lo[AXIS_Q2]; i2 < hi[AXIS_Q2]; ++i2){
+                    const size_t i1  = lo[AXIS_Q1];
+                    const size_t len = hi[AXIS_Q1] - i1;
+
+                    row.i1     = i1;
+                    row.i2     = i2;
+                    row.i3     = i3;
+                    row.length = len;
+                    row.node   = QFieldIndex(i1, i2, i3, N1, N2);
+                    row.q1     = &mQ1Coords[i1];
+                    row.q2     = mQ2Coords[i2];
+                    row.q3     = mQ3Coords[i3];
+
+                    /* Fields are evaluated one after another for the same
+                     * row, so coefficients stay in cache. */
+                    for (unsigned k = 0; k < K; ++k){
+                        EvalRowDerivs<double, true>(mPlans, op, &in[k*N3],
+                                                    1, (ptrdiff_t) N1,
+                                                    i1, len, i2, i3,
+                                                    mConfig.kernel, scratch);
+
+                        for (unsigned c = 0; c < ncomp; ++c){
+                            scratch.out[c] = out[k] + row.node * ncomp + c;
+                        }
+
+                        op.combineRow(row, &scratch.d[0], &scratch.out[0],
+                                      (ptrdiff_t) ncomp);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+void FieldEngine::applyInterleaved (const FieldOperator &  op,
+                                    const unsigned      &   K,
+                                    const double        *   f,
+                                    double              * out) const
+{
+    /* If arguments invalid, throw exception. */
+    CheckOperator(op, mPlans);
+
+    const size_t     N1    = n1(),
+                     N2    = n2(),
+                     N3    = n3();
+    const unsigned   m     = op.maxOrder();
+    const unsigned   ncomp = op.components();
+    const TileLayout tiles(mConfig, N1, N2, N3);
+    const long       nt    = tiles.count();
+
+    /* Pointers to q3 planes of input fields. */
+    std::vector<const double *> in(N3);
+    for (size_t i3 = 0; i3 < N3; ++i3){
+        in[i3] = f + i3 * N1 * N2 * K;
+    }
+
+    #pragma omp parallel num_threads(threadCount())
+    {
+        /* Scratch rows hold K interleaved values per node; derivatives of
+         * a single field are gathered to fieldD rows before combining. */
+        RowScratch                  scratch(op, tiles.t[AXIS_Q1] * K);
+        std::vector<double>         fieldValues(3 * (m+1) * tiles.t[AXIS_Q1]);
+        std::vector<const double *> fieldD(3 * (m+1), (const double *) NULL);
+        RowContext                  row;
+        size_t                      lo[3], hi[3];
+
+        #pragma omp for schedule(static)
+        for (long t = 0; t < nt; ++t){
+            tiles.box(t, lo, hi);
+
+            for (size_t i3 = lo[AXIS_Q3]; i3 < hi[AXIS_Q3]; ++i3){
+                for (size_t i2 = lo[AXIS_Q2]; i2 < hi[AXIS_Q2]; ++i2){
+                    const size_t i1  = lo[AXIS_Q1];
+                    const size_t len = hi[AXIS_Q1] - i1;
+
+                    EvalRowDerivsInterleaved(mPlans, op, &in[0], K, N1,
+                                             i1, len, i2, i3, scratch);
+
+                    row.i1     = i1;
+                    row.i2     = i2;
+                    row.i3     = i3;
+                    row.length = len;
+                    row.node   = QFieldIndex(i1, i2, i3, N1, N2);
+                    row.q1     = &mQ1Coords[i1];
+                    row.q2     = mQ2Coords[i2];
+                    row.q3     = mQ3Coords[i3];
+
+                    for (unsigned k = 0; k < K; ++k){
+                        for (size_t e = 0; e < fieldD.size(); ++e){
+                            const double * src = scratch.d[e];
+
+                            if (src == NULL){
+                                fieldD[e] = NULL;
+                                continue;
+                            }
+
+                            double * dst = &fieldValues[e * len];
+
+                            for (size_t j = 0; j < len; ++j){
+                                dst[j] = src[j*K + k];
+                            }
+                            fieldD[e] = dst;
+                        }
+
+                        for (unsigned c = 0; c < ncomp; ++c){
+                            scratch.out[c] = out + (row.node * K + k) * ncomp
+                                                 + c;
+                        }
+
+                        op.combineRow(row, &fieldD[0], &scratch.out[0],
+                                      (ptrdiff_t) (K * ncomp));
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+void FieldEngine::execute (const FieldGraph &  graph,
+                           const unsigned   &   slab) const
+{
+    /* If arguments invalid, throw exception. */
+    if (slab == 0){
+        throw std::invalid_argument("slab == 0");
+    }
+
+    const size_t nn = graph.nodes();
+
+    for (size_t v = 0; v < nn; ++v){
+        const GraphNode & n = graph.node(v);
+
+        if (n.kind == GRAPH_OPERATOR){
+            CheckOperator(*n.op, mPlans);
+        }
+    }
+
+    const size_t     N1    = n1(),
+                     N2    = n2(),
+                     N3    = n3();
+    const size_t     plane = N1 * N2;
+    const AxisPlan & p3    = mPlans[AXIS_Q3];
+    const size_t     t1    = TileLayout(mConfig, N1, N2, N3).t[AXIS_Q1];
+
+    /* Consumers of every field and numbers of planes kept in rings of
+     * intermediate fields: plane z of a field can be overwritten once
+     * every consumer evaluated all planes depending on it. */
+    std::vector< std::vector<size_t> > consumers(nn);
+    std::vector<size_t>                ring(nn, slab + 1);
+
+    for (size_t v = 0; v < nn; ++v){
+        const GraphNode & n    = graph.node(v);
+        const size_t      need = (n.kind == GRAPH_OPERATOR)
+                                     ? p3.width() + slab + 1 : slab + 1;
+
+        for (size_t j = 0; j < n.inputs.size(); ++j){
+            consumers[n.inputs[j]].push_back(v);
+            ring[n.inputs[j]] = std::max(ring[n.inputs[j]], need);
+        }
+    }
+
+    size_t total = 0;
+
+    for (size_t v = 0; v < nn; ++v){
+        const GraphNode & n = graph.node(v);
+
+        if (n.kind != GRAPH_INPUT && n.kind != GRAPH_REDUCTION &&
+            n.out == NULL){
+            total += std::min(ring[v], N3) * plane * n.components;
+        }
+    }
+
+    /* Plane pointers of every field; partial sums of reductions (one per
+     * row). */
+    std::vector<double>                buffer(total);
+    std::vector<const double *>        src(nn * N3, (const double *) NULL);
+    std::vector<double *>              dst(nn * N3, (double *) NULL);
+    std::vector< std::vector<double> > partial(nn);
+
+    for (size_t v = 0, offset = 0; v < nn; ++v){
+        const GraphNode & n  = graph.node(v);
+        const size_t      ps = plane * n.components;
+
+        if (n.kind == GRAPH_REDUCTION){
+            partial[v].assign(N2 * N3, 0.0);
+            continue;
+        }
+
+        for (size_t i3 = 0; i3 < N3; ++i3){
+            if (n.kind == GRAPH_INPUT){
+                src[v*N3 + i3] = n.data + i3 * ps;
+                continue;
+            }
+
+            dst[v*N3 + i3] = (n.out != NULL)
+                                 ? n.out + i3 * ps
+                                 : &buffer[offset + (i3 % ring[v]) * ps];
+            src[v*N3 + i3] = dst[v*N3 + i3];
+        }
+
+        if (n.kind != GRAPH_INPUT && n.out == NULL){
+            offset += std::min(ring[v], N3) * ps;
+        }
+    }
+
+    #pragma omp parallel num_threads(threadCount())
+    {
+        std::vector<RowScratch>     scratch;
+        std::vector<size_t>         scratchOf(nn, 0);
+        std::vector<const double *> in;
+        std::vector<unsigned>       comps;
+        RowContext                  row;
+
+        for (size_t v = 0; v < nn; ++v){
+            if (graph.node(v).kind == GRAPH_OPERATOR){
+                scratchOf[v] = scratch.size();
+                scratch.push_back(RowScratch(*graph.node(v).op, t1));
+            }
+        }
+
+        /* Number of planes done for every node and planes evaluated in
+         * a round (pairs of node and plane). Every thread follows the
+         * same (deterministic) schedule, as in applySteps(). */
+        std::vector<size_t> done(nn, 0), next(nn, 0), tasks;
+        bool                finished = false;
+
+        for (size_t v = 0; v < nn; ++v){
+            if (graph.node(v).kind == GRAPH_INPUT){
+                done[v] = N3;
+            }
+        }
+
+        while (!finished){
+            tasks.clear();
+
+            for (size_t v = 0; v < nn; ++v){
+                const GraphNode & n = graph.node(v);
+
+                next[v] = done[v];
+
+                for (size_t z = done[v]; z < N3 && z < done[v] + slab; ++z){
+                    /* Inputs of the plane have to be available. */
+                    const size_t last = (n.kind == GRAPH_OPERATOR)
+                                            ? p3.start(z) + p3.width()
+                                            : z + 1;
+                    bool         ready = true;
+
+                    for (size_t j = 0; j < n.inputs.size(); ++j){
+                        ready = ready && done[n.inputs[j]] >= last;
+                    }
+
+                    /* Its ring slot cannot be needed by consumers
+                     * anymore. */
+                    for (size_t j = 0; j < consumers[v].size() &&
+                                       n.out == NULL; ++j){
+                        const size_t c = consumers[v][j];
+
+                        if (done[c] < N3){
+                            const size_t first =
+                                (graph.node(c).kind == GRAPH_OPERATOR)
+                                    ? p3.start(done[c]) : done[c];
+
+                            ready = ready && z < first + ring[v];
+                        }
+                    }
+
+                    if (!ready){
+                        break;
+                    }
+
+                    tasks.push_back(v);
+                    tasks.push_back(z);
+                    next[v] = z + 1;
+                }
+            }
+
+            const long nt = (long) (tasks.size() / 2 * N2);
+
+            #pragma omp for schedule(static)
+            for (long k = 0; k < nt; ++k){
+                const size_t      t  = 2 * ((size_t) k / N2);
+                const size_t      v  = tasks[t],
+                                  z  = tasks[t+1],
+                                  i2 = (size_t) k % N2;
+                const GraphNode & n  = graph.node(v);
+                const unsigned    nc = n.components;
+
+                if (n.kind == GRAPH_OPERATOR){
+                    RowScratch           & s   = scratch[scratchOf[v]];
+                    const double * const * pin = &src[n.inputs[0] * N3];
+
+                    for (size_t lo1 = 0; lo1 < N1; lo1 += t1){
+                        const size_t len = std::min(t1, N1 - lo1);
+
+                        EvalRowDerivs<double, true>(mPlans, *n.op, pin,
+                                                    1, (ptrdiff_t) N1,
+                                                    lo1, len, i2, z,
+                                                    mConfig.kernel, s);
+
+                        row.i1     = lo1;
+                        row.i2     = i2;
+                        row.i3     = z;
+                        row.length = len;
+                        row.node   = QFieldIndex(lo1, i2, z, N1, N2);
+                        row.q1     = &mQ1Coords[lo1];
+                        row.q2     = mQ2Coords[i2];
+                        row.q3     = mQ3Coords[z];
+
+                        for (unsigned c = 0; c < nc; ++c){
+                            s.out[c] = dst[v*N3 + z] + (lo1 + N1*i2) * nc + c;
+                        }
+
+                        n.op->combineRow(row, &s.d[0], &s.out[0],
+                                         (ptrdiff_t) nc);
+                    }
+                }
+                else if (n.kind == GRAPH_STAGE){
+                    in   .resize(n.inputs.size());
+                    comps.resize(n.inputs.size());
+
+                    for (size_t j = 0; j < n.inputs.size(); ++j){
+                        const size_t u = n.inputs[j];
+
+                        comps[j] = graph.node(u).components;
+                        in[j]    = src[u*N3 + z] + N1 * i2 * comps[j];
+                    }
+
+                    row.i1     = 0;
+                    row.i2     = i2;
+                    row.i3     = z;
+                    row.length = N1;
+                    row.node   = QFieldIndex(0, i2, z, N1, N2);
+                    row.q1     = &mQ1Coords[0];
+                    row.q2     = mQ2Coords[i2];
+                    row.q3     = mQ3Coords[z];
+
+                    n.stage->combineRow(row, &in[0], &comps[0],
+                                        dst[v*N3 + z] + N1 * i2 * nc);
+                }
+                else {
+                    const unsigned m = graph.node(n.inputs[0]).components;
+                    const double * p = src[n.inputs[0]*N3 + z]
+                                     + N1 * i2 * m + n.component;
+                    double         a = 0.0;
+
+                    for (size_t i1 = 0; i1 < N1; ++i1){
+                        a += p[i1 * m];
+                    }
+                    partial[v][z*N2 + i2] = a;
+                }
+            }
+
+            finished = true;
+
+            for (size_t v = 0; v < nn; ++v){
+                done[v]  = next[v];
+                finished = finished && done[v] == N3;
+            }
+        }
+    }
+
+    /* Partial sums of reductions added in a fixed order. */
+    for (size_t v = 0; v < nn; ++v){
+        const GraphNode & n = graph.node(v);
+
+        if (n.kind == GRAPH_REDUCTION){
+            double a = 0.0;
+
+            for (size_t r = 0; r < partial[v].size(); ++r){
+                a += partial[v][r];
+            }
+            *n.out = a;
+        }
+    }
+}
+
+} /* namespace GridDiff */
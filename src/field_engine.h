@@ -0,0 +1,631 @@
+/*
+ * File: field_engine.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing FieldEngine class used for evaluating
+ * differential operators (described by FieldOperator child classes) at all
+ * nodes of a tensor grid spanned by q1, q2 and q3 axes. Fields are stored
+ * in the memory layout described in qobj.h header file.
+ */
+
+#ifndef GRIDDIFF_FIELD_ENGINE_H
+#define GRIDDIFF_FIELD_ENGINE_H
+
+#include "qobj.h"            /* QGrid, QFieldIndex */
+#include "axis_plan.h"       /* AxisPlan */
+#include "field_operator.h"  /* FieldOperator */
+
+namespace GridDiff
+{
+
+class BrickedField;
+class FieldGraph;
+
+/*
+ * Kernels used for derivatives along q2 and q3 axes (see
+ * FieldEngineConfig struct).
+ */
+enum FieldKernel
+{
+    FIELD_KERNEL_ACCUMULATE,  /* rows of stencil nodes accumulated one by
+                                 one into derivative rows */
+    FIELD_KERNEL_DOT          /* derivative at every node evaluated as
+                                 a single dot product */
+};
+
+/*
+ * FieldEngineConfig struct
+ *
+ * Tuning parameters of FieldEngine. None of them changes results.
+ */
+struct FieldEngineConfig
+{
+    /* Tile extents along q1, q2 and q3 axes (0 means whole axis). Tiles
+     * are distributed between threads in contiguous chunks. */
+    size_t      tile1, tile2, tile3;
+    /* Number of threads (0 means OpenMP default). */
+    unsigned    threads;
+    /* If true, applySteps() applies all steps in a single wavefront sweep
+     * through the field. */
+    bool        temporalBlocking;
+    /* Kernel used along q2 and q3 axes. */
+    FieldKernel kernel;
+
+    FieldEngineConfig ()
+        : tile1(0), tile2(8), tile3(1), threads(0), temporalBlocking(true),
+          kernel(FIELD_KERNEL_ACCUMULATE) { }
+};
+
+/*
+ * Value types of fields accepted through FieldView struct.
+ */
+enum FieldValueType
+{
+    FIELD_FLOAT64,
+    FIELD_FLOAT32
+};
+
+/*
+ * FieldView struct
+ *
+ * Describes a field stored in external memory: values of given type, with
+ * value at (i1,i2,i3) node found at data[i1*strides[0] + i2*strides[1] +
+ * i3*strides[2]] (strides are given in values, not bytes, and can be
+ * negative). Allows evaluating operators on arrays owned by other
+ * libraries (e.g. NumPy arrays) without copying them.
+ */
+struct FieldView
+{
+    const void     * data;
+    FieldValueType   type;
+    ptrdiff_t        strides[3];
+};
+
+/*
+ * FieldEngine class
+ *
+ * Holds grid point positions along q1, q2 and q3 axes and coefficient
+ * plans for each axis (see axis_plan.h header file). Evaluates given
+ * operators at every grid node, using stencils of fixed width (shifted
+ * inwards near grid boundaries).
+ *
+ * Operators are evaluated row by row (rows are segments of grid nodes along
+ * q1 axis). Partial derivatives along q2 and q3 axes are evaluated for the
+ * whole row at once, since coefficients are constant along it.
+ *
+ * All evaluation methods are const and can be called concurrently.
+ */
+class FieldEngine
+{
+    protected:
+        /* Grid point coordinates at qi axis (i=1,2,3). */
+        QGrid             mQ1Coords,
+                          mQ2Coords,
+                          mQ3Coords;
+        /* Coefficient plans for q1, q2 and q3 axes. */
+        AxisPlan          mPlans[3];
+        /* Tuning parameters. */
+        FieldEngineConfig mConfig;
+
+        /*
+         * applyView()
+         *
+         * Implementation of apply() for fields of values of type T with
+         * given strides (strides[0] is assumed to be 1 if UNIT is true).
+         * Component c of node n is stored at out[c][n*ostride].
+         */
+        template <class T, bool UNIT>
+        void applyView (const FieldOperator &       op,
+                        const T             *        f,
+                        const ptrdiff_t     * strides,
+                        double * const      *      out,
+                        const ptrdiff_t     & ostride) const;
+
+        /*
+         * applyWavefront()
+         *
+         * Applies steps (at least 2) updates of a step operator (see
+         * applySteps()) in a single wavefront sweep along q3 axis, tile by
+         * tile (q1-q2 tiles of overlapping halos, see applySteps()).
+         */
+        void applyWavefront (const FieldOperator &  step,
+                             const unsigned      & steps,
+                             const double        *     f,
+                             double              *   out) const;
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Constructor
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const QGrid & q1Coords
+         * const QGrid & q2Coords
+         * const QGrid & q3Coords
+         *     Grid point positions along axes q1, q2 and q3. For each axis
+         *     those positions have to be strictly increasing.
+         *
+         * const unsigned & width
+         *     Number of grid points used for every stencil.
+         *
+         * const unsigned & maxOrder
+         *     Highest derivative order of evaluated operators.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * width <= maxOrder
+         *     * Any of qiCoords is of size < width
+         *     * Any of qiCoords is not strictly increasing
+         */
+        FieldEngine (const QGrid    & q1Coords,
+                     const QGrid    & q2Coords,
+                     const QGrid    & q3Coords,
+                     const unsigned &    width,
+                     const unsigned & maxOrder);
+
+        /*
+         * Constructor
+         *
+         * Uses prebuilt coefficient plans (e.g. shared by many grids with
+         * the same axes).
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const QGrid & q1Coords
+         * const QGrid & q2Coords
+         * const QGrid & q3Coords
+         *     Grid point positions along axes q1, q2 and q3.
+         *
+         * const AxisPlan * plans
+         *     Plans of q1, q2 and q3 axes, built for given positions.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * Size of any plan differs from the number of grid points
+         *     * Plans have different max orders
+         */
+        FieldEngine (const QGrid    & q1Coords,
+                     const QGrid    & q2Coords,
+                     const QGrid    & q3Coords,
+                     const AxisPlan *    plans);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /* Number of grid points along q1, q2 and q3 axes. */
+        size_t n1 () const { return mQ1Coords.size(); }
+        size_t n2 () const { return mQ2Coords.size(); }
+        size_t n3 () const { return mQ3Coords.size(); }
+
+        /* Total number of grid points. */
+        size_t size () const { return n1() * n2() * n3(); }
+
+        /* Grid point positions along given axis (AXIS_Q1, AXIS_Q2 or
+         * AXIS_Q3). */
+        const QGrid & coords (const unsigned & axis) const;
+
+        /* Coefficient plan of given axis (AXIS_Q1, AXIS_Q2 or AXIS_Q3). */
+        const AxisPlan & plan (const unsigned & axis) const
+        {
+            return mPlans[axis];
+        }
+
+        /* Tuning parameters. */
+        const FieldEngineConfig & config () const { return mConfig; }
+        void setConfig (const FieldEngineConfig & config) { mConfig = config; }
+
+        /* Number of threads used for evaluation. */
+        int threadCount () const;
+
+        /*
+         * firstTouch()
+         *
+         * Sets all values of a newly allocated field to zero, distributing
+         * tiles between threads exactly as apply() does. On NUMA systems
+         * (with first-touch page placement) memory pages of every tile are
+         * then placed at the node of the thread which evaluates it.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * double * f
+         *     Field of components*size() values (all components of a node
+         *     stored consecutively).
+         *
+         * const unsigned & components
+         *     Number of values per grid node.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * None.
+         */
+        void firstTouch (double         *          f,
+                         const unsigned & components) const;
+
+        /*
+         * apply()
+         *
+         * Evaluates operator at every grid node.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const FieldOperator & op
+         *     Evaluated operator.
+         *
+         * const double * f
+         *     Function values at grid nodes (size() values).
+         *
+         * double * out
+         *     Array receiving op.components()*size() values. All components
+         *     of a node are stored consecutively.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if operator order is higher than the one
+         * given in constructor, or operator does not fit the grid (see
+         * FieldOperator::fits()).
+         */
+        void apply (const FieldOperator & op,
+                    const double        *  f,
+                    double              * out) const;
+
+        /*
+         * apply()
+         *
+         * Evaluates operator at every grid node of a field described by
+         * a view (float or double values, arbitrary strides). Results are
+         * the same as for a contiguous copy of the field.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const FieldOperator & op
+         *     Evaluated operator.
+         *
+         * const FieldView & f
+         *     Function values at grid nodes.
+         *
+         * double * out
+         *     Array receiving op.components()*size() values. All components
+         *     of a node are stored consecutively.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if operator order is higher than the one
+         * given in constructor, or operator does not fit the grid (see
+         * FieldOperator::fits()).
+         */
+        void apply (const FieldOperator & op,
+                    const FieldView     &  f,
+                    double              * out) const;
+
+        /*
+         * applyComponents()
+         *
+         * Evaluates operator at every grid node, like apply(), but every
+         * component is stored in a separate array (structure of arrays),
+         * e.g. df/dq1, df/dq2 and df/dq3 of a gradient in three arrays.
+         * Rows of every component are then written contiguously, which
+         * lets compilers vectorize stores of operators (with unaligned
+         * store instructions, so arrays need no particular alignment;
+         * arrays aligned to 64 bytes with n1() a multiple of the vector
+         * length avoid stores split between cache lines). Results are the
+         * same as those of apply().
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const FieldOperator & op
+         *     Evaluated operator.
+         *
+         * const double * f
+         *     Function values at grid nodes (size() values).
+         *
+         * double * const * out
+         *     op.components() arrays receiving size() values each.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if operator order is higher than the one
+         * given in constructor, or operator does not fit the grid (see
+         * FieldOperator::fits()).
+         */
+        void applyComponents (const FieldOperator &   op,
+                              const double        *    f,
+                              double * const      *  out) const;
+
+        /*
+         * apply()
+         *
+         * Evaluates operator at every grid node of a field stored in the
+         * bricked layout (see bricked_field.h header file). Bricks are
+         * distributed between threads in storage (Morton) order; all
+         * stencil nodes of a brick are read from its padded box. Results
+         * are the same as for the default layout. Ghost layers of output
+         * are not set.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const FieldOperator & op
+         *     Evaluated operator.
+         *
+         * const BrickedField & f
+         *     Function values at grid nodes (with up-to-date ghost layers).
+         *
+         * BrickedField & out
+         *     Field of op.components() components receiving results.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * Operator order is higher than the one given in constructor
+         *     * Operator does not fit the grid (see FieldOperator::fits())
+         *     * f or out do not match the grid, or have different bricks
+         *     * Ghost layers or bricks are too small for stencils
+         *     * f has more than one component, or out has other number of
+         *       components than the operator
+         *     * f and out are the same
+         */
+        void apply (const FieldOperator &  op,
+                    const BrickedField  &   f,
+                    BrickedField        & out) const;
+
+        /*
+         * applySteps()
+         *
+         * Applies steps explicit updates
+         *
+         *     f <- f + alpha * Lf
+         *
+         * of a scalar operator L (e.g. Jacobi-like smoothing or explicit
+         * Euler time stepping of diffusion equation).
+         *
+         * If temporal blocking is enabled (see FieldEngineConfig), steps
+         * are performed in wavefront sweeps along q3 axis: a plane of step
+         * s is evaluated as soon as all planes of step s-1 it depends on
+         * are available. Sweeps are done separately for q1-q2 tiles, every
+         * thread keeping (steps-1)*(width+1) planes of intermediate
+         * results of its tile in a ring of at most 1 MB (about a per-core
+         * L2 cache). Step s covers the tile extended by a halo of the
+         * stencil reach of the remaining steps, which neighbouring tiles
+         * recompute. The field is then read from and written to main
+         * memory once instead of once per step.
+         *
+         * Tiles are whole planes if rings of whole planes fit (e.g. grids
+         * of up to about 70x70 nodes in q1-q2 planes for 5 steps of
+         * width 5). For larger planes they are reduced, but not below four
+         * halo widths, so recomputation adds at most about 60% to the
+         * work; if rings of such tiles do not fit, steps are swept in
+         * groups of fewer steps (halos grow with the number of steps),
+         * down to separate sweeps. Blocking pays off for fields much larger
+         * than the last level cache, if evaluation is memory-bound (many
+         * threads); all methods give identical results.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const FieldOperator & op
+         *     Evaluated operator. Has to be scalar.
+         *
+         * const double & alpha
+         *     Step length.
+         *
+         * const unsigned & steps
+         *     Number of steps.
+         *
+         * const double * f
+         *     Function values at grid nodes (size() values).
+         *
+         * double * out
+         *     Array receiving size() values after all steps. Cannot be the
+         *     same as f.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * Operator order is higher than the one given in constructor
+         *     * Operator does not fit the grid (see FieldOperator::fits())
+         *     * Operator is not scalar
+         *     * f and out are the same
+         */
+        void applySteps (const FieldOperator &    op,
+                         const double        & alpha,
+                         const unsigned      & steps,
+                         const double        *     f,
+                         double              *   out) const;
+
+        /*
+         * execute()
+         *
+         * Executes all nodes of a graph (see field_graph.h header file) in
+         * a single wavefront sweep along q3 axis, like applySteps() does:
+         * in every round, each node evaluates up to slab q3 planes whose
+         * inputs are already available, and planes of all nodes evaluated
+         * in a round are distributed between threads together (so
+         * independent nodes run concurrently). Intermediate fields are kept
+         * in rings of a few planes (slab+width+1 at most), which are read
+         * by consumer nodes shortly after they were written, while they
+         * are still in cache. Results are the same as those of separate
+         * apply() calls and pointwise passes.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const FieldGraph & graph
+         *     Executed graph. Every input field has to have size() nodes.
+         *
+         * const unsigned & slab
+         *     Maximum number of planes evaluated per node in a round.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * Order of any operator is higher than the one given in
+         *       constructor
+         *     * Any operator does not fit the grid (see
+         *       FieldOperator::fits())
+         *     * slab is 0
+         */
+        void execute (const FieldGraph &  graph,
+                      const unsigned   &   slab = 2) const;
+
+        /*
+         * derivative()
+         *
+         * Evaluates a (possibly mixed) partial derivative
+         *
+         *     d^(k1+k2+k3) f / dq1^k1 dq2^k2 dq3^k3
+         *
+         * at every grid node. Its stencil is the tensor product of axis
+         * stencils, but it is applied by sum factorization: one pass of 1D
+         * stencils per axis with nonzero order, so a node costs at most
+         * 3*width operations instead of width^2 (or width^3).
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const unsigned * orders
+         *     Derivative orders k1, k2 and k3.
+         *
+         * const double * f
+         *     Function values at grid nodes (size() values).
+         *
+         * double * out
+         *     Array receiving size() values. Cannot be the same as f.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * Any order is higher than the one given in constructor
+         *     * f and out are the same
+         */
+        void derivative (const unsigned * orders,
+                         const double   *      f,
+                         double         *    out) const;
+
+        /*
+         * hessian()
+         *
+         * Evaluates all second partial derivatives at every grid node (see
+         * derivative()). Derivatives along q1 and q2 are shared between
+         * mixed derivatives.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const double * f
+         *     Function values at grid nodes (size() values).
+         *
+         * double * out
+         *     Array receiving 6*size() values: for every node d2f/dq1^2,
+         *     d2f/dq2^2, d2f/dq3^2, d2f/dq1dq2, d2f/dq1dq3 and d2f/dq2dq3
+         *     are stored consecutively. Cannot overlap f.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if order given in constructor is lower
+         * than 2.
+         */
+        void hessian (const double *   f,
+                      double       * out) const;
+
+        /*
+         * applyBatch()
+         *
+         * Evaluates operator for K fields stored in separate arrays. Every
+         * row is evaluated for all fields before moving on, so tile
+         * traversal is done once and coefficients stay in cache. Results
+         * are the same as those of K apply() calls.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const FieldOperator & op
+         *     Evaluated operator.
+         *
+         * const unsigned & K
+         *     Number of fields.
+         *
+         * const double * const * f
+         *     K arrays of function values at grid nodes.
+         *
+         * double * const * out
+         *     K arrays receiving op.components()*size() values (as for
+         *     apply()).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if operator order is higher than the one
+         * given in constructor, or operator does not fit the grid (see
+         * FieldOperator::fits()).
+         */
+        void applyBatch (const FieldOperator &    op,
+                         const unsigned      &     K,
+                         const double * const *    f,
+                         double       * const *  out) const;
+
+        /*
+         * applyInterleaved()
+         *
+         * Evaluates operator for K fields stored interleaved: K values
+         * (one per field) for every grid node. Stencils are applied to all
+         * fields at once, with loops over fields innermost (so they
+         * vectorize). Results are the same as those of K apply() calls.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const FieldOperator & op
+         *     Evaluated operator.
+         *
+         * const unsigned & K
+         *     Number of fields.
+         *
+         * const double * f
+         *     K*size() values; value of field k at node n is f[n*K + k].
+         *
+         * double * out
+         *     Array receiving K*op.components()*size() values; component c
+         *     of field k at node n is out[(n*K + k)*op.components() + c].
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if operator order is higher than the one
+         * given in constructor, or operator does not fit the grid (see
+         * FieldOperator::fits()).
+         */
+        void applyInterleaved (const FieldOperator &  op,
+                               const unsigned      &   K,
+                               const double        *   f,
+                               double              * out) const;
+
+}; /* class FieldEngine */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_FIELD_ENGINE_H */
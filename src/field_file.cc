@@ -0,0 +1,677 @@
+/*
+ * File: field_file.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing WriteFieldFile function and FieldFile class
+ * methods implementation (declared in field_file.h header file).
+ */
+
+#include "field_file.h"
+
+#include <algorithm>   /* std::min, std::max */
+#include <cmath>       /* fabs, floor */
+#include <cstring>     /* memcpy */
+#include <stdexcept>   /* std::invalid_argument, std::runtime_error */
+
+#include <errno.h>     /* errno, EINTR */
+#include <fcntl.h>     /* open */
+#include <stdint.h>    /* uint8_t, uint32_t, uint64_t, int64_t */
+#include <unistd.h>    /* pread, pwrite, close */
+
+namespace GridDiff
+{
+
+namespace
+{
+
+/* File identification ("GDFF") and format version. */
+const uint64_t FIELD_FILE_MAGIC   = 0x46464447ULL;
+const uint64_t FIELD_FILE_VERSION = 1;
+
+/* Number of 64-bit words in file header. */
+const size_t   HEADER_WORDS       = 12;
+
+/* Chunk codecs (first byte of every chunk). */
+enum
+{
+    CODEC_RAW       = 0,  /* values stored as they are */
+    CODEC_SHUFFLE   = 1,  /* byte shuffle + LZ */
+    CODEC_QUANTIZED = 2   /* quantization + delta + byte shuffle + LZ */
+};
+
+/* LZ parameters: minimal match length, hash table size and window. */
+const size_t   LZ_MIN_MATCH = 4;
+const unsigned LZ_HASH_BITS = 14;
+const size_t   LZ_WINDOW    = 65535;
+
+typedef std::vector<uint8_t> Bytes;
+
+
+/*
+ * Shuffle(), Unshuffle()
+ *
+ * Transposes n elements of 8 bytes, so that all first bytes are stored
+ * first, then all second bytes, etc. Slowly changing values have many
+ * equal high bytes, which are then grouped together.
+ */
+void Shuffle (const uint8_t * in, uint8_t * out, const size_t & n)
+{
+    for (size_t b = 0; b < 8; ++b){
+        for (size_t i = 0; i < n; ++i){
+            out[b*n + i] = in[i*8 + b];
+        }
+    }
+}
+
+void Unshuffle (const uint8_t * in, uint8_t * out, const size_t & n)
+{
+    for (size_t b = 0; b < 8; ++b){
+        for (size_t i = 0; i < n; ++i){
+            out[i*8 + b] = in[b*n + i];
+        }
+    }
+}
+
+
+/*
+ * Writes a length in LZ variable-length format (continuation bytes of 255
+ * terminated by a byte < 255).
+ */
+void PutLength (Bytes & out, size_t len)
+{
+    while (len >= 255){
+        out.push_back(255);
+        len -= 255;
+    }
+    out.push_back((uint8_t) len);
+}
+
+uint32_t Read32 (const uint8_t * p)
+{
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/*
+ * LzCompress()
+ *
+ * Appends compressed data to out. Data is encoded as a sequence of
+ * (literals, match) pairs: a token byte (literal count in high nibble,
+ * match length minus LZ_MIN_MATCH in low nibble; 15 means that the length
+ * continues in following bytes), literals, 16-bit match offset and match
+ * length continuation. The last sequence has literals only.
+ */
+void LzCompress (const uint8_t * in, const size_t & n, Bytes & out)
+{
+    std::vector<size_t> table((size_t) 1 << LZ_HASH_BITS, 0);
+
+    size_t ip     = 0;
+    size_t anchor = 0;
+
+    while (ip + LZ_MIN_MATCH <= n){
+        const uint32_t seq  = Read32(in + ip);
+        const size_t   h    = (seq * 2654435761U) >> (32 - LZ_HASH_BITS);
+        const size_t   ref  = table[h];   /* position + 1, 0 if empty */
+
+        table[h] = ip + 1;
+
+        if (ref == 0 || ip + 1 - ref > LZ_WINDOW || Read32(in + ref - 1) != seq){
+            ++ip;
+            continue;
+        }
+
+        /* Extending the match. */
+        const size_t r   = ref - 1;
+        size_t       len = LZ_MIN_MATCH;
+
+        while (ip + len < n && in[r + len] == in[ip + len]){
+            ++len;
+        }
+
+        const size_t lit = ip - anchor;
+        const size_t ml  = len - LZ_MIN_MATCH;
+
+        out.push_back((uint8_t) ((std::min(lit, (size_t) 15) << 4)
+                                | std::min(ml, (size_t) 15)));
+        if (lit >= 15){ PutLength(out, lit - 15); }
+        out.insert(out.end(), in + anchor, in + ip);
+
+        out.push_back((uint8_t) ((ip - r) & 0xff));
+        out.push_back((uint8_t) ((ip - r) >> 8));
+        if (ml >= 15){ PutLength(out, ml - 15); }
+
+        ip    += len;
+        anchor = ip;
+    }
+
+    /* Last literals. */
+    const size_t lit = n - anchor;
+
+    out.push_back((uint8_t) (std::min(lit, (size_t) 15) << 4));
+    if (lit >= 15){ PutLength(out, lit - 15); }
+    out.insert(out.end(), in + anchor, in + n);
+}
+
+/*
+ * Reads a length continuation. Returns false if input ends.
+ */
+bool GetLength (const uint8_t *& ip, const uint8_t * end, size_t & len)
+{
+    uint8_t b;
+    do {
+        if (ip >= end){ return false; }
+        b    = *ip++;
+        len += b;
+    } while (b == 255);
+    return true;
+}
+
+/*
+ * LzDecompress()
+ *
+ * Decompresses data produced by LzCompress into exactly n bytes. Returns
+ * false for corrupted input.
+ */
+bool LzDecompress (const uint8_t * ip, const size_t & bytes,
+                   uint8_t       * out, const size_t & n)
+{
+    const uint8_t * end = ip + bytes;
+    size_t          op  = 0;
+
+    while (ip < end){
+        const uint8_t token = *ip++;
+        size_t        lit   = token >> 4;
+        size_t        ml    = token & 15;
+
+        if (lit == 15 && !GetLength(ip, end, lit)){ return false; }
+        if (lit > (size_t) (end - ip) || lit > n - op){ return false; }
+
+        std::memcpy(out + op, ip, lit);
+        ip += lit;
+        op += lit;
+
+        /* Last sequence has no match. */
+        if (ip == end){ break; }
+
+        if (end - ip < 2){ return false; }
+        const size_t off = ip[0] | ((size_t) ip[1] << 8);
+        ip += 2;
+
+        if (ml == 15 && !GetLength(ip, end, ml)){ return false; }
+        ml += LZ_MIN_MATCH;
+
+        if (off == 0 || off > op || ml > n - op){ return false; }
+
+        /* Byte by byte, since match can overlap copied data. */
+        for (size_t i = 0; i < ml; ++i, ++op){
+            out[op] = out[op - off];
+        }
+    }
+
+    return op == n;
+}
+
+
+/*
+ * EncodeChunk()
+ *
+ * Compresses n values with chosen codec (quantization is used only if
+ * errorBound > 0 and all values can be quantized). Falls back to raw
+ * storage if compression does not reduce size.
+ */
+void EncodeChunk (const double * v, const size_t & n,
+                  const double & errorBound, Bytes & out)
+{
+    const size_t bytes = n * sizeof(double);
+    Bytes        shuffled(bytes);
+
+    out.clear();
+
+    bool quantized = false;
+
+    if (errorBound > 0.0){
+        /* Quantized values are delta encoded and zigzag mapped, so that
+         * small differences have small magnitude. */
+        const double          step = 2.0 * errorBound;
+        std::vector<uint64_t> q(n);
+        int64_t               prev = 0;
+
+        quantized = true;
+
+        for (size_t i = 0; i < n; ++i){
+            const double x = floor(v[i] / step + 0.5);
+
+            /* NaN, inf and huge values cannot be quantized. */
+            if (!(fabs(x) < 2.0e18)){
+                quantized = false;
+                break;
+            }
+
+            const int64_t k = (int64_t) x;
+            const int64_t d = k - prev;
+
+            q[i] = ((uint64_t) d << 1) ^ (uint64_t) (d >> 63);
+            prev = k;
+        }
+
+        if (quantized){
+            Shuffle((const uint8_t *) &q[0], &shuffled[0], n);
+
+            out.push_back(CODEC_QUANTIZED);
+            out.resize(1 + sizeof(double));
+            std::memcpy(&out[1], &step, sizeof(double));
+        }
+    }
+
+    if (!quantized){
+        Shuffle((const uint8_t *) v, &shuffled[0], n);
+        out.push_back(CODEC_SHUFFLE);
+    }
+
+    LzCompress(&shuffled[0], bytes, out);
+
+    /* Lossless compression which does not pay off is replaced with raw
+     * values. */
+    if (!quantized && out.size() >= 1 + bytes){
+        out.resize(1 + bytes);
+        out[0] = CODEC_RAW;
+        std::memcpy(&out[1], v, bytes);
+    }
+}
+
+/*
+ * DecodeChunk()
+ *
+ * Decompresses n values. Returns false for corrupted input.
+ */
+bool DecodeChunk (const Bytes & in, double * v, const size_t & n)
+{
+    const size_t bytes = n * sizeof(double);
+
+    if (in.empty()){ return false; }
+
+    if (in[0] == CODEC_RAW){
+        if (in.size() != 1 + bytes){ return false; }
+        std::memcpy(v, &in[1], bytes);
+        return true;
+    }
+
+    Bytes shuffled(bytes);
+
+    if (in[0] == CODEC_SHUFFLE){
+        if (!LzDecompress(&in[1], in.size() - 1, &shuffled[0], bytes)){
+            return false;
+        }
+        Unshuffle(&shuffled[0], (uint8_t *) v, n);
+        return true;
+    }
+
+    if (in[0] == CODEC_QUANTIZED){
+        double step;
+
+        if (in.size() < 1 + sizeof(double)){ return false; }
+        std::memcpy(&step, &in[1], sizeof(double));
+
+        const size_t head = 1 + sizeof(double);
+        if (!LzDecompress(&in[head], in.size() - head, &shuffled[0], bytes)){
+            return false;
+        }
+
+        std::vector<uint64_t> q(n);
+        Unshuffle(&shuffled[0], (uint8_t *) &q[0], n);
+
+        int64_t k = 0;
+        for (size_t i = 0; i < n; ++i){
+            k   += (int64_t) (q[i] >> 1) ^ -(int64_t) (q[i] & 1);
+            v[i] = k * step;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+
+bool ReadAt (const int & fd, void * buf, size_t bytes, off_t offset)
+{
+    char * p = static_cast<char *>(buf);
+
+    while (bytes > 0){
+        ssize_t r = pread(fd, p, bytes, offset);
+
+        if (r < 0 && errno == EINTR){ continue; }
+        if (r <= 0)                 { return false; }
+
+        p      += r;
+        bytes  -= (size_t) r;
+        offset += r;
+    }
+    return true;
+}
+
+bool WriteAt (const int & fd, const void * buf, size_t bytes, off_t offset)
+{
+    const char * p = static_cast<const char *>(buf);
+
+    while (bytes > 0){
+        ssize_t r = pwrite(fd, p, bytes, offset);
+
+        if (r < 0 && errno == EINTR){ continue; }
+        if (r <= 0)                 { return false; }
+
+        p      += r;
+        bytes  -= (size_t) r;
+        offset += r;
+    }
+    return true;
+}
+
+/*
+ * Copies box [lo,hi) of a field with extents n (ncomp values per node) to
+ * or from a dense array with box extents.
+ */
+void CopyBox (const double * src, const size_t * srcLo, const size_t * srcN,
+              double       * dst, const size_t * dstLo, const size_t * dstN,
+              const size_t * lo,  const size_t * hi,  const size_t & ncomp)
+{
+    const size_t len = (hi[0] - lo[0]) * ncomp;
+
+    for (size_t i3 = lo[2]; i3 < hi[2]; ++i3){
+        for (size_t i2 = lo[1]; i2 < hi[1]; ++i2){
+            const size_t s = ((i3 - srcLo[2]) * srcN[1] + (i2 - srcLo[1]))
+                           * srcN[0] + (lo[0] - srcLo[0]);
+            const size_t d = ((i3 - dstLo[2]) * dstN[1] + (i2 - dstLo[1]))
+                           * dstN[0] + (lo[0] - dstLo[0]);
+
+            std::memcpy(dst + d * ncomp, src + s * ncomp, len * sizeof(double));
+        }
+    }
+}
+
+} /* anonymous namespace */
+
+
+void WriteFieldFile (const std::string      &       path,
+                     const size_t           &         n1,
+                     const size_t           &         n2,
+                     const size_t           &         n3,
+                     const unsigned         & components,
+                     const double           *       data,
+                     const FieldFileOptions &    options)
+{
+    /* If one of arguments is invalid, throw exception. */
+    if (n1 == 0 || n2 == 0 || n3 == 0 || components == 0){
+        throw std::invalid_argument("zero field size");
+    }
+
+    if (options.chunk1 == 0 || options.chunk2 == 0 || options.chunk3 == 0){
+        throw std::invalid_argument("zero chunk size");
+    }
+
+    if (!(options.errorBound >= 0.0)){
+        throw std::invalid_argument("negative error bound");
+    }
+
+    const size_t N[3]  = { n1, n2, n3 };
+    const size_t C[3]  = { options.chunk1, options.chunk2, options.chunk3 };
+    const size_t NC[3] = { (n1 + C[0] - 1) / C[0],
+                           (n2 + C[1] - 1) / C[1],
+                           (n3 + C[2] - 1) / C[2] };
+    const size_t zero[3] = { 0, 0, 0 };
+    const long   nchunks = (long) (NC[0] * NC[1] * NC[2]);
+
+    /* Compressing chunks. */
+    std::vector<Bytes> chunks(nchunks);
+
+    #pragma omp parallel
+    {
+        std::vector<double> values;
+
+        #pragma omp for schedule(dynamic)
+        for (long c = 0; c < nchunks; ++c){
+            const size_t b[3] = { (size_t) c % NC[0],
+                                  ((size_t) c / NC[0]) % NC[1],
+                                  (size_t) c / (NC[0] * NC[1]) };
+            size_t lo[3], hi[3], ext[3];
+
+            for (unsigned a = 0; a < 3; ++a){
+                lo[a]  = b[a] * C[a];
+                hi[a]  = std::min(lo[a] + C[a], N[a]);
+                ext[a] = hi[a] - lo[a];
+            }
+
+            values.resize(ext[0] * ext[1] * ext[2] * components);
+            CopyBox(data, zero, N, &values[0], lo, ext, lo, hi, components);
+
+            EncodeChunk(&values[0], values.size(), options.errorBound,
+                        chunks[c]);
+        }
+    }
+
+    /* Writing header, chunks and chunk index. */
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0){
+        throw std::runtime_error("cannot open field file for writing");
+    }
+
+    std::vector<uint64_t> index(2 * nchunks);
+    uint64_t              offset = HEADER_WORDS * sizeof(uint64_t);
+    bool                  ok     = true;
+
+    for (long c = 0; c < nchunks && ok; ++c){
+        ok = WriteAt(fd, &chunks[c][0], chunks[c].size(), (off_t) offset);
+
+        index[2*c]     = offset;
+        index[2*c + 1] = chunks[c].size();
+        offset        += chunks[c].size();
+    }
+
+    uint64_t header[HEADER_WORDS] = { 0 };
+
+    header[0]  = FIELD_FILE_MAGIC | (FIELD_FILE_VERSION << 32);
+    header[1]  = n1;
+    header[2]  = n2;
+    header[3]  = n3;
+    header[4]  = components;
+    header[5]  = C[0];
+    header[6]  = C[1];
+    header[7]  = C[2];
+    header[8]  = (uint64_t) nchunks;
+    header[9]  = offset;
+    std::memcpy(&header[10], &options.errorBound, sizeof(double));
+
+    ok = ok && WriteAt(fd, &index[0], index.size() * sizeof(uint64_t),
+                       (off_t) offset);
+    ok = ok && WriteAt(fd, header, sizeof(header), 0);
+
+    if (close(fd) != 0 || !ok){
+        throw std::runtime_error("cannot write field file");
+    }
+}
+
+
+FieldFile::FieldFile (const std::string & path)
+{
+    mFd = open(path.c_str(), O_RDONLY);
+    if (mFd < 0){
+        throw std::runtime_error("cannot open field file");
+    }
+
+    uint64_t header[HEADER_WORDS];
+
+    if (!ReadAt(mFd, header, sizeof(header), 0) ||
+        header[0] != (FIELD_FILE_MAGIC | (FIELD_FILE_VERSION << 32))){
+        close(mFd);
+        throw std::runtime_error("not a field file (or unsupported version)");
+    }
+
+    for (unsigned a = 0; a < 3; ++a){
+        mN[a]      = header[1 + a];
+        mChunk[a]  = header[5 + a];
+        mChunks[a] = mChunk[a] ? (mN[a] + mChunk[a] - 1) / mChunk[a] : 0;
+    }
+    mComponents = (unsigned) header[4];
+
+    const size_t nchunks = mChunks[0] * mChunks[1] * mChunks[2];
+
+    if (nchunks == 0 || nchunks != header[8] || mComponents == 0){
+        close(mFd);
+        throw std::runtime_error("corrupted field file header");
+    }
+
+    std::vector<uint64_t> index(2 * nchunks);
+
+    if (!ReadAt(mFd, &index[0], index.size() * sizeof(uint64_t),
+                (off_t) header[9])){
+        close(mFd);
+        throw std::runtime_error("cannot read field file index");
+    }
+
+    mOffsets.resize(nchunks);
+    mBytes.resize(nchunks);
+    for (size_t c = 0; c < nchunks; ++c){
+        mOffsets[c] = index[2*c];
+        mBytes[c]   = index[2*c + 1];
+    }
+}
+
+
+FieldFile::~FieldFile ()
+{
+    close(mFd);
+}
+
+
+unsigned long long FieldFile::compressedBytes () const
+{
+    unsigned long long total = 0;
+
+    for (size_t c = 0; c < mBytes.size(); ++c){
+        total += mBytes[c];
+    }
+    return total;
+}
+
+
+void FieldFile::chunkBox (const size_t & chunk, size_t * lo, size_t * hi) const
+{
+    const size_t b[3] = { chunk % mChunks[0],
+                          (chunk / mChunks[0]) % mChunks[1],
+                          chunk / (mChunks[0] * mChunks[1]) };
+
+    for (unsigned a = 0; a < 3; ++a){
+        lo[a] = b[a] * mChunk[a];
+        hi[a] = std::min(lo[a] + mChunk[a], mN[a]);
+    }
+}
+
+
+void FieldFile::readBox (const size_t *  lo,
+                         const size_t *  hi,
+                         double       * out)
+{
+    /* If arguments invalid, throw exception. */
+    for (unsigned a = 0; a < 3; ++a){
+        if (lo[a] >= hi[a]){
+            throw std::invalid_argument("empty box");
+        }
+        if (hi[a] > mN[a]){
+            throw std::invalid_argument("box exceeds grid");
+        }
+    }
+
+    /* Chunks intersecting the box. */
+    std::vector<size_t> needed;
+
+    for (size_t c3 = lo[2] / mChunk[2]; c3 <= (hi[2]-1) / mChunk[2]; ++c3){
+        for (size_t c2 = lo[1] / mChunk[1]; c2 <= (hi[1]-1) / mChunk[1]; ++c2){
+            for (size_t c1 = lo[0] / mChunk[0]; c1 <= (hi[0]-1) / mChunk[0]; ++c1){
+                needed.push_back((c3 * mChunks[1] + c2) * mChunks[0] + c1);
+            }
+        }
+    }
+
+    /* Reusing chunks of the previous request; reading and decompressing
+     * the others (in parallel, if OpenMP is enabled). */
+    std::map< size_t, std::vector<double> > cache;
+    std::vector< std::vector<double> * >     slots(needed.size());
+
+    for (size_t k = 0; k < needed.size(); ++k){
+        std::vector<double> & v = cache[needed[k]];
+        std::map< size_t, std::vector<double> >::iterator it
+                                                = mCache.find(needed[k]);
+        if (it != mCache.end()){
+            v.swap(it->second);
+            slots[k] = NULL;
+        }
+        else {
+            slots[k] = &v;
+        }
+    }
+
+    const long nneeded = (long) needed.size();
+    bool       ok      = true;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (long k = 0; k < nneeded; ++k){
+        if (slots[k] == NULL){ continue; }
+
+        size_t clo[3], chi[3];
+        chunkBox(needed[k], clo, chi);
+
+        const size_t c = needed[k];
+        Bytes        raw(mBytes[c]);
+
+        slots[k]->resize((chi[0]-clo[0]) * (chi[1]-clo[1]) * (chi[2]-clo[2])
+                         * mComponents);
+
+        if (raw.empty() ||
+            !ReadAt(mFd, &raw[0], raw.size(), (off_t) mOffsets[c]) ||
+            !DecodeChunk(raw, &(*slots[k])[0], slots[k]->size())){
+            #pragma omp critical
+            ok = false;
+        }
+    }
+
+    if (!ok){
+        mCache.clear();
+        throw std::runtime_error("cannot read field file chunk");
+    }
+
+    /* Copying intersections to output. */
+    const size_t ext[3] = { hi[0]-lo[0], hi[1]-lo[1], hi[2]-lo[2] };
+
+    for (size_t k = 0; k < needed.size(); ++k){
+        size_t clo[3], chi[3], cext[3], ilo[3], ihi[3];
+        chunkBox(needed[k], clo, chi);
+
+        for (unsigned a = 0; a < 3; ++a){
+            cext[a] = chi[a] - clo[a];
+            ilo[a]  = std::max(clo[a], lo[a]);
+            ihi[a]  = std::min(chi[a], hi[a]);
+        }
+
+        CopyBox(&cache[needed[k]][0], clo, cext, out, lo, ext,
+                ilo, ihi, mComponents);
+    }
+
+    mCache.swap(cache);
+}
+
+
+size_t FieldFile::readSlab (const size_t &   z0,
+                            const size_t &   z1,
+                            const size_t & halo,
+                            double       *  out)
+{
+    const size_t lo[3] = { 0,   0,   z0 > halo ? z0 - halo : 0 };
+    const size_t hi[3] = { mN[0], mN[1], std::min(z1 + halo, mN[2]) };
+
+    readBox(lo, hi, out);
+
+    return lo[2];
+}
+
+} /* namespace GridDiff */
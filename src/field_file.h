@@ -0,0 +1,234 @@
+/*
+ * File: field_file.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing a chunked, compressed file format for fields
+ * (memory layout described in qobj.h header file): WriteFieldFile function
+ * and FieldFile class used for reading arbitrary boxes (e.g. slabs with
+ * halo planes) of stored fields chunk by chunk.
+ */
+
+#ifndef GRIDDIFF_FIELD_FILE_H
+#define GRIDDIFF_FIELD_FILE_H
+
+#include <cstddef>  /* size_t */
+#include <map>      /* std::map */
+#include <string>   /* std::string */
+#include <vector>   /* std::vector */
+
+namespace GridDiff
+{
+
+/*
+ * FieldFileOptions struct
+ *
+ * Parameters of stored fields.
+ */
+struct FieldFileOptions
+{
+    /* Chunk extents along q1, q2 and q3 axes (in grid nodes). */
+    size_t chunk1, chunk2, chunk3;
+    /* Maximal absolute error of stored values. If zero, values are stored
+     * losslessly. Otherwise they are quantized to multiples of
+     * 2*errorBound (chunks with values too large to be quantized are
+     * stored losslessly). */
+    double errorBound;
+
+    FieldFileOptions ()
+        : chunk1(64), chunk2(64), chunk3(16), errorBound(0.0) { }
+};
+
+/*
+ * WriteFieldFile()
+ *
+ * Writes a field to a file. The field is divided into chunks (boxes of
+ * grid nodes), which are compressed independently (in parallel, if OpenMP
+ * is enabled): values are optionally quantized (and delta encoded), then
+ * bytes of every value are shuffled (all first bytes, then all second
+ * bytes, ...) and compressed with an LZ77-type byte-oriented algorithm.
+ * Chunks which do not compress are stored raw.
+ *
+ * File starts with a header (grid and chunk sizes), followed by compressed
+ * chunks and a chunk index (offset and size of every chunk). Values are
+ * stored in host byte order.
+ *
+ * -----------
+ *  Arguments
+ * -----------
+ * const std::string & path
+ *     Output file path (overwritten if exists).
+ *
+ * const size_t & n1
+ * const size_t & n2
+ * const size_t & n3
+ *     Number of grid nodes along q1, q2 and q3 axes.
+ *
+ * const unsigned & components
+ *     Number of values per grid node (stored consecutively).
+ *
+ * const double * data
+ *     Field values (n1*n2*n3*components values).
+ *
+ * const FieldFileOptions & options
+ *     Chunk sizes and error bound.
+ *
+ * ------------
+ *  Exceptions
+ * ------------
+ * std::invalid_argument if any size or chunk size is zero or errorBound
+ * is negative.
+ * std::runtime_error if file cannot be written.
+ */
+void WriteFieldFile (const std::string      &       path,
+                     const size_t           &         n1,
+                     const size_t           &         n2,
+                     const size_t           &         n3,
+                     const unsigned         & components,
+                     const double           *       data,
+                     const FieldFileOptions &    options = FieldFileOptions());
+
+/*
+ * FieldFile class
+ *
+ * Reads fields written by WriteFieldFile function. Only chunks
+ * intersecting requested boxes are read and decompressed. Chunks
+ * decompressed by the previous request are kept, so consecutive slabs
+ * sharing halo planes do not decompress shared chunks twice.
+ */
+class FieldFile
+{
+    protected:
+        /* File descriptor. */
+        int                                    mFd;
+        /* Grid and chunk sizes. */
+        size_t                                 mN[3],
+                                               mChunk[3],
+                                               mChunks[3];
+        /* Number of values per grid node. */
+        unsigned                               mComponents;
+        /* Offsets and compressed sizes of chunks (in bytes). */
+        std::vector<unsigned long long>        mOffsets,
+                                               mBytes;
+        /* Chunks decompressed by the last request. */
+        std::map< size_t, std::vector<double> > mCache;
+
+        /*
+         * chunkBox()
+         *
+         * Node index ranges [lo,hi) of given chunk along every axis.
+         */
+        void chunkBox (const size_t & chunk, size_t * lo, size_t * hi) const;
+
+    private:
+        FieldFile (const FieldFile & other);
+        FieldFile & operator= (const FieldFile & other);
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Constructor
+         *
+         * Opens a file and reads its header and chunk index.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::runtime_error if file cannot be opened or is not a valid
+         * field file.
+         */
+        FieldFile (const std::string & path);
+
+        /*
+         * Destructor
+         */
+        ~FieldFile ();
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /* Number of grid nodes along q1, q2 and q3 axes. */
+        size_t n1 () const { return mN[0]; }
+        size_t n2 () const { return mN[1]; }
+        size_t n3 () const { return mN[2]; }
+
+        /* Number of values per grid node. */
+        unsigned components () const { return mComponents; }
+
+        /* Total size of compressed chunks (in bytes). */
+        unsigned long long compressedBytes () const;
+
+        /*
+         * readBox()
+         *
+         * Reads values at nodes (i1,i2,i3) with lo[a] <= ia < hi[a].
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const size_t * lo
+         * const size_t * hi
+         *     Node index ranges along q1, q2 and q3 axes.
+         *
+         * double * out
+         *     Array receiving box values, in the memory layout described
+         *     in qobj.h header file (with box extents as grid sizes and all
+         *     components of a node stored consecutively).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if box is empty or exceeds the grid.
+         * std::runtime_error if file cannot be read or is corrupted.
+         */
+        void readBox (const size_t *  lo,
+                      const size_t *  hi,
+                      double       * out);
+
+        /*
+         * readSlab()
+         *
+         * Reads q3 planes z0,...,z1-1 together with up to halo planes on
+         * each side (fewer at grid boundaries). Interior planes of such
+         * slab can be evaluated with FieldEngine built on the corresponding
+         * range of q3 coordinates, as long as halo is at least half of
+         * the stencil width.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const size_t & z0
+         * const size_t & z1
+         *     Range of slab planes.
+         *
+         * const size_t & halo
+         *     Number of additional planes on each side.
+         *
+         * double * out
+         *     Array receiving values of n1()*n2()*components() values for
+         *     every read plane.
+         *
+         * ---------
+         *  Returns
+         * ---------
+         * Index of the first read plane.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * Same as readBox().
+         */
+        size_t readSlab (const size_t &   z0,
+                         const size_t &   z1,
+                         const size_t & halo,
+                         double       *  out);
+
+}; /* class FieldFile */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_FIELD_FILE_H */
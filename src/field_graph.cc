@@ -0,0 +1,155 @@
+/*
+ * File: field_graph.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing FieldGraph and VectorNormStage classes methods
+ * implementation (declared in field_graph.h header file). Graphs are
+ * executed by FieldEngine::execute() (see field_engine.cc).
+ */
+
+#include "field_graph.h"
+
+#include <cmath>      /* sqrt */
+#include <stdexcept>  /* std::invalid_argument */
+
+namespace GridDiff
+{
+
+void VectorNormStage::combineRow (const RowContext     &   row,
+                                  const double * const *    in,
+                                  const unsigned       * comps,
+                                  double               *   out) const
+{
+    const unsigned nc = comps[0];
+
+    for (size_t i = 0; i < row.length; ++i){
+        const double * v = in[0] + i * nc;
+        double         s = 0.0;
+
+        for (unsigned c = 0; c < nc; ++c){
+            s += v[c] * v[c];
+        }
+        out[i] = sqrt(s);
+    }
+}
+
+
+void FieldGraph::checkField (const size_t & node) const
+{
+    if (node >= mNodes.size()){
+        throw std::invalid_argument("graph node does not exist");
+    }
+    if (mNodes[node].kind == GRAPH_REDUCTION){
+        throw std::invalid_argument("graph node is not a field");
+    }
+}
+
+
+size_t FieldGraph::addInput (const double   *          f,
+                             const unsigned & components)
+{
+    /* If arguments invalid, throw exception. */
+    if (f == NULL || components == 0){
+        throw std::invalid_argument("invalid input field");
+    }
+
+    GraphNode n;
+
+    n.kind       = GRAPH_INPUT;
+    n.components = components;
+    n.data       = f;
+
+    mNodes.push_back(n);
+    return mNodes.size() - 1;
+}
+
+
+size_t FieldGraph::addOperator (const FieldOperator &    op,
+                                const size_t        & input)
+{
+    /* If arguments invalid, throw exception. */
+    checkField(input);
+
+    if (mNodes[input].components != 1){
+        throw std::invalid_argument("operator input is not scalar");
+    }
+
+    GraphNode n;
+
+    n.kind       = GRAPH_OPERATOR;
+    n.op         = &op;
+    n.components = op.components();
+    n.inputs.push_back(input);
+
+    mNodes.push_back(n);
+    return mNodes.size() - 1;
+}
+
+
+size_t FieldGraph::addStage (const PointwiseStage      &  stage,
+                             const std::vector<size_t> & inputs)
+{
+    /* If arguments invalid, throw exception. */
+    if (inputs.size() != stage.inputs()){
+        throw std::invalid_argument("wrong number of stage inputs");
+    }
+    for (size_t j = 0; j < inputs.size(); ++j){
+        checkField(inputs[j]);
+    }
+
+    GraphNode n;
+
+    n.kind       = GRAPH_STAGE;
+    n.stage      = &stage;
+    n.components = stage.components();
+    n.inputs     = inputs;
+
+    mNodes.push_back(n);
+    return mNodes.size() - 1;
+}
+
+
+size_t FieldGraph::addReduction (const size_t   &     input,
+                                 const unsigned & component,
+                                 double         *    result)
+{
+    /* If arguments invalid, throw exception. */
+    checkField(input);
+
+    if (component >= mNodes[input].components){
+        throw std::invalid_argument("reduced component does not exist");
+    }
+    if (result == NULL){
+        throw std::invalid_argument("reduction result is NULL");
+    }
+
+    GraphNode n;
+
+    n.kind      = GRAPH_REDUCTION;
+    n.component = component;
+    n.out       = result;
+    n.inputs.push_back(input);
+
+    mNodes.push_back(n);
+    return mNodes.size() - 1;
+}
+
+
+void FieldGraph::setOutput (const size_t &  node,
+                            double       *   out)
+{
+    /* If arguments invalid, throw exception. */
+    checkField(node);
+
+    if (mNodes[node].kind == GRAPH_INPUT){
+        throw std::invalid_argument("graph input cannot be an output");
+    }
+    if (out == NULL){
+        throw std::invalid_argument("output field is NULL");
+    }
+
+    mNodes[node].out = out;
+}
+
+} /* namespace GridDiff */
@@ -0,0 +1,248 @@
+/*
+ * File: field_graph.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing FieldGraph class used for describing pipelines
+ * of field operations (operator applications, pointwise stages and
+ * reductions), which are executed by FieldEngine::execute() in a single
+ * wavefront sweep through the grid instead of one full-field pass per
+ * operation.
+ */
+
+#ifndef GRIDDIFF_FIELD_GRAPH_H
+#define GRIDDIFF_FIELD_GRAPH_H
+
+#include "field_operator.h"  /* FieldOperator, RowContext */
+
+#include <vector>            /* std::vector */
+#include <cstddef>           /* size_t */
+
+namespace GridDiff
+{
+
+/*
+ * PointwiseStage class
+ *
+ * Describes an operation evaluated independently at every grid node from
+ * values of one or more fields at that node (e.g. a norm of a gradient or
+ * a sum of fields).
+ */
+class PointwiseStage
+{
+    public:
+        virtual ~PointwiseStage () { }
+
+        /* Number of input fields. */
+        virtual unsigned inputs () const = 0;
+
+        /* Number of values per node. */
+        virtual unsigned components () const = 0;
+
+        /*
+         * combineRow()
+         *
+         * Evaluates the stage for every node of a row.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const RowContext & row
+         *     Row description (see field_operator.h header file).
+         *
+         * const double * const * in
+         *     Pointers to values of input fields at the first node of the
+         *     row; value of component c of input j at ith node of the row
+         *     is in[j][i*comps[j] + c].
+         *
+         * const unsigned * comps
+         *     Number of components of every input field.
+         *
+         * double * out
+         *     Output values; component c of ith node has to be stored at
+         *     out[i*components() + c].
+         */
+        virtual void combineRow (const RowContext     &   row,
+                                 const double * const *    in,
+                                 const unsigned       * comps,
+                                 double               *   out) const = 0;
+
+}; /* class PointwiseStage */
+
+
+/*
+ * VectorNormStage class
+ *
+ * Euclidean norm of a vector field (e.g. of a gradient). Scalar.
+ */
+class VectorNormStage : public PointwiseStage
+{
+    public:
+        unsigned inputs     () const { return 1; }
+        unsigned components () const { return 1; }
+
+        void combineRow (const RowContext     &   row,
+                         const double * const *    in,
+                         const unsigned       * comps,
+                         double               *   out) const;
+
+}; /* class VectorNormStage */
+
+
+/*
+ * Kinds of FieldGraph nodes.
+ */
+enum GraphNodeKind
+{
+    GRAPH_INPUT,      /* field given by user */
+    GRAPH_OPERATOR,   /* operator applied to a scalar field */
+    GRAPH_STAGE,      /* pointwise stage applied to fields */
+    GRAPH_REDUCTION   /* sum of one component of a field over all nodes */
+};
+
+/*
+ * GraphNode struct
+ *
+ * Node of a FieldGraph. Every node except a reduction produces a field of
+ * components values per grid node.
+ */
+struct GraphNode
+{
+    /* Kind of node. */
+    GraphNodeKind          kind;
+    /* Evaluated operator (GRAPH_OPERATOR) or stage (GRAPH_STAGE). */
+    const FieldOperator  * op;
+    const PointwiseStage * stage;
+    /* Nodes whose fields are used. */
+    std::vector<size_t>    inputs;
+    /* Number of values per grid node of the field. */
+    unsigned               components;
+    /* Summed component (GRAPH_REDUCTION). */
+    unsigned               component;
+    /* Input field (GRAPH_INPUT). */
+    const double         * data;
+    /* Storage of the field given by user (NULL if the field is only
+     * needed by other nodes) or reduction result. */
+    double               * out;
+
+    GraphNode ()
+        : kind(GRAPH_INPUT), op(NULL), stage(NULL), components(0),
+          component(0), data(NULL), out(NULL) { }
+};
+
+
+/*
+ * FieldGraph class
+ *
+ * Describes a pipeline of field operations as a directed acyclic graph.
+ * Nodes can only use fields of nodes added earlier, so the order of
+ * addition is a valid evaluation order. Fields of nodes without user
+ * storage (see setOutput()) are intermediate: FieldEngine::execute()
+ * keeps only a few q3 planes of them, which are reused while they are
+ * still in cache.
+ *
+ * Graph only stores pointers to operators, stages and fields; they have to
+ * exist until the graph is executed.
+ */
+class FieldGraph
+{
+    protected:
+        /* Nodes in order of addition. */
+        std::vector<GraphNode> mNodes;
+
+        /* Throws if node does not exist or does not produce a field. */
+        void checkField (const size_t & node) const;
+
+    public:
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /*
+         * addInput()
+         *
+         * Adds a field given by user (components*size() values, all
+         * components of a node stored consecutively). Returns node index.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if f is NULL or components is 0.
+         */
+        size_t addInput (const double   *          f,
+                         const unsigned & components = 1);
+
+        /*
+         * addOperator()
+         *
+         * Adds application of an operator to a scalar field. Returns node
+         * index.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if input does not exist or is not a scalar
+         * field.
+         */
+        size_t addOperator (const FieldOperator &    op,
+                            const size_t        & input);
+
+        /*
+         * addStage()
+         *
+         * Adds a pointwise stage applied to given fields. Returns node
+         * index.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if number of inputs differs from
+         * stage.inputs() or any of them is not a field.
+         */
+        size_t addStage (const PointwiseStage      &  stage,
+                         const std::vector<size_t> & inputs);
+
+        /*
+         * addReduction()
+         *
+         * Adds a sum of one component of a field over all grid nodes,
+         * stored in *result by FieldEngine::execute(). Partial sums are
+         * added in a fixed order, so results do not depend on the number
+         * of threads. Returns node index.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if input is not a field, component does
+         * not exist or result is NULL.
+         */
+        size_t addReduction (const size_t   &     input,
+                             const unsigned & component,
+                             double         *    result);
+
+        /*
+         * setOutput()
+         *
+         * Stores field of a node (components*size() values) in out instead
+         * of an intermediate buffer.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if node is an input or not a field, or out
+         * is NULL.
+         */
+        void setOutput (const size_t &  node,
+                        double       *   out);
+
+        /* Number of nodes. */
+        size_t nodes () const { return mNodes.size(); }
+
+        /* Node of given index. */
+        const GraphNode & node (const size_t & n) const { return mNodes[n]; }
+
+}; /* class FieldGraph */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_FIELD_GRAPH_H */
@@ -0,0 +1,156 @@
+/*
+ * File: field_operator.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing FieldOperator class. It is an interface for
+ * describing partial differential operators evaluated at all nodes of
+ * a tensor grid by FieldEngine class (see field_engine.h header file).
+ */
+
+#ifndef GRIDDIFF_FIELD_OPERATOR_H
+#define GRIDDIFF_FIELD_OPERATOR_H
+
+#include <cstddef>  /* size_t, ptrdiff_t */
+
+namespace GridDiff
+{
+
+/*
+ * Axis indices used by FieldOperator and FieldEngine classes.
+ */
+enum
+{
+    AXIS_Q1 = 0,
+    AXIS_Q2 = 1,
+    AXIS_Q3 = 2
+};
+
+/*
+ * RowContext struct
+ *
+ * Describes a segment of consecutive grid nodes along q1 axis (a row) for
+ * which an operator is evaluated. q1 coordinates change along the row,
+ * while q2 and q3 coordinates are constant.
+ */
+struct RowContext
+{
+    /* Indices of the first node of the row. */
+    size_t         i1, i2, i3;
+    /* Number of nodes in the row. */
+    size_t         length;
+    /* Position of the first node of the row in a field (see QFieldIndex
+     * function in qobj.h header file). */
+    size_t         node;
+    /* q1 coordinates of row nodes (length values). */
+    const double * q1;
+    /* q2 and q3 coordinates of the row. */
+    double         q2, q3;
+};
+
+/*
+ * FieldOperator class
+ *
+ * Describes a differential operator as a combination of partial
+ * derivatives d^k/dqi^k (i=1,2,3) with coordinate dependent factors, much
+ * like child classes of Basic_3D_DiffOp do for a single point. FieldEngine
+ * evaluates required partial derivatives for whole rows of grid nodes and
+ * passes them to combineRow() method, which has to calculate operator
+ * values for every node of the row.
+ *
+ * Operators can be vector-valued (e.g. gradient); every node then receives
+ * components() output values.
+ */
+class FieldOperator
+{
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        virtual ~FieldOperator () { }
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /*
+         * maxOrder()
+         *
+         * Highest derivative order used by the operator.
+         */
+        virtual unsigned maxOrder () const = 0;
+
+        /*
+         * components()
+         *
+         * Number of output values per grid node (1 for scalar operators).
+         */
+        virtual unsigned components () const = 0;
+
+        /*
+         * uses()
+         *
+         * Returns true if kth partial derivative along given axis (AXIS_Q1,
+         * AXIS_Q2 or AXIS_Q3) is used by the operator. Only such derivatives
+         * are evaluated by FieldEngine. Order 0 (function values) is always
+         * available.
+         */
+        virtual bool uses (const unsigned & axis,
+                           const unsigned & order) const = 0;
+
+        /*
+         * fits()
+         *
+         * Returns true if the operator can be evaluated on a grid of
+         * n1 x n2 x n3 nodes. Operators holding tables of a particular grid
+         * (e.g. metric terms, see CurvilinearOperators.h header file)
+         * return false for grids of other sizes; engines check it before
+         * evaluation. Every grid fits by default.
+         */
+        virtual bool fits (const size_t & /* n1 */,
+                           const size_t & /* n2 */,
+                           const size_t & /* n3 */) const
+        {
+            return true;
+        }
+
+        /*
+         * combineRow()
+         *
+         * Evaluates operator for every node of a row.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const RowContext & row
+         *     Row description.
+         *
+         * const double * const * d
+         *     Partial derivatives at row nodes. d[axis*(maxOrder()+1)+k]
+         *     points to row.length values of kth partial derivative along
+         *     given axis (if uses(axis,k) is true; NULL otherwise). For k==0
+         *     function values are given.
+         *
+         * double * const * out
+         *     Output pointers. Component c of operator value at jth row node
+         *     has to be written to out[c][j*stride].
+         *
+         * const ptrdiff_t & stride
+         *     Distance between output values of consecutive row nodes.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * None.
+         */
+        virtual void combineRow (const RowContext     &    row,
+                                 const double * const *      d,
+                                 double       * const *    out,
+                                 const ptrdiff_t      & stride) const = 0;
+
+}; /* class FieldOperator */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_FIELD_OPERATOR_H */
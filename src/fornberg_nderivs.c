@@ -1,13 +1,17 @@
 /*
  * File: fornberg_nderivs.c
  * Author(s): P Kuszaj
- * Last changed: 27.01.2015
+ * Last changed: 18.10.2026
  *
  * A source file with implementations of functions declared in
  * fornberg_nderivs.h header file. */
 
 #include "fornberg_nderivs.h"
 
+/* Number of functions evaluated together by FornbergKDerivEvalMulti()
+ * kernels (interleaved layout; strided layout uses blocks of 4). */
+#define FORNBERG_RHS_BLOCK 64
+
 int FornbergNumDerivsCoeffs (double * coeffs,
                            const double x0, const double * p,
                            size_t n, unsigned int m)
@@ -141,3 +145,279 @@ double FornbergKDerivEval (const double * coeffs_n,
     return eval;
 }
 
+
+int FornbergCoeffsSymmetry (const double * coeffs_k, size_t n, double tol)
+{
+    double largest = 0.0, sym = 0.0, anti = 0.0, d;
+    size_t i;
+
+    if (coeffs_k == NULL){
+        return FORNBERG_GENERAL;
+    }
+
+    /* Largest coefficient magnitude and largest differences (sums) of
+     * mirrored coefficients; the middle one of odd n is compared with
+     * itself, i.e. only its magnitude matters for antisymmetry. */
+    for (i = 0; i < n; ++i){
+        d = (coeffs_k[i] < 0.0) ? -coeffs_k[i] : coeffs_k[i];
+        if (d > largest){
+            largest = d;
+        }
+
+        d = coeffs_k[i] - coeffs_k[n-1-i];
+        if (d < 0.0){
+            d = -d;
+        }
+        if (d > sym){
+            sym = d;
+        }
+
+        d = coeffs_k[i] + coeffs_k[n-1-i];
+        if (d < 0.0){
+            d = -d;
+        }
+        if (d > anti){
+            anti = d;
+        }
+    }
+
+    if (sym <= tol * largest){
+        return FORNBERG_SYMMETRIC;
+    }
+
+    if (anti <= tol * largest){
+        return FORNBERG_ANTISYMMETRIC;
+    }
+
+    return FORNBERG_GENERAL;
+}
+
+
+void FornbergSymmetrizeCoeffs (double * coeffs_k, size_t n, int symmetry)
+{
+    double c;
+    size_t i;
+
+    if (coeffs_k == NULL || symmetry == FORNBERG_GENERAL){
+        return;
+    }
+
+    for (i = 0; i < n/2; ++i){
+        c = (symmetry == FORNBERG_SYMMETRIC)
+          ? 0.5 * (coeffs_k[i] + coeffs_k[n-1-i])
+          : 0.5 * (coeffs_k[i] - coeffs_k[n-1-i]);
+
+        coeffs_k[i]     = c;
+        coeffs_k[n-1-i] = (symmetry == FORNBERG_SYMMETRIC) ? c : -c;
+    }
+
+    if (n % 2 == 1 && symmetry == FORNBERG_ANTISYMMETRIC){
+        coeffs_k[n/2] = 0.0;
+    }
+}
+
+
+double FornbergKDerivEvalSym (const double * coeffs_k,
+                              const double * pvals, size_t n,
+                              int symmetry)
+{
+    double eval = 0.0;
+    size_t i;
+
+    if (symmetry == FORNBERG_SYMMETRIC){
+        for (i = 0; i < n/2; ++i){
+            eval += coeffs_k[i] * (pvals[i] + pvals[n-1-i]);
+        }
+
+        if (n % 2 == 1){
+            eval += coeffs_k[n/2] * pvals[n/2];
+        }
+    }
+    else if (symmetry == FORNBERG_ANTISYMMETRIC){
+        /* The middle coefficient is zero. */
+        for (i = 0; i < n/2; ++i){
+            eval += coeffs_k[i] * (pvals[i] - pvals[n-1-i]);
+        }
+    }
+    else {
+        eval = FornbergKDerivEval(coeffs_k, pvals, n);
+    }
+
+    return eval;
+}
+
+
+
+void FornbergDerivsEval (const double * coeffs,
+                         const double * pvals, size_t n,
+                         unsigned int m, double * out)
+{
+    size_t       i;
+    unsigned int k;
+
+    for (k = 0; k < m; ++k){
+        out[k] = 0.0;
+    }
+
+    for (i = 0; i < n; ++i){
+        const double v = pvals[i];
+
+        for (k = 0; k < m; ++k){
+            out[k] += coeffs[k*n + i] * v;
+        }
+    }
+}
+
+
+/*
+ * Kernel for functions with consecutive values at every grid point
+ * (rhs_stride == 1). Loop over functions is the inner one, so it can be
+ * vectorized.
+ */
+static void KDerivEvalInterleaved (const double * coeffs_k,
+                                   const double * pvals, size_t n,
+                                   size_t nrhs, size_t point_stride,
+                                   double * out)
+{
+    double acc[FORNBERG_RHS_BLOCK];
+    size_t i, j, j0, nb;
+
+    for (j0 = 0; j0 < nrhs; j0 += FORNBERG_RHS_BLOCK){
+        nb = (nrhs - j0 < FORNBERG_RHS_BLOCK) ? nrhs - j0
+                                              : FORNBERG_RHS_BLOCK;
+
+        for (j = 0; j < nb; ++j){
+            acc[j] = 0.0;
+        }
+
+        for (i = 0; i < n; ++i){
+            const double   c = coeffs_k[i];
+            const double * v = pvals + i*point_stride + j0;
+
+            for (j = 0; j < nb; ++j){
+                acc[j] += c * v[j];
+            }
+        }
+
+        for (j = 0; j < nb; ++j){
+            out[j0+j] = acc[j];
+        }
+    }
+}
+
+
+/*
+ * Kernel for other layouts. Four functions are evaluated together, so
+ * every coefficient is loaded once for all of them.
+ */
+static void KDerivEvalStrided (const double * coeffs_k,
+                               const double * pvals, size_t n,
+                               size_t nrhs,
+                               size_t point_stride, size_t rhs_stride,
+                               double * out)
+{
+    size_t i, j = 0;
+
+    for (; j + 4 <= nrhs; j += 4){
+        const double * v0 = pvals + j*rhs_stride;
+        const double * v1 = v0 + rhs_stride;
+        const double * v2 = v1 + rhs_stride;
+        const double * v3 = v2 + rhs_stride;
+        double         s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+
+        for (i = 0; i < n; ++i){
+            const double c = coeffs_k[i];
+            const size_t o = i*point_stride;
+
+            s0 += c * v0[o];
+            s1 += c * v1[o];
+            s2 += c * v2[o];
+            s3 += c * v3[o];
+        }
+
+        out[j]   = s0;
+        out[j+1] = s1;
+        out[j+2] = s2;
+        out[j+3] = s3;
+    }
+
+    for (; j < nrhs; ++j){
+        const double * v = pvals + j*rhs_stride;
+        double         s = 0.0;
+
+        for (i = 0; i < n; ++i){
+            s += coeffs_k[i] * v[i*point_stride];
+        }
+
+        out[j] = s;
+    }
+}
+
+
+int FornbergKDerivEvalMulti (const double * coeffs_k,
+                             const double * pvals, size_t n,
+                             size_t nrhs,
+                             size_t point_stride, size_t rhs_stride,
+                             double * out)
+{
+    /* Ensure none of input pointers are NULL. Otherwise, exit with
+     * an appropriate error code. */
+    if (coeffs_k == NULL){
+        return FORNBERG_NULLPTR_COEFFS;
+    }
+
+    if (pvals == NULL || out == NULL){
+        return FORNBERG_NULLPTR_VALS;
+    }
+
+    if (rhs_stride == 1){
+        KDerivEvalInterleaved(coeffs_k, pvals, n, nrhs, point_stride, out);
+    }
+    else {
+        KDerivEvalStrided(coeffs_k, pvals, n, nrhs,
+                          point_stride, rhs_stride, out);
+    }
+
+    return FORNBERG_SUCCESS;
+}
+
+
+int FornbergDerivsEvalMulti (const double * coeffs, size_t n,
+                             const unsigned int * orders, size_t norders,
+                             const double * pvals,
+                             size_t nrhs,
+                             size_t point_stride, size_t rhs_stride,
+                             double * out, size_t out_stride)
+{
+    size_t       o, j0, nb;
+    unsigned int k;
+
+    if (coeffs == NULL){
+        return FORNBERG_NULLPTR_COEFFS;
+    }
+
+    if (pvals == NULL || out == NULL){
+        return FORNBERG_NULLPTR_VALS;
+    }
+
+    if (out_stride < nrhs){
+        return FORNBERG_SIZEERR;
+    }
+
+    /* Functions are processed in blocks; all orders are evaluated for
+     * a block before moving on, so its values stay in cache. */
+    for (j0 = 0; j0 < nrhs; j0 += FORNBERG_RHS_BLOCK){
+        nb = (nrhs - j0 < FORNBERG_RHS_BLOCK) ? nrhs - j0
+                                              : FORNBERG_RHS_BLOCK;
+
+        for (o = 0; o < norders; ++o){
+            k = (orders != NULL) ? orders[o] : (unsigned int) o;
+
+            FornbergKDerivEvalMulti(coeffs + k*n, pvals + j0*rhs_stride, n,
+                                    nb, point_stride, rhs_stride,
+                                    out + o*out_stride + j0);
+        }
+    }
+
+    return FORNBERG_SUCCESS;
+}
@@ -1,7 +1,7 @@
 /*
  * File: fornberg_nderivs.h
  * Author(s): P Kuszaj
- * Last changed: 27.01.2015
+ * Last changed: 18.10.2026
  *
  * A header file providing functions calculating numerical kth derivative at
  * a given point (for k==0: fast polynomial interpolation method) using an
@@ -41,8 +41,23 @@ enum
                                         is NULL */
     FORNBERG_NULLPTR_COEFFS,         /* pointer to the coefficients array
                                         is NULL */
-    FORNBERG_SIZEERR                 /* number of points < highest derivative
+    FORNBERG_SIZEERR,                /* number of points < highest derivative
                                         degree + 1 */
+    FORNBERG_NULLPTR_VALS            /* pointer to the function values or
+                                        results array is NULL */
+};
+
+/*
+ * Enumerated type describing symmetry of coefficients of a derivative
+ * (returned by FornbergCoeffsSymmetry() function defined in this file).
+ * Coefficients of centered stencils of uniform grids are symmetric for
+ * even and antisymmetric for odd derivatives.
+ */
+enum
+{
+    FORNBERG_GENERAL = 0,  /* no symmetry */
+    FORNBERG_SYMMETRIC,    /* c(k,i) == c(k,n-1-i) */
+    FORNBERG_ANTISYMMETRIC /* c(k,i) == -c(k,n-1-i) */
 };
 
 
@@ -212,6 +227,242 @@ double * FornbergGetCoeffList (double * coeffs,
 double FornbergKDerivEval (const double * coeffs_k,
                            const double * pvals, size_t n);
 
+/*
+ * FornbergCoeffsSymmetry()
+ *
+ * Checks whether coefficients for n-point numerical kth derivative are
+ * symmetric or antisymmetric (the middle coefficient of odd n being zero
+ * then), i.e. whether every pair of mirrored coefficients differs (or
+ * sums up) by at most tol times the largest coefficient magnitude. Only
+ * coefficient values are compared, so grid spacing is not assumed.
+ *
+ * -----------
+ *  Arguments
+ * -----------
+ * const double * coeffs_k
+ *     Array of doubles, containing all coefficient used for evaluating
+ *     n-point numerical kth derivative (see FornbergKDerivEval()).
+ *
+ * size_t n
+ *     Number of grid points used to calculate coefficients.
+ *
+ * double tol
+ *     Largest relative difference of mirrored coefficients (zero for exact
+ *     comparison).
+ *
+ * ---------
+ *  Returns
+ * ---------
+ * FORNBERG_SYMMETRIC, FORNBERG_ANTISYMMETRIC or FORNBERG_GENERAL (also if
+ * coeffs_k is a NULL pointer).
+ */
+int FornbergCoeffsSymmetry (const double * coeffs_k, size_t n, double tol);
+
+/*
+ * FornbergSymmetrizeCoeffs()
+ *
+ * Makes coefficients for n-point numerical kth derivative exactly
+ * symmetric or antisymmetric (mirrored coefficients are replaced with
+ * their mean value; for antisymmetric ones, the middle coefficient of odd
+ * n with zero). Intended for coefficients found symmetric (antisymmetric)
+ * within rounding errors by FornbergCoeffsSymmetry() function; nothing is
+ * done for FORNBERG_GENERAL.
+ *
+ * -----------
+ *  Arguments
+ * -----------
+ * double * coeffs_k
+ *     Array of n coefficients, changed in place.
+ *
+ * size_t n
+ *     Number of grid points used to calculate coefficients.
+ *
+ * int symmetry
+ *     Symmetry of coefficients (see FornbergCoeffsSymmetry()).
+ */
+void FornbergSymmetrizeCoeffs (double * coeffs_k, size_t n, int symmetry);
+
+/*
+ * FornbergKDerivEvalSym()
+ *
+ * Evaluates kth derivative at some x0 point (see FornbergKDerivEval())
+ * using coefficients of given symmetry. For symmetric (antisymmetric)
+ * coefficients, values at mirrored grid points are added (subtracted)
+ * first, so only (n+1)/2 multiplications are needed:
+ *
+ *     c(k,0) * (pvals[0] +- pvals[n-1]) + c(k,1) * (pvals[1] +- ...
+ *
+ * Coefficients of other symmetry values are evaluated with
+ * FornbergKDerivEval function.
+ *
+ * -----------
+ *  Arguments
+ * -----------
+ * const double * coeffs_k
+ * const double * pvals
+ * size_t n
+ *     Coefficients, function values and number of grid points (see
+ *     FornbergKDerivEval()).
+ *
+ * int symmetry
+ *     Symmetry of coefficients, as returned by FornbergCoeffsSymmetry()
+ *     (coefficients are assumed to be exactly symmetric or antisymmetric,
+ *     only the first (n+1)/2 of them are used).
+ *
+ * ---------
+ *  Returns
+ * ---------
+ * Double value equal to the n-point numerical approximation of kth
+ * derivative at some point x0.
+ */
+double FornbergKDerivEvalSym (const double * coeffs_k,
+                              const double * pvals, size_t n,
+                              int symmetry);
+
+/*
+ * FornbergDerivsEval()
+ *
+ * Evaluates all derivatives of orders 0,...,m-1 at some x0 point in
+ * a single pass over function values (every value is loaded once and
+ * multiplied by coefficients of all orders, stored as generated by
+ * FornbergNumDerivsCoeffs function).
+ *
+ * -----------
+ *  Arguments
+ * -----------
+ * const double * coeffs
+ *     Array of doubles generated by FornbergNumDerivsCoeffs function (for
+ *     n grid points and at least m derivative orders).
+ *
+ * const double * pvals
+ *     Array of doubles, containing function values at grid points (see
+ *     FornbergKDerivEval()).
+ *
+ * size_t n
+ *     Number of grid points used to calculate coefficients.
+ *
+ * unsigned int m
+ *     Number of evaluated derivatives.
+ *
+ * double * out
+ *     Array of doubles receiving m derivative values (out[k] being the kth
+ *     derivative).
+ */
+void FornbergDerivsEval (const double * coeffs,
+                         const double * pvals, size_t n,
+                         unsigned int m, double * out);
+
+/*
+ * FornbergKDerivEvalMulti()
+ *
+ * Evaluates kth derivative at some x0 point for nrhs functions at once
+ * (e.g. several fields sharing the same grid), using the same coefficients
+ * for all of them:
+ *
+ *     out[j] = coeffs_k[0] * v(0,j) + ... + coeffs_k[n-1] * v(n-1,j)
+ *
+ * where v(i,j) = pvals[i*point_stride + j*rhs_stride] is value of jth
+ * function at ith grid point. Two layouts are handled by specialized
+ * kernels (other strides are also allowed):
+ *     * interleaved: values of all functions at a grid point are stored
+ *       consecutively (point_stride = nrhs, rhs_stride = 1),
+ *     * strided: values of every function are stored consecutively
+ *       (point_stride = 1, rhs_stride >= n).
+ * Functions are processed in blocks, so every coefficient is loaded once
+ * per block and partial sums are kept in registers (or in an array, which
+ * the compiler can vectorize over functions in the interleaved layout).
+ *
+ * -----------
+ *  Arguments
+ * -----------
+ * const double * coeffs_k
+ *     Array of doubles, containing all coefficient used for evaluating
+ *     n-point numerical kth derivative (see FornbergKDerivEval()).
+ *
+ * const double * pvals
+ *     Array of doubles, containing values of all functions at grid points.
+ *
+ * size_t n
+ *     Number of grid points used to calculate coefficients.
+ *
+ * size_t nrhs
+ *     Number of functions.
+ *
+ * size_t point_stride
+ * size_t rhs_stride
+ *     Distances (in doubles) between values at consecutive grid points and
+ *     between values of consecutive functions.
+ *
+ * double * out
+ *     Array of doubles receiving nrhs derivative values.
+ *
+ * ---------
+ *  Returns
+ * ---------
+ * Integer value equal to proper exit code:
+ *     FORNBERG_SUCCESS         function successfully terminates
+ *     FORNBERG_NULLPTR_COEFFS  error code: coeffs_k is a NULL pointer
+ *     FORNBERG_NULLPTR_VALS    error code: pvals or out is a NULL pointer
+ */
+int FornbergKDerivEvalMulti (const double * coeffs_k,
+                             const double * pvals, size_t n,
+                             size_t nrhs,
+                             size_t point_stride, size_t rhs_stride,
+                             double * out);
+
+/*
+ * FornbergDerivsEvalMulti()
+ *
+ * Evaluates derivatives of several orders at some x0 point for nrhs
+ * functions at once (see FornbergKDerivEvalMulti()). Derivative of order
+ * orders[o] of jth function is written to out[o*out_stride + j].
+ *
+ * -----------
+ *  Arguments
+ * -----------
+ * const double * coeffs
+ *     Array of doubles generated by FornbergNumDerivsCoeffs function (for
+ *     n grid points and m greater than every requested order).
+ *
+ * size_t n
+ *     Number of grid points used to calculate coefficients.
+ *
+ * const unsigned int * orders
+ *     Array of norders requested derivative orders. If NULL, orders
+ *     0,...,norders-1 are evaluated.
+ *
+ * size_t norders
+ *     Number of requested derivative orders.
+ *
+ * const double * pvals
+ * size_t nrhs
+ * size_t point_stride
+ * size_t rhs_stride
+ *     Function values and their layout (see FornbergKDerivEvalMulti()).
+ *
+ * double * out
+ *     Array of doubles receiving derivative values.
+ *
+ * size_t out_stride
+ *     Distance (in doubles) between results of consecutive orders. Has to
+ *     be at least nrhs.
+ *
+ * ---------
+ *  Returns
+ * ---------
+ * Integer value equal to proper exit code:
+ *     FORNBERG_SUCCESS         function successfully terminates
+ *     FORNBERG_NULLPTR_COEFFS  error code: coeffs is a NULL pointer
+ *     FORNBERG_NULLPTR_VALS    error code: pvals or out is a NULL pointer
+ *     FORNBERG_SIZEERR         error code: out_stride < nrhs
+ */
+int FornbergDerivsEvalMulti (const double * coeffs, size_t n,
+                             const unsigned int * orders, size_t norders,
+                             const double * pvals,
+                             size_t nrhs,
+                             size_t point_stride, size_t rhs_stride,
+                             double * out, size_t out_stride);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,107 @@
+/*
+ * File: grid_batch.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing GridBatch class methods implementation (declared
+ * in grid_batch.h header file).
+ */
+
+#include "grid_batch.h"
+
+#include <map>        /* std::map */
+#include <stdexcept>  /* std::invalid_argument */
+#include <string>     /* std::string */
+#include <utility>    /* std::make_pair */
+
+namespace GridDiff
+{
+
+GridBatch::GridBatch (const std::vector<GridAxes> &    grids,
+                      const unsigned              &    width,
+                      const unsigned              & maxOrder)
+{
+    /* Distinct axes; plan index of every axis of every grid. */
+    std::map<QGrid, size_t>     index;
+    std::vector<const QGrid *>  axes;
+    std::vector<size_t>         planOf(3 * grids.size());
+
+    for (size_t g = 0; g < grids.size(); ++g){
+        const QGrid * q[3] = { &grids[g].q1, &grids[g].q2, &grids[g].q3 };
+
+        for (unsigned a = 0; a < 3; ++a){
+            std::map<QGrid, size_t>::iterator it = index.find(*q[a]);
+
+            if (it == index.end()){
+                it = index.insert(std::make_pair(*q[a], axes.size())).first;
+                axes.push_back(q[a]);
+            }
+            planOf[3*g + a] = it->second;
+        }
+    }
+
+    /* Building plans in parallel. Exceptions cannot leave a parallel
+     * region, so the first error message is kept and rethrown. */
+    std::vector<AxisPlan> plans(axes.size());
+    std::string           error;
+    const long            n = (long) axes.size();
+
+    #pragma omp parallel for schedule(dynamic)
+    for (long i = 0; i < n; ++i){
+        try {
+            plans[i] = AxisPlan(*axes[i], width, maxOrder);
+        }
+        catch (const std::invalid_argument & e){
+            #pragma omp critical
+            if (error.empty()){ error = e.what(); }
+        }
+    }
+
+    if (!error.empty()){
+        throw std::invalid_argument(error);
+    }
+
+    /* Engines; every grid is evaluated by a single thread. */
+    FieldEngineConfig config;
+    config.threads = 1;
+
+    mEngines.reserve(grids.size());
+
+    for (size_t g = 0; g < grids.size(); ++g){
+        const AxisPlan p[3] = { plans[planOf[3*g]],
+                                plans[planOf[3*g + 1]],
+                                plans[planOf[3*g + 2]] };
+
+        mEngines.push_back(FieldEngine(grids[g].q1, grids[g].q2,
+                                       grids[g].q3, p));
+        mEngines.back().setConfig(config);
+    }
+}
+
+
+void GridBatch::apply (const FieldOperator &    op,
+                       const double * const *    f,
+                       double       * const *  out) const
+{
+    /* If arguments invalid, throw exception (before entering parallel
+     * region). */
+    for (size_t g = 0; g < mEngines.size(); ++g){
+        const FieldEngine & e = mEngines[g];
+
+        if (op.maxOrder() > e.plan(AXIS_Q1).maxOrder()){
+            throw std::invalid_argument("operator order higher than max");
+        }
+        if (!op.fits(e.n1(), e.n2(), e.n3())){
+            throw std::invalid_argument("operator does not fit grid");
+        }
+    }
+
+    const long n = (long) mEngines.size();
+
+    #pragma omp parallel for schedule(dynamic)
+    for (long g = 0; g < n; ++g){
+        mEngines[g].apply(op, f[g], out[g]);
+    }
+}
+
+} /* namespace GridDiff */
@@ -0,0 +1,125 @@
+/*
+ * File: grid_batch.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing GridBatch class used for evaluating operators
+ * on many small independent grids (e.g. ensemble members), each with its
+ * own axis coordinates.
+ */
+
+#ifndef GRIDDIFF_GRID_BATCH_H
+#define GRIDDIFF_GRID_BATCH_H
+
+#include "qobj.h"            /* QGrid */
+#include "field_engine.h"    /* FieldEngine */
+#include "field_operator.h"  /* FieldOperator */
+
+#include <vector>            /* std::vector */
+
+namespace GridDiff
+{
+
+/*
+ * GridAxes struct
+ *
+ * Grid point positions along q1, q2 and q3 axes of a single grid.
+ */
+struct GridAxes
+{
+    QGrid q1, q2, q3;
+};
+
+/*
+ * GridBatch class
+ *
+ * Holds a FieldEngine for every grid of a batch. Coefficient plans of all
+ * grids are built together (in parallel), and every distinct axis is built
+ * only once, however many grids share it. Operators are evaluated in
+ * parallel over grids: every grid is evaluated by a single thread, which
+ * avoids per-grid thread synchronization overhead for small grids.
+ */
+class GridBatch
+{
+    protected:
+        /* Engines of grids (single-threaded). */
+        std::vector<FieldEngine> mEngines;
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Constructor
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const std::vector<GridAxes> & grids
+         *     Axes of every grid.
+         *
+         * const unsigned & width
+         *     Number of grid points used for every stencil.
+         *
+         * const unsigned & maxOrder
+         *     Highest derivative order of evaluated operators.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if any axis is invalid (see FieldEngine
+         * constructor).
+         */
+        GridBatch (const std::vector<GridAxes> &    grids,
+                   const unsigned              &    width,
+                   const unsigned              & maxOrder);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /* Number of grids. */
+        size_t size () const { return mEngines.size(); }
+
+        /* Engine of gth grid. */
+        const FieldEngine & engine (const size_t & g) const
+        {
+            return mEngines[g];
+        }
+
+        /*
+         * apply()
+         *
+         * Evaluates operator on every grid of the batch.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const FieldOperator & op
+         *     Evaluated operator. Operators depending on a particular grid
+         *     (e.g. metric tables of curvilinear operators) have to fit
+         *     every grid of the batch.
+         *
+         * const double * const * f
+         *     Function values of every grid (see FieldEngine::apply()).
+         *
+         * double * const * out
+         *     Arrays receiving results of every grid.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if operator order is higher than the one
+         * given in constructor, or operator does not fit the grid (see
+         * FieldOperator::fits()).
+         */
+        void apply (const FieldOperator &    op,
+                    const double * const *    f,
+                    double       * const *  out) const;
+
+}; /* class GridBatch */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_GRID_BATCH_H */
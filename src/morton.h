@@ -0,0 +1,56 @@
+/*
+ * File: morton.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * An internal header file providing MortonKey function, used to order
+ * bricks of BrickedField class and scattered points of ScatteredEvaluator
+ * class along a Z-order curve (see bricked_field.h and
+ * scattered_evaluator.h header files).
+ */
+
+#ifndef GRIDDIFF_MORTON_H
+#define GRIDDIFF_MORTON_H
+
+namespace GridDiff
+{
+
+/* Bits of every index used in Morton keys (three indices fill 63 bits). */
+const unsigned MORTON_BITS = 21;
+
+/*
+ * MortonSpreadBits()
+ *
+ * Spreads lower MORTON_BITS bits of x, so that there are two zero bits
+ * between every two of them.
+ */
+inline unsigned long long MortonSpreadBits (unsigned long long x)
+{
+    x &= (1ULL << MORTON_BITS) - 1;
+    x = (x | (x << 32)) & 0x1f00000000ffffULL;
+    x = (x | (x << 16)) & 0x1f0000ff0000ffULL;
+    x = (x | (x <<  8)) & 0x100f00f00f00f00fULL;
+    x = (x | (x <<  4)) & 0x10c30c30c30c30c3ULL;
+    x = (x | (x <<  2)) & 0x1249249249249249ULL;
+    return x;
+}
+
+/*
+ * MortonKey()
+ *
+ * Returns Morton (Z-order) key of (i1,i2,i3) position: interleaved bits
+ * of lower MORTON_BITS bits of every index, i1 bits being the least
+ * significant ones.
+ */
+inline unsigned long long MortonKey (unsigned long long i1,
+                                     unsigned long long i2,
+                                     unsigned long long i3)
+{
+    return   MortonSpreadBits(i1)
+           | MortonSpreadBits(i2) << 1
+           | MortonSpreadBits(i3) << 2;
+}
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_MORTON_H */
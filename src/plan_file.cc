@@ -0,0 +1,266 @@
+/*
+ * File: plan_file.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing WritePlanFile, ReadPlanFile and CachedFieldEngine
+ * functions implementation (declared in plan_file.h header file).
+ */
+
+#include "plan_file.h"
+#include "util.h"      /* HashBytes */
+
+#include <stdexcept>   /* std::runtime_error */
+#include <vector>      /* std::vector */
+
+#include <cstdio>      /* rename */
+#include <fcntl.h>     /* open */
+#include <stdint.h>    /* uint64_t */
+#include <stdlib.h>    /* mkstemp */
+#include <sys/mman.h>  /* mmap, munmap */
+#include <sys/stat.h>  /* fstat, fchmod */
+#include <unistd.h>    /* write, fsync, close, unlink */
+
+namespace GridDiff
+{
+
+namespace
+{
+
+/* File identification ("GDPF") and format version (version 2 stores
+ * exactly symmetric coefficients of symmetric stencils). */
+const uint64_t PLAN_FILE_MAGIC   = 0x46504447ULL;
+const uint64_t PLAN_FILE_VERSION = 2;
+
+/* Number of 64-bit words in file header: magic, hash and 5 words per
+ * axis (size, width, max order, distinct rows, data offset). */
+const size_t   HEADER_WORDS      = 2 + 3 * 5;
+
+
+/*
+ * WriteAll()
+ *
+ * Writes n bytes to a file, returns false on failure.
+ */
+bool WriteAll (const int & fd, const void * data, size_t n)
+{
+    const char * p = static_cast<const char *>(data);
+
+    while (n > 0){
+        const ssize_t w = write(fd, p, n);
+
+        if (w <= 0){
+            return false;
+        }
+        p += w;
+        n -= (size_t) w;
+    }
+    return true;
+}
+
+} /* anonymous namespace */
+
+
+unsigned long long PlanHash (const QGrid    &    q1Coords,
+                             const QGrid    &    q2Coords,
+                             const QGrid    &    q3Coords,
+                             const unsigned *      widths,
+                             const unsigned *   maxOrders)
+{
+    const QGrid * q[3] = { &q1Coords, &q2Coords, &q3Coords };
+    uint64_t      h    = FNV_OFFSET_BASIS;
+
+    for (unsigned a = 0; a < 3; ++a){
+        const uint64_t v[3] = { q[a]->size(), widths[a], maxOrders[a] };
+
+        h = HashBytes(v, sizeof(v), h);
+        if (!q[a]->empty()){
+            h = HashBytes(&(*q[a])[0], q[a]->size() * sizeof(double), h);
+        }
+    }
+    return h;
+}
+
+
+void WritePlanFile (const std::string &   path,
+                    const FieldEngine & engine)
+{
+    unsigned widths[3], orders[3];
+
+    for (unsigned a = 0; a < 3; ++a){
+        widths[a] = engine.plan(a).width();
+        orders[a] = engine.plan(a).maxOrder();
+    }
+
+    uint64_t header[HEADER_WORDS] = { 0 };
+    uint64_t offset               = sizeof(header);
+
+    header[0] = PLAN_FILE_MAGIC | (PLAN_FILE_VERSION << 32);
+    header[1] = PlanHash(engine.coords(AXIS_Q1), engine.coords(AXIS_Q2),
+                         engine.coords(AXIS_Q3), widths, orders);
+
+    for (unsigned a = 0; a < 3; ++a){
+        const AxisPlan & p = engine.plan(a);
+
+        header[2 + 5*a]     = p.size();
+        header[2 + 5*a + 1] = p.width();
+        header[2 + 5*a + 2] = p.maxOrder();
+        header[2 + 5*a + 3] = p.rows();
+        header[2 + 5*a + 4] = offset;
+
+        offset += 2 * p.size() * sizeof(uint64_t)
+                + p.table().doubleValues().size() * sizeof(double);
+    }
+
+    /* File is written under a unique temporary name in the same directory
+     * and then renamed over path, so readers sharing the file (which may
+     * have it mapped) always see either the old or the new complete file. */
+    std::vector<char> tmp(path.begin(), path.end());
+    const char        suffix[] = ".XXXXXX";
+
+    tmp.insert(tmp.end(), suffix, suffix + sizeof(suffix));
+
+    int fd = mkstemp(&tmp[0]);
+    if (fd < 0){
+        throw std::runtime_error("cannot open plan file for writing");
+    }
+
+    bool ok = fchmod(fd, 0644) == 0 && WriteAll(fd, header, sizeof(header));
+
+    for (unsigned a = 0; a < 3 && ok; ++a){
+        const AxisPlan            & p = engine.plan(a);
+        const std::vector<double> & v = p.table().doubleValues();
+        const std::vector<size_t> & e = p.table().entries();
+
+        std::vector<uint64_t> words(2 * p.size());
+
+        for (size_t i = 0; i < p.size(); ++i){
+            words[i]            = p.start(i);
+            words[p.size() + i] = e[i];
+        }
+
+        ok = WriteAll(fd, &words[0], words.size() * sizeof(uint64_t)) &&
+             WriteAll(fd, &v[0], v.size() * sizeof(double));
+    }
+
+    ok = ok && fsync(fd) == 0;
+    ok = close(fd) == 0 && ok;
+    ok = ok && std::rename(&tmp[0], path.c_str()) == 0;
+
+    if (!ok){
+        unlink(&tmp[0]);
+        throw std::runtime_error("cannot write plan file");
+    }
+}
+
+
+bool ReadPlanFile (const std::string &     path,
+                   const QGrid       & q1Coords,
+                   const QGrid       & q2Coords,
+                   const QGrid       & q3Coords,
+                   const unsigned    &    width,
+                   const unsigned    & maxOrder,
+                   AxisPlan          *    plans)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0){
+        return false;
+    }
+
+    struct stat st;
+    void      * map = MAP_FAILED;
+
+    if (fstat(fd, &st) == 0 && (size_t) st.st_size >= HEADER_WORDS * 8){
+        map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+
+    if (map == MAP_FAILED){
+        return false;
+    }
+
+    const size_t     bytes     = (size_t) st.st_size;
+    const uint64_t * header    = static_cast<const uint64_t *>(map);
+    const unsigned   widths[3] = { width, width, width };
+    const unsigned   orders[3] = { maxOrder, maxOrder, maxOrder };
+    const QGrid    * q[3]      = { &q1Coords, &q2Coords, &q3Coords };
+
+    /* Header has to match the grid; axis data has to be within file. */
+    bool ok = header[0] == (PLAN_FILE_MAGIC | (PLAN_FILE_VERSION << 32)) &&
+              header[1] == PlanHash(q1Coords, q2Coords, q3Coords,
+                                    widths, orders);
+
+    for (unsigned a = 0; a < 3 && ok; ++a){
+        const uint64_t * h = header + 2 + 5*a;
+        const uint64_t   w = (uint64_t) (maxOrder + 1) * width;
+
+        ok = h[0] == q[a]->size() && h[1] == width && h[2] == maxOrder &&
+             h[4] % 8 == 0 && h[3] <= h[0] &&
+             h[4] <= bytes && (bytes - h[4]) / 8 >= 2 * h[0] + h[3] * w;
+    }
+
+    /* Restoring plans (arrays copied from mapped memory as they are). */
+    AxisPlan restored[3];
+
+    try {
+        for (unsigned a = 0; a < 3 && ok; ++a){
+            const uint64_t * h = header + 2 + 5*a;
+            const size_t     n = (size_t) h[0];
+            const uint64_t * s = header + h[4] / 8;
+            const double   * v = reinterpret_cast<const double *>(s + 2*n);
+
+            StencilTable table((maxOrder + 1) * width);
+
+            table.assign(std::vector<double>(v, v + h[3] * table.length()),
+                         std::vector<float>(),
+                         std::vector<size_t>(s + n, s + 2*n));
+
+            restored[a] = AxisPlan(width, maxOrder,
+                                   std::vector<size_t>(s, s + n), table);
+        }
+    }
+    catch (const std::invalid_argument &){
+        ok = false;
+    }
+
+    munmap(map, bytes);
+
+    if (ok){
+        for (unsigned a = 0; a < 3; ++a){
+            plans[a] = restored[a];
+        }
+    }
+    return ok;
+}
+
+
+FieldEngine CachedFieldEngine (const std::string &     path,
+                               const QGrid       & q1Coords,
+                               const QGrid       & q2Coords,
+                               const QGrid       & q3Coords,
+                               const unsigned    &    width,
+                               const unsigned    & maxOrder,
+                               const bool        &    write)
+{
+    AxisPlan plans[3];
+
+    if (ReadPlanFile(path, q1Coords, q2Coords, q3Coords, width, maxOrder,
+                     plans)){
+        return FieldEngine(q1Coords, q2Coords, q3Coords, plans);
+    }
+
+    /* Plans calculated again. */
+    FieldEngine engine(q1Coords, q2Coords, q3Coords, width, maxOrder);
+
+    if (write){
+        try {
+            WritePlanFile(path, engine);
+        }
+        catch (const std::runtime_error &){
+            /* Plans are still valid, only the next start is slower. */
+        }
+    }
+    return engine;
+}
+
+} /* namespace GridDiff */
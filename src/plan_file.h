@@ -0,0 +1,135 @@
+/*
+ * File: plan_file.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing a binary file format for coefficient plans of
+ * FieldEngine (see axis_plan.h and field_engine.h header files), so that
+ * coefficients of large non-uniform grids are calculated once and loaded
+ * at every later start: WritePlanFile, ReadPlanFile and CachedFieldEngine
+ * functions.
+ */
+
+#ifndef GRIDDIFF_PLAN_FILE_H
+#define GRIDDIFF_PLAN_FILE_H
+
+#include "qobj.h"          /* QGrid */
+#include "axis_plan.h"     /* AxisPlan */
+#include "field_engine.h"  /* FieldEngine */
+
+#include <string>          /* std::string */
+
+namespace GridDiff
+{
+
+/*
+ * PlanHash()
+ *
+ * Returns 64-bit hash (FNV-1a) of grid point positions of q1, q2 and q3
+ * axes together with stencil widths and max orders of their plans. Plan
+ * files are only used for grids of the same hash.
+ */
+unsigned long long PlanHash (const QGrid    &    q1Coords,
+                             const QGrid    &    q2Coords,
+                             const QGrid    &    q3Coords,
+                             const unsigned *      widths,
+                             const unsigned *   maxOrders);
+
+/*
+ * WritePlanFile()
+ *
+ * Writes plans of q1, q2 and q3 axes of an engine to a file.
+ *
+ * File starts with a header (format version, grid hash and, for every
+ * axis, size, stencil width, max order, number of distinct coefficient
+ * rows and offset of axis data), followed by data of every axis: stencil
+ * starts, row offsets (64-bit integers) and distinct coefficient rows
+ * (doubles). All arrays are 8-byte aligned and stored in host byte order,
+ * so they are used as they are after the file is mapped into memory.
+ *
+ * The file is written to a temporary file in the same directory, which
+ * then replaces path (rename), so processes reading a shared plan file
+ * are not affected and a failed write leaves the old file unchanged.
+ *
+ * -----------
+ *  Arguments
+ * -----------
+ * const std::string & path
+ *     Output file path (replaced if exists).
+ *
+ * const FieldEngine & engine
+ *     Engine whose plans are written.
+ *
+ * ------------
+ *  Exceptions
+ * ------------
+ * std::runtime_error if file cannot be written.
+ */
+void WritePlanFile (const std::string &   path,
+                    const FieldEngine & engine);
+
+/*
+ * ReadPlanFile()
+ *
+ * Maps a plan file into memory (mmap) and restores plans of q1, q2 and q3
+ * axes, if the file was written for given grid (same PlanHash), with
+ * given stencil width and max order.
+ *
+ * -----------
+ *  Arguments
+ * -----------
+ * const std::string & path
+ *     Plan file path.
+ *
+ * const QGrid & q1Coords
+ * const QGrid & q2Coords
+ * const QGrid & q3Coords
+ *     Grid point positions along axes q1, q2 and q3.
+ *
+ * const unsigned & width
+ * const unsigned & maxOrder
+ *     Stencil width and max order of plans of every axis.
+ *
+ * AxisPlan * plans
+ *     Array receiving plans of q1, q2 and q3 axes (unchanged if false is
+ *     returned).
+ *
+ * ---------
+ *  Returns
+ * ---------
+ * True if plans were read; false if file does not exist, is not a valid
+ * plan file of the current version or was written for another grid.
+ */
+bool ReadPlanFile (const std::string &     path,
+                   const QGrid       & q1Coords,
+                   const QGrid       & q2Coords,
+                   const QGrid       & q3Coords,
+                   const unsigned    &    width,
+                   const unsigned    & maxOrder,
+                   AxisPlan          *    plans);
+
+/*
+ * CachedFieldEngine()
+ *
+ * Creates FieldEngine with plans read from a plan file (see
+ * ReadPlanFile()). If they cannot be read (e.g. on hash mismatch), plans
+ * are calculated and, if write is true, stored in the file for later
+ * starts (failures of writing are ignored).
+ *
+ * ------------
+ *  Exceptions
+ * ------------
+ * std::invalid_argument if arguments are invalid (see FieldEngine
+ * constructor).
+ */
+FieldEngine CachedFieldEngine (const std::string &     path,
+                               const QGrid       & q1Coords,
+                               const QGrid       & q2Coords,
+                               const QGrid       & q3Coords,
+                               const unsigned    &    width,
+                               const unsigned    & maxOrder,
+                               const bool        &    write = true);
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_PLAN_FILE_H */
@@ -1,18 +1,20 @@
 /*
  * File: qobj.h
  * Author(s): P Kuszaj
- * Last changed: 29.01.2015
+ * Last changed: 18.10.2026
  *
  * A header file providing a QPoint struct and QGrid typedef.
  * QPoint should be used to hold position of a 3-dimensional
  * point. QGrid should be used to hold multiple double values
  * (like particular coordinate values for multiple points
- * belonging to the same axis).
+ * belonging to the same axis). QFieldIndex function describes
+ * memory layout of fields defined on tensor grids.
  */
 
 #ifndef GRIDDIFF_QOBJ_H
 #define GRIDDIFF_QOBJ_H
 
+#include <cstddef> /* size_t */
 #include <vector>  /* std::vector */
 
 namespace GridDiff
@@ -47,6 +49,21 @@ struct QPoint
 typedef std::vector<double> QGrid;
 
 
+/*
+ * QFieldIndex()
+ *
+ * Fields (function values at all nodes of a tensor grid spanned by q1, q2
+ * and q3 axes with n1, n2 and n3 grid points respectively) are stored as
+ * contiguous arrays of doubles with q1 index varying fastest and q3 index
+ * varying slowest. Returns position of (i1,i2,i3) node value in such array.
+ */
+inline size_t QFieldIndex (size_t i1, size_t i2, size_t i3,
+                           size_t n1, size_t n2)
+{
+    return i1 + n1 * (i2 + n2 * i3);
+}
+
+
 } /* namespace GridDiff */
 
 #endif /* GRIDDIFF_QOBJ_H */
@@ -0,0 +1,158 @@
+/*
+ * File: regridder.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing Regridder class methods implementation
+ * (declared in regridder.h header file).
+ */
+
+#include "regridder.h"
+#include "fornberg_nderivs.h" /* FornbergNumDerivsCoeffs */
+#include "util.h"             /* IsIncreasing */
+
+#include <algorithm>          /* std::upper_bound */
+#include <stdexcept>          /* std::invalid_argument */
+
+namespace GridDiff
+{
+
+namespace
+{
+
+/*
+ * Returns index of the first of width grid nodes closest to x (window is
+ * shifted inwards near axis boundaries).
+ */
+size_t WindowStart (const QGrid & coords, const double & x,
+                    const unsigned & width)
+{
+    long pos   = std::upper_bound(coords.begin(), coords.end(), x)
+               - coords.begin();
+    long start = pos - (long) (width / 2);
+    long last  = (long) coords.size() - (long) width;
+
+    if (start < 0)   { start = 0; }
+    if (start > last){ start = last; }
+
+    return (size_t) start;
+}
+
+} /* anonymous namespace */
+
+
+Regridder::Regridder (const QGrid               & q1Coords,
+                      const QGrid               & q2Coords,
+                      const QGrid               & q3Coords,
+                      const std::vector<QPoint> &  targets,
+                      const unsigned            &    width)
+{
+    /* If one of arguments is invalid, throw exception. */
+    if (width == 0){
+        throw std::invalid_argument("zero interpolation width");
+    }
+
+    if (q1Coords.size() < width){
+        throw std::invalid_argument("q1 grid size < interpolation width");
+    }
+    if (q2Coords.size() < width){
+        throw std::invalid_argument("q2 grid size < interpolation width");
+    }
+    if (q3Coords.size() < width){
+        throw std::invalid_argument("q3 grid size < interpolation width");
+    }
+
+    if (!IsIncreasing(q1Coords)){
+        throw std::invalid_argument("q1 grid not strictly increasing");
+    }
+    if (!IsIncreasing(q2Coords)){
+        throw std::invalid_argument("q2 grid not strictly increasing");
+    }
+    if (!IsIncreasing(q3Coords)){
+        throw std::invalid_argument("q3 grid not strictly increasing");
+    }
+
+    /* Setting members. */
+    mN1         = q1Coords.size();
+    mN2         = q2Coords.size();
+    mSourceSize = mN1 * mN2 * q3Coords.size();
+    mWidth      = width;
+
+    mOffsets.resize(targets.size());
+    mWeights.resize(targets.size() * 3 * width);
+
+    /* Calculating stencil positions and weights for every target. */
+    const long nt = (long) targets.size();
+
+    #pragma omp parallel for schedule(static)
+    for (long t = 0; t < nt; ++t){
+        const QPoint & q = targets[t];
+        double       * w = &mWeights[t * 3 * width];
+
+        size_t s1 = WindowStart(q1Coords, q.q1, width);
+        size_t s2 = WindowStart(q2Coords, q.q2, width);
+        size_t s3 = WindowStart(q3Coords, q.q3, width);
+
+        FornbergNumDerivsCoeffs(w,           q.q1, &q1Coords[s1], width, 1);
+        FornbergNumDerivsCoeffs(w +   width, q.q2, &q2Coords[s2], width, 1);
+        FornbergNumDerivsCoeffs(w + 2*width, q.q3, &q3Coords[s3], width, 1);
+
+        mOffsets[t] = QFieldIndex(s1, s2, s3, mN1, mN2);
+    }
+}
+
+
+void Regridder::apply (const double * src, double * dst) const
+{
+    std::vector<const double *> srcs(1, src);
+    std::vector<double *>       dsts(1, dst);
+
+    apply(srcs, dsts);
+}
+
+
+void Regridder::apply (const std::vector<const double *> & srcs,
+                       const std::vector<double *>       & dsts) const
+{
+    if (srcs.size() != dsts.size()){
+        throw std::invalid_argument("source and target field counts differ");
+    }
+
+    const long     nt     = (long) mOffsets.size();
+    const size_t   nf     = srcs.size();
+    const size_t   plane  = mN1 * mN2;
+    const unsigned width  = mWidth;
+
+    #pragma omp parallel for schedule(static)
+    for (long t = 0; t < nt; ++t){
+        const double * w1 = &mWeights[t * 3 * width];
+        const double * w2 = w1 + width;
+        const double * w3 = w2 + width;
+
+        for (size_t f = 0; f < nf; ++f){
+            const double * base = srcs[f] + mOffsets[t];
+            double         val  = 0.0;
+
+            /* Contract along q1 (contiguous), then q2 and q3. */
+            for (unsigned c = 0; c < width; ++c){
+                const double * pl  = base + c * plane;
+                double         v2  = 0.0;
+
+                for (unsigned b = 0; b < width; ++b){
+                    const double * row = pl + b * mN1;
+                    double         v1  = 0.0;
+
+                    for (unsigned a = 0; a < width; ++a){
+                        v1 += w1[a] * row[a];
+                    }
+                    v2 += w2[b] * v1;
+                }
+                val += w3[c] * v2;
+            }
+
+            dsts[f][t] = val;
+        }
+    }
+}
+
+} /* namespace GridDiff */
@@ -0,0 +1,170 @@
+/*
+ * File: regridder.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing Regridder class used for transferring fields
+ * known at nodes of a tensor grid (spanned by q1, q2 and q3 axes) to an
+ * arbitrary set of target points. Tensor-product polynomial interpolation
+ * is used, with weights generated by Fornberg algorithm (derivative of
+ * order 0). For further information please see fornberg_nderivs.h header
+ * file.
+ */
+
+#ifndef GRIDDIFF_REGRIDDER_H
+#define GRIDDIFF_REGRIDDER_H
+
+#include "qobj.h"  /* QPoint, QGrid, QFieldIndex */
+
+#include <vector>  /* std::vector */
+
+namespace GridDiff
+{
+
+/*
+ * Regridder class
+ *
+ * Precomputes interpolation weights from a source tensor grid to a given
+ * set of target points and applies them to any number of fields defined
+ * on the source grid (memory layout described in qobj.h header file).
+ *
+ * For every target point and every axis, width grid nodes closest to the
+ * target coordinate are chosen (windows are shifted inwards near grid
+ * boundaries, so points outside the grid are extrapolated). Interpolated
+ * value is then a tensor product of three one-dimensional interpolations,
+ * which are evaluated one axis at a time (width^3 multiplications per
+ * target point and field).
+ *
+ * Weights depend only on grid and target positions, so a single instance
+ * should be constructed once and reused for every field and every time
+ * step. Target points have to be expressed in the source grid coordinates
+ * (e.g. cartesian target points have to be converted to r, theta and phi
+ * before regridding from spherical grid).
+ *
+ * Weights are stored compactly: for every target only the position of its
+ * first stencil node in the source field and 3*width weights are kept.
+ */
+class Regridder
+{
+    protected:
+        /* Number of source grid points along q1 and q2 axes. */
+        size_t                 mN1,
+                               mN2;
+        /* Total number of source grid points. */
+        size_t                 mSourceSize;
+        /* Number of grid points used along each axis. */
+        unsigned               mWidth;
+        /* Position of first stencil node in source field for every
+         * target point. */
+        std::vector<size_t>    mOffsets;
+        /* Interpolation weights: for every target point width weights
+         * along q1 axis, followed by those along q2 and q3 axes. */
+        std::vector<double>    mWeights;
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Constructor
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const QGrid & q1Coords
+         * const QGrid & q2Coords
+         * const QGrid & q3Coords
+         *     Source grid point positions along axes q1, q2 and q3. For
+         *     each axis those positions have to be strictly increasing.
+         *
+         * const std::vector<QPoint> & targets
+         *     Target points (in source grid coordinates).
+         *
+         * const unsigned & width
+         *     Number of grid points used along each axis (polynomial
+         *     degree plus one).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * width is zero
+         *     * Any of qiCoords is of size < width
+         *     * Any of qiCoords is not strictly increasing
+         */
+        Regridder (const QGrid               & q1Coords,
+                   const QGrid               & q2Coords,
+                   const QGrid               & q3Coords,
+                   const std::vector<QPoint> &  targets,
+                   const unsigned            &    width);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /*
+         * targets()
+         *
+         * Returns number of target points.
+         */
+        size_t targets () const { return mOffsets.size(); }
+
+        /*
+         * sourceSize()
+         *
+         * Returns number of values in every source field.
+         */
+        size_t sourceSize () const { return mSourceSize; }
+
+        /*
+         * apply()
+         *
+         * Interpolates a single field to all target points. Target points
+         * are processed in parallel (if OpenMP is enabled).
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const double * src
+         *     Source field values (sourceSize() values).
+         *
+         * double * dst
+         *     Array receiving targets() interpolated values.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * None.
+         */
+        void apply (const double * src, double * dst) const;
+
+        /*
+         * apply()
+         *
+         * Interpolates multiple fields to all target points. Weights of
+         * every target point are loaded once and applied to all fields.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const std::vector<const double *> & srcs
+         *     Source fields (sourceSize() values each).
+         *
+         * const std::vector<double *> & dsts
+         *     Arrays receiving targets() interpolated values for
+         *     corresponding source fields.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if srcs and dsts are of different sizes.
+         */
+        void apply (const std::vector<const double *> & srcs,
+                    const std::vector<double *>       & dsts) const;
+
+}; /* class Regridder */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_REGRIDDER_H */
@@ -0,0 +1,352 @@
+/*
+ * File: roofline.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing roofline analysis functions implementation
+ * (declared in roofline.h header file).
+ */
+
+#include "roofline.h"
+#include "fornberg_nderivs.h" /* FORNBERG_GENERAL, FORNBERG_ANTISYMMETRIC */
+#include "Gradients.h"        /* CartesianGradient, ... */
+#include "Laplacians.h"       /* CartesianLaplacian, ... */
+#include "util.h"     /* MonotonicSeconds */
+
+#include <cmath>      /* sin */
+#include <cstdio>     /* snprintf */
+#include <stdexcept>  /* std::invalid_argument */
+#include <vector>     /* std::vector */
+
+
+#ifdef _OPENMP
+#include <omp.h>      /* omp_get_num_threads */
+#endif
+
+namespace GridDiff
+{
+
+namespace
+{
+
+/* Number of independent multiply-add chains per thread (enough to hide
+ * latency of vectorized FMA units). */
+const unsigned FMA_CHAINS     = 32;
+/* Number of multiply-adds per chain per measurement. */
+const long     FMA_ITERATIONS = 1 << 22;
+
+/* Sink for results of measurement loops (so they cannot be removed). */
+volatile double gSink = 0.0;
+
+/*
+ * Returns flops of kth derivative stencils along an axis, averaged over
+ * its nodes: 2*width for general coefficients; for (anti)symmetric ones
+ * mirrored values are added (subtracted) first, so there are width/2
+ * such additions and width/2 (or (width+1)/2) multiply-adds.
+ */
+double StencilFlops (const AxisPlan & p,
+                     const unsigned & k)
+{
+    const unsigned w = p.width();
+    double         flops = 0.0;
+
+    for (size_t i = 0; i < p.size(); ++i){
+        const int sym = p.symmetry(i, k);
+
+        if (sym == FORNBERG_GENERAL){
+            flops += 2.0 * w;
+        }
+        else if (sym == FORNBERG_ANTISYMMETRIC){
+            flops += 3.0 * (w/2);
+        }
+        else {
+            flops += 3.0 * (w/2) + 2.0 * (w % 2);
+        }
+    }
+    return p.size() ? flops / p.size() : 0.0;
+}
+
+/*
+ * Sum of point operator result components (stored, so evaluations cannot
+ * be removed).
+ */
+inline double ResultSum (const QPoint & r) { return r.q1 + r.q2 + r.q3; }
+inline double ResultSum (const double & r) { return r; }
+
+} /* anonymous namespace */
+
+
+OperatorCost FieldOperatorCost (const FieldEngine   & engine,
+                                const FieldOperator &     op)
+{
+    OperatorCost cost;
+    unsigned     q1Orders = 0;
+
+    for (unsigned axis = 0; axis < 3; ++axis){
+        const AxisPlan & p = engine.plan(axis);
+
+        for (unsigned k = 1; k <= op.maxOrder(); ++k){
+            if (op.uses(axis, k)){
+                cost.flops += StencilFlops(p, k);
+                if (axis == AXIS_Q1){ ++q1Orders; }
+            }
+        }
+    }
+
+    /* The q1 coefficient table (n1*width values per order) is read by every
+     * row, i.e. it stays in cache and its traffic is amortized over all
+     * rows. */
+    const double rows = (double) engine.n2() * engine.n3();
+    const double q1Table = q1Orders * engine.plan(AXIS_Q1).width();
+
+    cost.bytes = sizeof(double) * ( 1.0
+                                  + 2.0 * op.components()
+                                  + (rows > 0.0 ? q1Table / rows : 0.0) );
+
+    return cost;
+}
+
+
+OperatorCost PointOperatorCost (const Basic_3D_DiffOp & op)
+{
+    OperatorCost cost;
+
+    for (unsigned axis = 0; axis < 3; ++axis){
+        const double table  = op.coeffTableSize(axis);
+        const double points = table / (op.maxOrder() + 1);
+
+        cost.flops += 2.0 * table;
+        cost.bytes += sizeof(double) * points;
+    }
+
+    cost.bytes += sizeof(double);
+
+    return cost;
+}
+
+
+MachineRoofline MeasureMachineRoofline (const size_t   & elements,
+                                        const unsigned &  repeats)
+{
+    /* If arguments invalid, throw exception. */
+    if (elements == 0 || repeats == 0){
+        throw std::invalid_argument("zero roofline measurement size");
+    }
+
+    MachineRoofline machine;
+    const long      n = (long) elements;
+
+    std::vector<double> a(elements), b(elements), c(elements);
+
+    /* Arrays are initialized in parallel (first touch). */
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < n; ++i){
+        a[i] = 0.0;
+        b[i] = 1.0;
+        c[i] = 2.0;
+    }
+
+    /* Bandwidth: triad. */
+    for (unsigned r = 0; r < repeats; ++r){
+        const double s  = 1.0 + 1e-3 * r;
+        const double t0 = MonotonicSeconds();
+
+        #pragma omp parallel for schedule(static)
+        for (long i = 0; i < n; ++i){
+            a[i] = b[i] + s * c[i];
+        }
+
+        const double bw = 3.0 * sizeof(double) * elements
+                              / (MonotonicSeconds() - t0);
+        if (bw > machine.bandwidth){ machine.bandwidth = bw; }
+    }
+
+    /* Peak: independent chains x = x*m + d (kept in registers). */
+    double sink = 0.0;
+
+    for (unsigned r = 0; r < repeats; ++r){
+        int nth = 1;
+        const double t0 = MonotonicSeconds();
+
+        #pragma omp parallel reduction(+:sink)
+        {
+#ifdef _OPENMP
+            #pragma omp master
+            nth = omp_get_num_threads();
+#endif
+            double x[FMA_CHAINS];
+            const double m = 0.999999, d = 1e-7;
+
+            for (unsigned j = 0; j < FMA_CHAINS; ++j){
+                x[j] = 1.0 + j;
+            }
+
+            for (long it = 0; it < FMA_ITERATIONS; ++it){
+                for (unsigned j = 0; j < FMA_CHAINS; ++j){
+                    x[j] = x[j] * m + d;
+                }
+            }
+
+            for (unsigned j = 0; j < FMA_CHAINS; ++j){
+                sink += x[j];
+            }
+        }
+
+        const double flops = 2.0 * FMA_CHAINS * FMA_ITERATIONS * nth
+                                 / (MonotonicSeconds() - t0);
+        if (flops > machine.peakFlops){ machine.peakFlops = flops; }
+    }
+
+    gSink = sink + a[n/2];
+
+    return machine;
+}
+
+
+RooflineEntry MeasureFieldOperator (const FieldEngine   &  engine,
+                                    const FieldOperator &      op,
+                                    const std::string   &    name,
+                                    const unsigned      & repeats)
+{
+    /* If arguments invalid, throw exception. */
+    if (repeats == 0){
+        throw std::invalid_argument("zero repeats");
+    }
+
+    const size_t        N = engine.size();
+    std::vector<double> f(N), out(N * op.components());
+
+    for (size_t i = 0; i < N; ++i){
+        f[i] = 1.0 + sin(1e-3 * i);
+    }
+
+    RooflineEntry entry;
+    entry.name   = name;
+    entry.cost   = FieldOperatorCost(engine, op);
+    entry.points = (double) N;
+
+    /* Warm-up evaluation (thread creation, page faults). */
+    engine.apply(op, &f[0], &out[0]);
+
+    for (unsigned r = 0; r < repeats; ++r){
+        const double t0 = MonotonicSeconds();
+        engine.apply(op, &f[0], &out[0]);
+        const double t  = MonotonicSeconds() - t0;
+
+        if (r == 0 || t < entry.seconds){ entry.seconds = t; }
+    }
+
+    return entry;
+}
+
+
+template <class Op>
+RooflineEntry MeasurePointOperator (const Op          &      op,
+                                    const std::string &    name,
+                                    const size_t      &  points,
+                                    const unsigned    & repeats)
+{
+    /* If arguments invalid, throw exception. */
+    if (points == 0 || repeats == 0){
+        throw std::invalid_argument("zero roofline measurement size");
+    }
+
+    const long np = (long) points;
+
+    /* Function values along every axis of every point (distinct for
+     * every evaluation, like values of different grid nodes) and results.
+     * Both are initialized in parallel (first touch). */
+    std::vector<QGrid>  v(3 * points);
+    std::vector<double> out(points);
+
+    #pragma omp parallel for schedule(static)
+    for (long p = 0; p < np; ++p){
+        for (unsigned a = 0; a < 3; ++a){
+            const size_t n = op.coeffTableSize(a) / (op.maxOrder() + 1);
+
+            v[3*p + a].resize(n);
+            for (size_t i = 0; i < n; ++i){
+                v[3*p + a][i] = 1.0 + sin(1e-3 * p + a + 0.7 * i);
+            }
+        }
+        out[p] = 0.0;
+    }
+
+    RooflineEntry entry;
+    entry.name   = name;
+    entry.cost   = PointOperatorCost(op);
+    entry.points = (double) points;
+
+    /* Warm-up evaluation (page faults, thread creation) is not timed. */
+    for (unsigned r = 0; r <= repeats; ++r){
+        const double t0 = MonotonicSeconds();
+
+        #pragma omp parallel for schedule(static)
+        for (long p = 0; p < np; ++p){
+            out[p] = ResultSum(op.eval(v[3*p], v[3*p + 1], v[3*p + 2]));
+        }
+
+        const double t = MonotonicSeconds() - t0;
+
+        if (r == 1 || (r > 1 && t < entry.seconds)){ entry.seconds = t; }
+    }
+
+    gSink = out[np/2];
+
+    return entry;
+}
+
+template RooflineEntry MeasurePointOperator<CartesianGradient>
+    (const CartesianGradient &, const std::string &, const size_t &,
+     const unsigned &);
+template RooflineEntry MeasurePointOperator<CylindricalGradient>
+    (const CylindricalGradient &, const std::string &, const size_t &,
+     const unsigned &);
+template RooflineEntry MeasurePointOperator<SphericalGradient>
+    (const SphericalGradient &, const std::string &, const size_t &,
+     const unsigned &);
+template RooflineEntry MeasurePointOperator<CartesianLaplacian>
+    (const CartesianLaplacian &, const std::string &, const size_t &,
+     const unsigned &);
+template RooflineEntry MeasurePointOperator<CylindricalLaplacian>
+    (const CylindricalLaplacian &, const std::string &, const size_t &,
+     const unsigned &);
+template RooflineEntry MeasurePointOperator<SphericalLaplacian>
+    (const SphericalLaplacian &, const std::string &, const size_t &,
+     const unsigned &);
+
+
+void WriteRooflineReport (std::ostream                     &     os,
+                          const MachineRoofline            & machine,
+                          const std::vector<RooflineEntry> & entries)
+{
+    char line[256];
+
+    snprintf(line, sizeof(line),
+             "machine: %.2f GB/s, %.2f GFLOP/s, ridge %.3f flop/B\n",
+             1e-9 * machine.bandwidth, 1e-9 * machine.peakFlops,
+             machine.ridge());
+    os << line;
+
+    snprintf(line, sizeof(line), "%-28s %8s %8s %8s %10s %10s %10s %8s %7s\n",
+             "kernel", "flop/pt", "B/pt", "flop/B", "GFLOP/s", "GB/s",
+             "bound", "type", "of bnd");
+    os << line;
+
+    for (size_t i = 0; i < entries.size(); ++i){
+        const RooflineEntry & e     = entries[i];
+        const double          I     = e.cost.intensity();
+        const double          bound = machine.bound(I);
+        const bool            mem   = I < machine.ridge();
+
+        snprintf(line, sizeof(line),
+                 "%-28s %8.1f %8.1f %8.3f %10.2f %10.2f %10.2f %8s %6.1f%%\n",
+                 e.name.c_str(), e.cost.flops, e.cost.bytes, I,
+                 1e-9 * e.flopRate(), 1e-9 * e.byteRate(), 1e-9 * bound,
+                 mem ? "memory" : "compute",
+                 bound > 0.0 ? 100.0 * e.flopRate() / bound : 0.0);
+        os << line;
+    }
+}
+
+} /* namespace GridDiff */
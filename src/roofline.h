@@ -0,0 +1,220 @@
+/*
+ * File: roofline.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing functions for roofline analysis of operator
+ * evaluation: theoretical costs (flops and bytes of memory traffic per
+ * output point) of operators, measurement of machine bandwidth and peak
+ * flop rate, measurement of achieved throughput and a report comparing
+ * them.
+ */
+
+#ifndef GRIDDIFF_ROOFLINE_H
+#define GRIDDIFF_ROOFLINE_H
+
+#include "basic_3D_diffop.h"  /* Basic_3D_DiffOp */
+#include "field_engine.h"     /* FieldEngine */
+#include "field_operator.h"   /* FieldOperator */
+
+#include <ostream>            /* std::ostream */
+#include <string>             /* std::string */
+#include <vector>             /* std::vector */
+
+namespace GridDiff
+{
+
+/*
+ * OperatorCost struct
+ *
+ * Theoretical cost of evaluating an operator at one output point.
+ */
+struct OperatorCost
+{
+    /* Floating point operations (multiplications and additions). */
+    double flops;
+    /* Minimal memory traffic (in bytes). */
+    double bytes;
+
+    OperatorCost () : flops(0.0), bytes(0.0) { }
+
+    /* Arithmetic intensity (flops per byte). */
+    double intensity () const { return bytes > 0.0 ? flops / bytes : 0.0; }
+};
+
+/*
+ * MachineRoofline struct
+ *
+ * Measured machine limits.
+ */
+struct MachineRoofline
+{
+    /* Memory bandwidth (bytes per second). */
+    double bandwidth;
+    /* Peak flop rate (flops per second). */
+    double peakFlops;
+
+    MachineRoofline () : bandwidth(0.0), peakFlops(0.0) { }
+
+    /*
+     * bound()
+     *
+     * Attainable flop rate at given arithmetic intensity.
+     */
+    double bound (const double & intensity) const
+    {
+        const double mem = bandwidth * intensity;
+        return mem < peakFlops ? mem : peakFlops;
+    }
+
+    /* Intensity at which kernels become compute bound. */
+    double ridge () const { return bandwidth > 0.0 ? peakFlops / bandwidth
+                                                   : 0.0; }
+};
+
+/*
+ * RooflineEntry struct
+ *
+ * Measured kernel (see MeasureFieldOperator()).
+ */
+struct RooflineEntry
+{
+    /* Kernel description (e.g. operator name and stencil width). */
+    std::string  name;
+    /* Theoretical cost per output point. */
+    OperatorCost cost;
+    /* Output points per evaluation. */
+    double       points;
+    /* Best time of one evaluation (in seconds). */
+    double       seconds;
+
+    RooflineEntry () : points(0.0), seconds(0.0) { }
+
+    /* Achieved flop rate and memory bandwidth. */
+    double flopRate  () const { return cost.flops * points / seconds; }
+    double byteRate  () const { return cost.bytes * points / seconds; }
+};
+
+/*
+ * FieldOperatorCost()
+ *
+ * Theoretical cost of evaluating an operator with FieldEngine. Flops are
+ * those of stencils (per used derivative of order k >= 1: 2*width for
+ * general coefficients, about 1.5*width for (anti)symmetric ones, whose
+ * mirrored nodes are paired, see AxisPlan::symmetry(); averaged over axis
+ * nodes; the operator combination of derivatives is not counted). Traffic
+ * consists of reading the field once and writing output components (with
+ * write-allocate). Coefficient tables are not streamed from memory: q1
+ * coefficients change from node to node, but the same table is read by
+ * every row (its traffic is divided by the number of rows), and
+ * coefficients of other axes are reused along rows.
+ */
+OperatorCost FieldOperatorCost (const FieldEngine   & engine,
+                                const FieldOperator &     op);
+
+/*
+ * PointOperatorCost()
+ *
+ * Theoretical cost of evaluating an operator based on Basic_3D_DiffOp at
+ * a single point, assuming all derivatives along every axis are evaluated
+ * in one pass (fEvalQiDiffs): every coefficient is multiplied and added
+ * once (an upper bound for operators using fewer orders); function values
+ * are read once and one result value is written. Coefficients are not
+ * counted as memory traffic, since the operator is reused for every
+ * evaluation and its tables stay in cache.
+ */
+OperatorCost PointOperatorCost (const Basic_3D_DiffOp & op);
+
+/*
+ * MeasureMachineRoofline()
+ *
+ * Measures memory bandwidth with a STREAM-like triad kernel (a = b + s*c,
+ * 24 bytes per element) and peak flop rate with independent multiply-add
+ * chains, both run by all OpenMP threads.
+ *
+ * -----------
+ *  Arguments
+ * -----------
+ * const size_t & elements
+ *     Size of triad arrays. Should be much larger than last level cache
+ *     (three arrays of elements doubles are allocated).
+ *
+ * const unsigned & repeats
+ *     Number of measurements (the best one counts).
+ *
+ * ------------
+ *  Exceptions
+ * ------------
+ * std::invalid_argument if elements or repeats is zero.
+ */
+MachineRoofline MeasureMachineRoofline (const size_t   & elements = 1 << 25,
+                                        const unsigned &  repeats = 5);
+
+/*
+ * MeasureFieldOperator()
+ *
+ * Measures time of FieldEngine::apply() for given operator (on a synthetic
+ * field) and its theoretical cost.
+ *
+ * ------------
+ *  Exceptions
+ * ------------
+ * std::invalid_argument if repeats is zero.
+ * Exceptions thrown by FieldEngine::apply().
+ */
+RooflineEntry MeasureFieldOperator (const FieldEngine   &  engine,
+                                    const FieldOperator &      op,
+                                    const std::string   &    name,
+                                    const unsigned      & repeats = 5);
+
+/*
+ * MeasurePointOperator()
+ *
+ * Measures time of eval() of a point operator (CartesianGradient,
+ * CylindricalGradient, SphericalGradient, CartesianLaplacian,
+ * CylindricalLaplacian or SphericalLaplacian) at distinct sets of
+ * function values of points grid nodes (evaluated by all OpenMP threads
+ * sharing the operator; the sum of result components of every point is
+ * stored) and its theoretical cost (see PointOperatorCost()).
+ *
+ * -----------
+ *  Arguments
+ * -----------
+ * const Op & op
+ *     Measured operator.
+ *
+ * const std::string & name
+ *     Kernel description.
+ *
+ * const size_t & points
+ *     Number of evaluations (sets of function values) per measurement.
+ *
+ * const unsigned & repeats
+ *     Number of measurements (the best one counts).
+ *
+ * ------------
+ *  Exceptions
+ * ------------
+ * std::invalid_argument if points or repeats is zero.
+ * Exceptions thrown by op.eval().
+ */
+template <class Op>
+RooflineEntry MeasurePointOperator (const Op          &      op,
+                                    const std::string &    name,
+                                    const size_t      &  points = 1 << 16,
+                                    const unsigned    & repeats = 5);
+
+/*
+ * WriteRooflineReport()
+ *
+ * Writes a table with cost, achieved throughput, attainable bound, bound
+ * type (memory or compute) and fraction of the bound achieved by every
+ * kernel.
+ */
+void WriteRooflineReport (std::ostream                     &     os,
+                          const MachineRoofline            & machine,
+                          const std::vector<RooflineEntry> & entries);
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_ROOFLINE_H */
@@ -0,0 +1,312 @@
+/*
+ * File: scattered_evaluator.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing ScatteredEvaluator class methods implementation
+ * (declared in scattered_evaluator.h header file).
+ */
+
+#include "scattered_evaluator.h"
+#include "fornberg_nderivs.h" /* FornbergNumDerivsCoeffs */
+#include "morton.h"           /* MortonKey */
+#include "util.h"             /* IsIncreasing */
+
+#include <algorithm>          /* std::upper_bound, std::sort */
+#include <cmath>              /* fabs, floor */
+#include <stdexcept>          /* std::invalid_argument */
+#include <utility>            /* std::pair, std::make_pair */
+
+namespace GridDiff
+{
+
+namespace
+{
+
+/*
+ * Checks whether axis coordinates are equally spaced (up to rounding
+ * errors of their generation).
+ */
+bool IsUniform (const QGrid & coords)
+{
+    const size_t n = coords.size();
+    const double h = (coords[n-1] - coords[0]) / (n - 1);
+
+    for (size_t i = 1; i < n - 1; ++i){
+        if (fabs(coords[i] - (coords[0] + i * h)) > 1e-10 * h){
+            return false;
+        }
+    }
+    return true;
+}
+
+} /* anonymous namespace */
+
+
+ScatteredEvaluator::ScatteredEvaluator (const QGrid    & q1Coords,
+                                        const QGrid    & q2Coords,
+                                        const QGrid    & q3Coords,
+                                        const unsigned &    width)
+{
+    /* If one of arguments is invalid, throw exception. */
+    if (width < 2){
+        throw std::invalid_argument("stencil width < 2");
+    }
+
+    if (q1Coords.size() < width){
+        throw std::invalid_argument("q1 grid size < stencil width");
+    }
+    if (q2Coords.size() < width){
+        throw std::invalid_argument("q2 grid size < stencil width");
+    }
+    if (q3Coords.size() < width){
+        throw std::invalid_argument("q3 grid size < stencil width");
+    }
+
+    if (!IsIncreasing(q1Coords)){
+        throw std::invalid_argument("q1 grid not strictly increasing");
+    }
+    if (!IsIncreasing(q2Coords)){
+        throw std::invalid_argument("q2 grid not strictly increasing");
+    }
+    if (!IsIncreasing(q3Coords)){
+        throw std::invalid_argument("q3 grid not strictly increasing");
+    }
+
+    /* Setting members. */
+    mCoords[0] = q1Coords;
+    mCoords[1] = q2Coords;
+    mCoords[2] = q3Coords;
+    mWidth     = width;
+
+    for (unsigned axis = 0; axis < 3; ++axis){
+        const QGrid & q = mCoords[axis];
+
+        mUniform[axis] = IsUniform(q);
+        mOrigin[axis]  = q[0];
+        mInvStep[axis] = (q.size() - 1) / (q[q.size()-1] - q[0]);
+    }
+
+    /* Lagrange denominators of nodes 0, ..., width-1:
+     * prod_{b != a} (a - b) = (-1)^(width-1-a) a! (width-1-a)! */
+    mInvDenom.resize(width);
+
+    for (unsigned a = 0; a < width; ++a){
+        double d = 1.0;
+
+        for (unsigned b = 0; b < width; ++b){
+            if (b != a){
+                d *= (double) a - (double) b;
+            }
+        }
+        mInvDenom[a] = 1.0 / d;
+    }
+}
+
+
+size_t ScatteredEvaluator::window (const unsigned & axis,
+                                   const double   &    x) const
+{
+    const QGrid &  q     = mCoords[axis];
+    const unsigned w     = mWidth;
+    const long     last  = (long) q.size() - (long) w;
+    long           start;
+
+    /* Window start: (index of first node > x) - width/2, shifted inwards
+     * near boundaries. */
+    if (mUniform[axis]){
+        double pos = floor((x - mOrigin[axis]) * mInvStep[axis]) + 1.0;
+
+        if (!(pos > 0.0))           { pos = 0.0; }
+        if (pos > (double) q.size()){ pos = (double) q.size(); }
+
+        start = (long) pos - (long) (w / 2);
+    }
+    else {
+        start = (long) (std::upper_bound(q.begin(), q.end(), x) - q.begin())
+              - (long) (w / 2);
+    }
+
+    if (start < 0)   { start = 0; }
+    if (start > last){ start = last; }
+
+    return (size_t) start;
+}
+
+
+size_t ScatteredEvaluator::weights (const unsigned &  axis,
+                                    const double   &     x,
+                                    double         *    w0,
+                                    double         *    w1,
+                                    double         *  work) const
+{
+    const QGrid &  q     = mCoords[axis];
+    const unsigned w     = mWidth;
+    const size_t   start = window(axis, x);
+
+    if (!mUniform[axis]){
+        /* Orders 0 and 1 (coeffs[k*w + i]). */
+        FornbergNumDerivsCoeffs(work, x, &q[start], w, 2);
+
+        for (unsigned i = 0; i < w; ++i){
+            w0[i] = work[i];
+            w1[i] = work[w + i];
+        }
+        return start;
+    }
+
+    /* Lagrange basis on nodes 0, ..., w-1 at normalized coordinate u.
+     * Products of (u - b) over b < a (pv) and b > a (sv), together with
+     * their derivatives (pd, sd), give
+     *     L_a(u)  = pv[a] sv[a] / denom[a]
+     *     L_a'(u) = (pd[a] sv[a] + pv[a] sd[a]) / denom[a] */
+    const double u  = (x - q[start]) * mInvStep[axis];
+    double     * pv = work;
+    double     * pd = work +     w;
+    double     * sv = work + 2 * w;
+    double     * sd = work + 3 * w;
+
+    pv[0]   = 1.0;  pd[0]   = 0.0;
+    sv[w-1] = 1.0;  sd[w-1] = 0.0;
+
+    for (unsigned j = 1; j < w; ++j){
+        const double lo = u - (j - 1);
+        const double hi = u - (w - j);
+
+        pv[j]     = pv[j-1] * lo;
+        pd[j]     = pd[j-1] * lo + pv[j-1];
+        sv[w-1-j] = sv[w-j] * hi;
+        sd[w-1-j] = sd[w-j] * hi + sv[w-j];
+    }
+
+    for (unsigned a = 0; a < w; ++a){
+        w0[a] = mInvDenom[a] * pv[a] * sv[a];
+        w1[a] = mInvDenom[a] * (pd[a] * sv[a] + pv[a] * sd[a])
+                             * mInvStep[axis];
+    }
+
+    return start;
+}
+
+
+std::vector<size_t> ScatteredEvaluator::mortonOrder
+                                    (const std::vector<QPoint> & points) const
+{
+    typedef std::pair<unsigned long long, size_t> Key;
+
+    const long       np = (long) points.size();
+    std::vector<Key> keys(points.size());
+
+    #pragma omp parallel for schedule(static)
+    for (long p = 0; p < np; ++p){
+        const unsigned long long s1 = window(0, points[p].q1),
+                                 s2 = window(1, points[p].q2),
+                                 s3 = window(2, points[p].q3);
+
+        keys[p] = std::make_pair(MortonKey(s1, s2, s3), (size_t) p);
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<size_t> order(points.size());
+
+    for (size_t p = 0; p < order.size(); ++p){
+        order[p] = keys[p].second;
+    }
+
+    return order;
+}
+
+
+void ScatteredEvaluator::gradient (const std::vector<QPoint> & points,
+                                   const double              *      f,
+                                   double                    *  grads,
+                                   double                    * values) const
+{
+    gradient(points, mortonOrder(points), f, grads, values);
+}
+
+
+void ScatteredEvaluator::gradient (const std::vector<QPoint> & points,
+                                   const std::vector<size_t> &  order,
+                                   const double              *      f,
+                                   double                    *  grads,
+                                   double                    * values) const
+{
+    /* If arguments invalid, throw exception. */
+    if (order.size() != points.size()){
+        throw std::invalid_argument("order and points are of different sizes");
+    }
+
+    const long     np    = (long) points.size();
+    const unsigned w     = mWidth;
+    const size_t   n1    = mCoords[0].size();
+    const size_t   n2    = mCoords[1].size();
+    const size_t   plane = n1 * n2;
+
+    #pragma omp parallel
+    {
+        std::vector<double> buf(10 * w);
+        double            * a0   = &buf[0];
+        double            * a1   = a0 + w;
+        double            * b0   = a1 + w;
+        double            * b1   = b0 + w;
+        double            * c0   = b1 + w;
+        double            * c1   = c0 + w;
+        double            * work = c1 + w;
+
+        #pragma omp for schedule(static)
+        for (long s = 0; s < np; ++s){
+            const size_t   p  = order[s];
+            const QPoint & q  = points[p];
+
+            const size_t s1 = weights(0, q.q1, a0, a1, work);
+            const size_t s2 = weights(1, q.q2, b0, b1, work);
+            const size_t s3 = weights(2, q.q3, c0, c1, work);
+
+            const double * base = f + QFieldIndex(s1, s2, s3, n1, n2);
+            double         val  = 0.0,
+                           g1   = 0.0,
+                           g2   = 0.0,
+                           g3   = 0.0;
+
+            /* Contract along q1 (contiguous), then q2 and q3. */
+            for (unsigned c = 0; c < w; ++c){
+                const double * pl  = base + c * plane;
+                double         t00 = 0.0,   /* w0 w0 */
+                               t10 = 0.0,   /* w1 w0 */
+                               t01 = 0.0;   /* w0 w1 */
+
+                for (unsigned b = 0; b < w; ++b){
+                    const double * row = pl + b * n1;
+                    double         r0  = 0.0,
+                                   r1  = 0.0;
+
+                    for (unsigned a = 0; a < w; ++a){
+                        r0 += a0[a] * row[a];
+                        r1 += a1[a] * row[a];
+                    }
+
+                    t00 += b0[b] * r0;
+                    t10 += b0[b] * r1;
+                    t01 += b1[b] * r0;
+                }
+
+                val += c0[c] * t00;
+                g1  += c0[c] * t10;
+                g2  += c0[c] * t01;
+                g3  += c1[c] * t00;
+            }
+
+            grads[3*p]     = g1;
+            grads[3*p + 1] = g2;
+            grads[3*p + 2] = g3;
+
+            if (values != NULL){
+                values[p] = val;
+            }
+        }
+    }
+}
+
+} /* namespace GridDiff */
@@ -0,0 +1,226 @@
+/*
+ * File: scattered_evaluator.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing ScatteredEvaluator class used for evaluating
+ * values and gradients of fields known at nodes of a tensor grid at
+ * arbitrary (scattered) points, e.g. particle positions. Tensor-product
+ * stencils are used, combining interpolation (derivative of order 0) and
+ * first derivative weights generated by Fornberg algorithm. For further
+ * information please see fornberg_nderivs.h header file.
+ */
+
+#ifndef GRIDDIFF_SCATTERED_EVALUATOR_H
+#define GRIDDIFF_SCATTERED_EVALUATOR_H
+
+#include "qobj.h"  /* QPoint, QGrid, QFieldIndex */
+
+#include <vector>  /* std::vector */
+
+namespace GridDiff
+{
+
+/*
+ * ScatteredEvaluator class
+ *
+ * For every point and every axis, width grid nodes closest to the point
+ * coordinate are chosen (as in Regridder class). Along every axis two sets
+ * of weights are generated: interpolation weights w0 and first derivative
+ * weights w1. Value and gradient (derivatives with respect to q1, q2 and
+ * q3) are then
+ *
+ *     f      = sum w0(a) w0(b) w0(c) f(a,b,c)
+ *     df/dq1 = sum w1(a) w0(b) w0(c) f(a,b,c)
+ *     df/dq2 = sum w0(a) w1(b) w0(c) f(a,b,c)
+ *     df/dq3 = sum w0(a) w0(b) w1(c) f(a,b,c)
+ *
+ * All four sums are evaluated together, one axis at a time, so every
+ * stencil value is loaded once (about 2*width^3 multiplications per point).
+ *
+ * Unlike Regridder, weights are not stored (points are expected to move
+ * every time step), but generated during evaluation:
+ *     * For uniform axes, stencil windows are located directly (without
+ *       binary search) and weights are evaluated from Lagrange basis on
+ *       normalized nodes 0, ..., width-1, whose denominators are computed
+ *       once in constructor and shared by all cells of the axis.
+ *     * For other axes, Fornberg algorithm is used on the window nodes.
+ *
+ * Points are processed in Morton (Z-curve) order of their stencil windows,
+ * so nearby points are evaluated together and their stencils share cache
+ * lines. Results are always written in the original order of points.
+ *
+ * Points have to be expressed in grid coordinates; gradient components are
+ * partial derivatives with respect to those coordinates (for curvilinear
+ * grids scale factors have to be applied by caller).
+ */
+class ScatteredEvaluator
+{
+    protected:
+        /* Grid point positions along every axis. */
+        QGrid                  mCoords[3];
+        /* Number of grid points used along each axis. */
+        unsigned               mWidth;
+        /* Whether axis is uniform. */
+        bool                   mUniform[3];
+        /* First node position and inverse spacing of uniform axes. */
+        double                 mOrigin[3],
+                               mInvStep[3];
+        /* Inverse Lagrange denominators of normalized nodes:
+         * 1 / prod_{b != a} (a - b) for a = 0, ..., width-1. */
+        std::vector<double>    mInvDenom;
+
+        /*
+         * window()
+         *
+         * Returns index of first of width nodes closest to coordinate x
+         * along given axis (0 for q1, 1 for q2, 2 for q3).
+         */
+        size_t window (const unsigned & axis, const double & x) const;
+
+        /*
+         * weights()
+         *
+         * Finds stencil window of coordinate x along given axis and
+         * evaluates its interpolation and first derivative weights.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const unsigned & axis
+         *     Axis (0 for q1, 1 for q2, 2 for q3).
+         *
+         * const double & x
+         *     Point coordinate along axis.
+         *
+         * double * w0
+         * double * w1
+         *     Arrays receiving width interpolation and first derivative
+         *     weights.
+         *
+         * double * work
+         *     Workspace of 4*width doubles.
+         *
+         * ---------
+         *  Returns
+         * ---------
+         * Index of first window node along axis.
+         */
+        size_t weights (const unsigned &  axis,
+                        const double   &     x,
+                        double         *    w0,
+                        double         *    w1,
+                        double         *  work) const;
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Constructor
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const QGrid & q1Coords
+         * const QGrid & q2Coords
+         * const QGrid & q3Coords
+         *     Grid point positions along axes q1, q2 and q3. For each axis
+         *     those positions have to be strictly increasing.
+         *
+         * const unsigned & width
+         *     Number of grid points used along each axis (polynomial
+         *     degree plus one).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * width < 2
+         *     * Any of qiCoords is of size < width
+         *     * Any of qiCoords is not strictly increasing
+         */
+        ScatteredEvaluator (const QGrid    & q1Coords,
+                            const QGrid    & q2Coords,
+                            const QGrid    & q3Coords,
+                            const unsigned &    width = 4);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /* Number of values in every field. */
+        size_t sourceSize () const
+        {
+            return mCoords[0].size() * mCoords[1].size() * mCoords[2].size();
+        }
+
+        /* Whether axis (0 for q1, 1 for q2, 2 for q3) is uniform. */
+        bool uniform (const unsigned & axis) const { return mUniform[axis]; }
+
+        /*
+         * mortonOrder()
+         *
+         * Returns permutation of points sorting them in Morton order of
+         * their stencil windows. Can be reused by gradient() as long as
+         * points do not move much.
+         */
+        std::vector<size_t> mortonOrder (const std::vector<QPoint> & points)
+                                        const;
+
+        /*
+         * gradient()
+         *
+         * Evaluates gradient (and optionally value) of a field at every
+         * point. Points are processed in parallel (if OpenMP is enabled).
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const std::vector<QPoint> & points
+         *     Evaluation points (in grid coordinates).
+         *
+         * const double * f
+         *     Field values (sourceSize() values).
+         *
+         * double * grads
+         *     Array receiving 3*points.size() values: df/dq1, df/dq2 and
+         *     df/dq3 of every point.
+         *
+         * double * values
+         *     Array receiving points.size() interpolated values. May be
+         *     NULL.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * None.
+         */
+        void gradient (const std::vector<QPoint> & points,
+                       const double              *      f,
+                       double                    *  grads,
+                       double                    * values = NULL) const;
+
+        /*
+         * gradient()
+         *
+         * As above, with points processed in given order (e.g. obtained
+         * from mortonOrder() in one of previous time steps).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if order is of different size than points.
+         */
+        void gradient (const std::vector<QPoint> & points,
+                       const std::vector<size_t> &  order,
+                       const double              *      f,
+                       double                    *  grads,
+                       double                    * values = NULL) const;
+
+}; /* class ScatteredEvaluator */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_SCATTERED_EVALUATOR_H */
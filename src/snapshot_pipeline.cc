@@ -0,0 +1,307 @@
+/*
+ * File: snapshot_pipeline.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing SnapshotPipeline class methods implementation
+ * (declared in snapshot_pipeline.h header file).
+ */
+
+#include "snapshot_pipeline.h"
+#include "util.h"      /* MonotonicSeconds */
+
+#include <stdexcept>   /* std::invalid_argument, std::runtime_error */
+#include <string>      /* std::string */
+#include <vector>      /* std::vector */
+
+#include <errno.h>     /* errno, EINTR */
+#include <pthread.h>   /* pthread_* */
+#include <unistd.h>    /* pread, pwrite */
+
+namespace GridDiff
+{
+
+namespace
+{
+
+/*
+ * Reads (or writes) exactly bytes bytes at given offset. Returns false on
+ * error or unexpected end of file.
+ */
+bool ReadFull (const int & fd, char * buf, size_t bytes, off_t offset)
+{
+    while (bytes > 0){
+        ssize_t r = pread(fd, buf, bytes, offset);
+
+        if (r < 0 && errno == EINTR){ continue; }
+        if (r <= 0)                 { return false; }
+
+        buf    += r;
+        bytes  -= (size_t) r;
+        offset += r;
+    }
+    return true;
+}
+
+bool WriteFull (const int & fd, const char * buf, size_t bytes, off_t offset)
+{
+    while (bytes > 0){
+        ssize_t r = pwrite(fd, buf, bytes, offset);
+
+        if (r < 0 && errno == EINTR){ continue; }
+        if (r <= 0)                 { return false; }
+
+        buf    += r;
+        bytes  -= (size_t) r;
+        offset += r;
+    }
+    return true;
+}
+
+/*
+ * PipelineState struct
+ *
+ * State shared between computing thread and I/O threads. Record i uses
+ * buffer i % buffers. It can be read once record i-buffers has been
+ * processed, processed once it has been read and record i-buffers has been
+ * written, and written once it has been processed.
+ */
+struct PipelineState
+{
+    pthread_mutex_t                   mutex;
+    pthread_cond_t                    cond;
+
+    int                               inFd, outFd;
+    RecordLayout                      inLayout, outLayout;
+    size_t                            records, buffers;
+
+    std::vector< std::vector<double> > in, out;
+
+    size_t                            readDone, computeDone, writeDone;
+    bool                              stop;
+    std::string                       error;
+
+    double                            readTime, writeTime;
+};
+
+/*
+ * Marks pipeline as stopped (with given error message, if any) and wakes
+ * up all waiting threads. Mutex has to be locked.
+ */
+void Stop (PipelineState & st, const char * error)
+{
+    if (error != NULL && st.error.empty()){
+        st.error = error;
+    }
+    st.stop = true;
+    pthread_cond_broadcast(&st.cond);
+}
+
+void * ReaderThread (void * arg)
+{
+    PipelineState & st    = *static_cast<PipelineState *>(arg);
+    const size_t    bytes = st.inLayout.count * sizeof(double);
+
+    for (size_t i = 0; i < st.records; ++i){
+        pthread_mutex_lock(&st.mutex);
+        while (!st.stop && i >= st.computeDone + st.buffers){
+            pthread_cond_wait(&st.cond, &st.mutex);
+        }
+        const bool stop = st.stop;
+        pthread_mutex_unlock(&st.mutex);
+
+        if (stop){ break; }
+
+        const double t0 = MonotonicSeconds();
+        const bool   ok = ReadFull(st.inFd,
+                                   (char *) &st.in[i % st.buffers][0], bytes,
+                                   st.inLayout.offset + i * st.inLayout.stride);
+        const double t1 = MonotonicSeconds();
+
+        pthread_mutex_lock(&st.mutex);
+        st.readTime += t1 - t0;
+        if (ok){
+            st.readDone = i + 1;
+            pthread_cond_broadcast(&st.cond);
+        }
+        else {
+            Stop(st, "reading record failed");
+        }
+        pthread_mutex_unlock(&st.mutex);
+
+        if (!ok){ break; }
+    }
+
+    return NULL;
+}
+
+void * WriterThread (void * arg)
+{
+    PipelineState & st    = *static_cast<PipelineState *>(arg);
+    const size_t    bytes = st.outLayout.count * sizeof(double);
+
+    for (size_t i = 0; i < st.records; ++i){
+        pthread_mutex_lock(&st.mutex);
+        while (!st.stop && st.computeDone <= i){
+            pthread_cond_wait(&st.cond, &st.mutex);
+        }
+        const bool ready = st.computeDone > i;
+        pthread_mutex_unlock(&st.mutex);
+
+        if (!ready){ break; }
+
+        const double t0 = MonotonicSeconds();
+        const bool   ok = WriteFull(st.outFd,
+                                    (const char *) &st.out[i % st.buffers][0],
+                                    bytes,
+                                    st.outLayout.offset + i * st.outLayout.stride);
+        const double t1 = MonotonicSeconds();
+
+        pthread_mutex_lock(&st.mutex);
+        st.writeTime += t1 - t0;
+        if (ok){
+            st.writeDone = i + 1;
+            pthread_cond_broadcast(&st.cond);
+        }
+        else {
+            Stop(st, "writing record failed");
+        }
+        pthread_mutex_unlock(&st.mutex);
+
+        if (!ok){ break; }
+    }
+
+    return NULL;
+}
+
+} /* anonymous namespace */
+
+
+SnapshotPipeline::SnapshotPipeline (const int          &      inFd,
+                                    const RecordLayout &  inLayout,
+                                    const int          &     outFd,
+                                    const RecordLayout & outLayout,
+                                    const unsigned     &   buffers)
+
+                                  : mInFd      (inFd),
+                                    mOutFd     (outFd),
+                                    mInLayout  (inLayout),
+                                    mOutLayout (outLayout),
+                                    mBuffers   (buffers)
+{
+    /* If one of arguments is invalid, throw exception. */
+    if (buffers == 0){
+        throw std::invalid_argument("zero pipeline buffers");
+    }
+
+    if (inLayout.count == 0 || outLayout.count == 0){
+        throw std::invalid_argument("zero record size");
+    }
+}
+
+
+PipelineStats SnapshotPipeline::run (SnapshotKernel &  kernel,
+                                     const size_t   & records)
+{
+    PipelineStats stats;
+    PipelineState st;
+
+    st.inFd        = mInFd;
+    st.outFd       = mOutFd;
+    st.inLayout    = mInLayout;
+    st.outLayout   = mOutLayout;
+    st.records     = records;
+    st.buffers     = mBuffers;
+    st.in .assign(mBuffers, std::vector<double>(mInLayout.count));
+    st.out.assign(mBuffers, std::vector<double>(mOutLayout.count));
+    st.readDone    = 0;
+    st.computeDone = 0;
+    st.writeDone   = 0;
+    st.stop        = false;
+    st.readTime    = 0.0;
+    st.writeTime   = 0.0;
+
+    pthread_mutex_init(&st.mutex, NULL);
+    pthread_cond_init(&st.cond, NULL);
+
+    const double start = MonotonicSeconds();
+    pthread_t    reader, writer;
+
+    if (pthread_create(&reader, NULL, ReaderThread, &st) != 0){
+        pthread_cond_destroy(&st.cond);
+        pthread_mutex_destroy(&st.mutex);
+        throw std::runtime_error("cannot start reader thread");
+    }
+    if (pthread_create(&writer, NULL, WriterThread, &st) != 0){
+        pthread_mutex_lock(&st.mutex);
+        Stop(st, NULL);
+        pthread_mutex_unlock(&st.mutex);
+        pthread_join(reader, NULL);
+        pthread_cond_destroy(&st.cond);
+        pthread_mutex_destroy(&st.mutex);
+        throw std::runtime_error("cannot start writer thread");
+    }
+
+    for (size_t i = 0; i < records; ++i){
+        /* Waiting for input record and free output buffer. */
+        pthread_mutex_lock(&st.mutex);
+
+        double t0 = MonotonicSeconds();
+        while (!st.stop && st.readDone <= i){
+            pthread_cond_wait(&st.cond, &st.mutex);
+        }
+        double t1 = MonotonicSeconds();
+        while (!st.stop && i >= st.writeDone + st.buffers){
+            pthread_cond_wait(&st.cond, &st.mutex);
+        }
+        double t2 = MonotonicSeconds();
+
+        const bool stop = st.stop;
+        pthread_mutex_unlock(&st.mutex);
+
+        stats.inputWait  += t1 - t0;
+        stats.outputWait += t2 - t1;
+
+        if (stop){ break; }
+
+        /* Processing record; on exception stop I/O threads first. */
+        try {
+            kernel.process(i, &st.in [i % mBuffers][0],
+                              &st.out[i % mBuffers][0]);
+        }
+        catch (...){
+            pthread_mutex_lock(&st.mutex);
+            Stop(st, NULL);
+            pthread_mutex_unlock(&st.mutex);
+            pthread_join(reader, NULL);
+            pthread_join(writer, NULL);
+            pthread_cond_destroy(&st.cond);
+            pthread_mutex_destroy(&st.mutex);
+            throw;
+        }
+
+        stats.compute += MonotonicSeconds() - t2;
+
+        pthread_mutex_lock(&st.mutex);
+        st.computeDone = i + 1;
+        pthread_cond_broadcast(&st.cond);
+        pthread_mutex_unlock(&st.mutex);
+    }
+
+    pthread_join(reader, NULL);
+    pthread_join(writer, NULL);
+    pthread_cond_destroy(&st.cond);
+    pthread_mutex_destroy(&st.mutex);
+
+    stats.wall  = MonotonicSeconds() - start;
+    stats.read  = st.readTime;
+    stats.write = st.writeTime;
+
+    if (!st.error.empty()){
+        throw std::runtime_error(st.error);
+    }
+
+    return stats;
+}
+
+} /* namespace GridDiff */
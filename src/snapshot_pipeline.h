@@ -0,0 +1,205 @@
+/*
+ * File: snapshot_pipeline.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing SnapshotPipeline class used for processing
+ * a sequence of field records (whole snapshots or slabs) stored in a file,
+ * with reading of next records and writing of previous results overlapped
+ * with computation (e.g. evaluation of operators with FieldEngine class).
+ */
+
+#ifndef GRIDDIFF_SNAPSHOT_PIPELINE_H
+#define GRIDDIFF_SNAPSHOT_PIPELINE_H
+
+#include <cstddef>        /* size_t */
+#include <sys/types.h>    /* off_t */
+
+namespace GridDiff
+{
+
+/*
+ * RecordLayout struct
+ *
+ * Position of records in a file. Record i consists of count doubles
+ * starting at byte offset + i*stride. Stride can be smaller than record
+ * size (e.g. for slabs with overlapping halo planes).
+ */
+struct RecordLayout
+{
+    off_t  offset;
+    off_t  stride;
+    size_t count;
+
+    RecordLayout (const off_t & Offset = 0, const off_t & Stride = 0,
+                  const size_t & Count = 0)
+        : offset(Offset), stride(Stride), count(Count) { }
+};
+
+/*
+ * PipelineStats struct
+ *
+ * Timings (in seconds) collected by SnapshotPipeline::run().
+ */
+struct PipelineStats
+{
+    /* Total time of run() call. */
+    double wall;
+    /* Time spent in SnapshotKernel::process(). */
+    double compute;
+    /* Time spent by background threads in reading and writing. */
+    double read, write;
+    /* Time computation waited for input records and free output buffers. */
+    double inputWait, outputWait;
+
+    PipelineStats ()
+        : wall(0.0), compute(0.0), read(0.0), write(0.0),
+          inputWait(0.0), outputWait(0.0) { }
+
+    /*
+     * overlap()
+     *
+     * Fraction of I/O time hidden behind computation (1 if all reading and
+     * writing was done while computing, 0 if none).
+     */
+    double overlap () const
+    {
+        const double io     = read + write;
+        const double hidden = io - (wall - compute);
+
+        if (io <= 0.0)    { return 1.0; }
+        if (hidden < 0.0) { return 0.0; }
+        return hidden > io ? 1.0 : hidden / io;
+    }
+};
+
+/*
+ * SnapshotKernel class
+ *
+ * Computation performed for every record by SnapshotPipeline.
+ */
+class SnapshotKernel
+{
+    public:
+        virtual ~SnapshotKernel () { }
+
+        /*
+         * process()
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const size_t & index
+         *     Record index.
+         *
+         * const double * in
+         *     Input record values.
+         *
+         * double * out
+         *     Array receiving output record values.
+         */
+        virtual void process (const size_t & index,
+                              const double *    in,
+                              double       *   out) = 0;
+
+}; /* class SnapshotKernel */
+
+/*
+ * SnapshotPipeline class
+ *
+ * Reads records from input file and writes results to output file using
+ * two background threads (with pread and pwrite calls), while records are
+ * processed by the calling thread. A given number of input and output
+ * buffers is kept, so up to that many records are read ahead of the
+ * computation and written behind it.
+ */
+class SnapshotPipeline
+{
+    protected:
+        /* File descriptors. */
+        int            mInFd,
+                       mOutFd;
+        /* Record positions. */
+        RecordLayout   mInLayout,
+                       mOutLayout;
+        /* Number of buffers in flight for input and output. */
+        unsigned       mBuffers;
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Constructor
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const int & inFd
+         *     Input file descriptor (opened for reading).
+         *
+         * const RecordLayout & inLayout
+         *     Position of input records.
+         *
+         * const int & outFd
+         *     Output file descriptor (opened for writing).
+         *
+         * const RecordLayout & outLayout
+         *     Position of output records.
+         *
+         * const unsigned & buffers
+         *     Number of input and output buffers (2 for double buffering).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if buffers is zero or any record size is
+         * zero.
+         */
+        SnapshotPipeline (const int          &      inFd,
+                          const RecordLayout &  inLayout,
+                          const int          &     outFd,
+                          const RecordLayout & outLayout,
+                          const unsigned     &   buffers = 2);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /*
+         * run()
+         *
+         * Processes records 0,...,records-1.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * SnapshotKernel & kernel
+         *     Computation performed for every record.
+         *
+         * const size_t & records
+         *     Number of records.
+         *
+         * ---------
+         *  Returns
+         * ---------
+         * Collected timings.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::runtime_error if reading or writing fails (pipeline is
+         * stopped first).
+         * std::bad_alloc if buffers cannot be allocated.
+         * Exceptions thrown by kernel are passed on (pipeline is stopped
+         * first).
+         */
+        PipelineStats run (SnapshotKernel &  kernel,
+                           const size_t   & records);
+
+}; /* class SnapshotPipeline */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_SNAPSHOT_PIPELINE_H */
@@ -0,0 +1,392 @@
+/*
+ * File: spectral_engine.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing SpectralAxis and SpectralEngine classes methods
+ * implementation (declared in spectral_engine.h header file).
+ */
+
+#include "spectral_engine.h"
+
+#include <algorithm>  /* std::copy, std::min, std::swap */
+#include <cmath>      /* sin, cos, fabs */
+#include <stdexcept>  /* std::invalid_argument */
+
+namespace GridDiff
+{
+
+namespace
+{
+
+const double PI = 3.14159265358979323846;
+
+/* Number of complex lines of a block evaluated together (two real lines
+ * each). */
+const size_t LINE_BLOCK = 32;
+
+} /* anonymous namespace */
+
+
+SpectralAxis::SpectralAxis () : mSize(0) { }
+
+
+SpectralAxis::SpectralAxis (const QGrid  & coords,
+                            const double & period)
+{
+    const size_t n = coords.size();
+
+    /* If one of arguments is invalid, throw exception. */
+    if (n < 2){
+        throw std::invalid_argument("periodic grid size < 2");
+    }
+    if (!(period > 0.0)){
+        throw std::invalid_argument("period not positive");
+    }
+
+    const double h = period / n;
+
+    for (size_t i = 1; i < n; ++i){
+        if (fabs(coords[i] - coords[0] - i * h) > 1e-10 * period){
+            throw std::invalid_argument("periodic grid not uniform");
+        }
+    }
+
+    /* Setting members. */
+    mSize = n;
+
+    /* Radices: fours first, then other prime factors. */
+    size_t m = n;
+
+    while (m % 4 == 0){ mRadices.push_back(4); m /= 4; }
+
+    for (size_t p = 2; m > 1; ++p){
+        while (m % p == 0){ mRadices.push_back(p); m /= p; }
+    }
+
+    /* Butterfly coefficients. */
+    size_t L = 1;
+
+    for (size_t s = 0; s < mRadices.size(); ++s){
+        const size_t p = mRadices[s];
+
+        for (size_t f1 = 0; f1 < L; ++f1){
+            for (size_t f = 0; f < p; ++f){
+                for (size_t t = 0; t < p; ++t){
+                    const double a = -2.0 * PI * ((t * (f1 + L * f)) % (L * p))
+                                   / (L * p);
+
+                    mCoeffRe.push_back(cos(a));
+                    mCoeffIm.push_back(sin(a));
+                }
+            }
+        }
+        L *= p;
+    }
+
+    /* Wavenumbers; the Nyquist coefficient (even n) gets the positive
+     * one. */
+    mKappa.resize(n);
+
+    for (size_t f = 0; f < n; ++f){
+        const double q = (2 * f <= n) ? (double) f : (double) f - (double) n;
+        mKappa[f] = 2.0 * PI * q / period;
+    }
+}
+
+
+void SpectralAxis::transform (double       *    re,
+                              double       *    im,
+                              const size_t & count,
+                              double       *  work) const
+{
+    const size_t n = mSize;
+
+    double * srcRe = re,
+           * srcIm = im,
+           * dstRe = work,
+           * dstIm = work + n * count;
+
+    /* Stage combining p transforms of length L (of lines of stride S) into
+     * transforms of length L*p (of stride S/p). For fixed f1 and t, the
+     * S/p strided lines of all count interleaved lines are contiguous,
+     * so butterflies operate on vectors of V values. */
+    size_t L = 1, S = n, c0 = 0;
+
+    for (size_t s = 0; s < mRadices.size(); ++s){
+        const size_t p  = mRadices[s];
+        const size_t Sp = S / p;
+        const size_t V  = Sp * count;
+
+        for (size_t f1 = 0; f1 < L; ++f1){
+            for (size_t f = 0; f < p; ++f){
+                const double * wr = &mCoeffRe[c0 + (f1 * p + f) * p];
+                const double * wi = &mCoeffIm[c0 + (f1 * p + f) * p];
+                double       * dr = dstRe + (f1 + L * f) * V;
+                double       * di = dstIm + (f1 + L * f) * V;
+
+                /* t == 0 (coefficient 1). */
+                const double * ar = srcRe + f1 * S * count;
+                const double * ai = srcIm + f1 * S * count;
+
+                std::copy(ar, ar + V, dr);
+                std::copy(ai, ai + V, di);
+
+                for (size_t t = 1; t < p; ++t){
+                    const double   cr = wr[t],
+                                   ci = wi[t];
+                    const double * br = ar + t * V;
+                    const double * bi = ai + t * V;
+
+                    for (size_t v = 0; v < V; ++v){
+                        dr[v] += cr * br[v] - ci * bi[v];
+                        di[v] += cr * bi[v] + ci * br[v];
+                    }
+                }
+            }
+        }
+
+        std::swap(srcRe, dstRe);
+        std::swap(srcIm, dstIm);
+
+        c0 += L * p * p;
+        L  *= p;
+        S   = Sp;
+    }
+
+    if (srcRe != re){
+        std::copy(srcRe, srcRe + n * count, re);
+        std::copy(srcIm, srcIm + n * count, im);
+    }
+}
+
+
+void SpectralAxis::derivative (const unsigned &  order,
+                               double         *     re,
+                               double         *     im,
+                               const size_t   &  count,
+                               double         *   work) const
+{
+    const size_t n = mSize;
+
+    transform(re, im, count, work);
+
+    /* Multiplication by (i kappa)^k / n, followed by conjugation (the
+     * inverse transform is the conjugated forward transform of conjugated
+     * coefficients). */
+    for (size_t f = 0; f < n; ++f){
+        double mr = 1.0 / n, mi = 0.0;
+
+        for (unsigned k = 0; k < order; ++k){
+            const double t = -mi * mKappa[f];
+            mi = mr * mKappa[f];
+            mr = t;
+        }
+
+        if (order % 2 == 1 && 2 * f == n){
+            mr = mi = 0.0;
+        }
+
+        double * r = re + f * count;
+        double * i = im + f * count;
+
+        for (size_t j = 0; j < count; ++j){
+            const double xr = r[j], xi = i[j];
+
+            r[j] =   xr * mr - xi * mi;
+            i[j] = -(xr * mi + xi * mr);
+        }
+    }
+
+    transform(re, im, count, work);
+
+    for (size_t j = 0; j < n * count; ++j){
+        im[j] = -im[j];
+    }
+}
+
+
+SpectralEngine::SpectralEngine (const QGrid    & q1Coords,
+                                const QGrid    & q2Coords,
+                                const QGrid    & q3Coords,
+                                const double   *  periods,
+                                const unsigned &    width,
+                                const unsigned & maxOrder)
+
+                              : mEngine (q1Coords, q2Coords, q3Coords,
+                                         width, maxOrder)
+{
+    const QGrid * q[3] = { &q1Coords, &q2Coords, &q3Coords };
+
+    for (unsigned axis = 0; axis < 3; ++axis){
+        mPeriodic[axis] = periods[axis] != 0.0;
+
+        if (mPeriodic[axis]){
+            mAxes[axis] = SpectralAxis(*q[axis], periods[axis]);
+        }
+    }
+}
+
+
+void SpectralEngine::derivative (const unsigned &  axis,
+                                 const unsigned & order,
+                                 const double   *     f,
+                                 double         *   out) const
+{
+    /* If arguments invalid, throw exception. */
+    if (axis > AXIS_Q3){
+        throw std::invalid_argument("invalid axis");
+    }
+
+    if (!mPeriodic[axis]){
+        unsigned orders[3] = { 0, 0, 0 };
+        orders[axis] = order;
+
+        mEngine.derivative(orders, f, out);
+        return;
+    }
+
+    if (order > mEngine.plan(AXIS_Q1).maxOrder()){
+        throw std::invalid_argument("derivative order higher than max");
+    }
+    if (f == out){
+        throw std::invalid_argument("input and output fields are the same");
+    }
+
+    /* Lines: node t of line c is found at offset(c) + t*step. */
+    const size_t N1    = mEngine.n1();
+    const size_t plane = N1 * mEngine.n2();
+    const size_t n     = mAxes[axis].size();
+    const size_t step  = (axis == AXIS_Q1) ? 1  : (axis == AXIS_Q2) ? N1
+                                                                    : plane;
+    const size_t lines = size() / n;
+    const long   nb    = (long) ((lines + 2 * LINE_BLOCK - 1)
+                                 / (2 * LINE_BLOCK));
+
+    #pragma omp parallel
+    {
+        std::vector<double> buf(4 * n * LINE_BLOCK);
+        std::vector<size_t> offsets(2 * LINE_BLOCK);
+        double            * re   = &buf[0];
+        double            * im   = re + n * LINE_BLOCK;
+        double            * work = im + n * LINE_BLOCK;
+
+        #pragma omp for schedule(static)
+        for (long b = 0; b < nb; ++b){
+            const size_t c0  = (size_t) b * 2 * LINE_BLOCK;
+            const size_t cnt = std::min(2 * LINE_BLOCK, lines - c0);
+            const size_t C   = (cnt + 1) / 2;
+
+            for (size_t c = 0; c < cnt; ++c){
+                const size_t l = c0 + c;
+
+                offsets[c] = (axis == AXIS_Q1) ? l * N1
+                           : (axis == AXIS_Q2) ? (l / N1) * plane + l % N1
+                           :                     l;
+            }
+
+            /* Gathering: first C lines as real parts, the rest as
+             * imaginary parts. */
+            for (size_t t = 0; t < n; ++t){
+                for (size_t c = 0; c < C; ++c){
+                    re[t * C + c] = f[offsets[c] + t * step];
+                }
+                for (size_t c = C; c < cnt; ++c){
+                    im[t * C + c - C] = f[offsets[c] + t * step];
+                }
+                if (cnt < 2 * C){
+                    im[t * C + C - 1] = 0.0;
+                }
+            }
+
+            mAxes[axis].derivative(order, re, im, C, work);
+
+            for (size_t t = 0; t < n; ++t){
+                for (size_t c = 0; c < C; ++c){
+                    out[offsets[c] + t * step] = re[t * C + c];
+                }
+                for (size_t c = C; c < cnt; ++c){
+                    out[offsets[c] + t * step] = im[t * C + c - C];
+                }
+            }
+        }
+    }
+}
+
+
+void SpectralEngine::apply (const FieldOperator & op,
+                            const double        *  f,
+                            double              * out) const
+{
+    /* If arguments invalid, throw exception. */
+    if (op.maxOrder() > mEngine.plan(AXIS_Q1).maxOrder()){
+        throw std::invalid_argument("operator order higher than max");
+    }
+
+    if (!op.fits(mEngine.n1(), mEngine.n2(), mEngine.n3())){
+        throw std::invalid_argument("operator does not fit grid");
+    }
+
+    const unsigned m     = op.maxOrder();
+    const unsigned ncomp = op.components();
+    const size_t   N1    = mEngine.n1(),
+                   N2    = mEngine.n2(),
+                   N3    = mEngine.n3();
+
+    /* Whole-field derivatives used by the operator. */
+    std::vector< std::vector<double> > derivs(3 * (m + 1));
+
+    for (unsigned axis = 0; axis < 3; ++axis){
+        for (unsigned k = 1; k <= m; ++k){
+            if (op.uses(axis, k)){
+                derivs[axis*(m+1) + k].resize(size());
+                derivative(axis, k, f, &derivs[axis*(m+1) + k][0]);
+            }
+        }
+    }
+
+    const QGrid & q1   = mEngine.coords(AXIS_Q1);
+    const QGrid & q2   = mEngine.coords(AXIS_Q2);
+    const QGrid & q3   = mEngine.coords(AXIS_Q3);
+    const long    rows = (long) (N2 * N3);
+
+    #pragma omp parallel
+    {
+        std::vector<const double *> d(3 * (m + 1), (const double *) NULL);
+        std::vector<double *>       o(ncomp, (double *) NULL);
+        RowContext                  row;
+
+        #pragma omp for schedule(static)
+        for (long r = 0; r < rows; ++r){
+            const size_t i2   = (size_t) r % N2;
+            const size_t i3   = (size_t) r / N2;
+            const size_t node = QFieldIndex(0, i2, i3, N1, N2);
+
+            for (unsigned axis = 0; axis < 3; ++axis){
+                d[axis*(m+1)] = f + node;
+
+                for (unsigned k = 1; k <= m; ++k){
+                    const std::vector<double> & v = derivs[axis*(m+1) + k];
+                    d[axis*(m+1) + k] = v.empty() ? NULL : &v[node];
+                }
+            }
+
+            row.i1     = 0;
+            row.i2     = i2;
+            row.i3     = i3;
+            row.length = N1;
+            row.node   = node;
+            row.q1     = &q1[0];
+            row.q2     = q2[i2];
+            row.q3     = q3[i3];
+
+            for (unsigned c = 0; c < ncomp; ++c){
+                o[c] = out + node * ncomp + c;
+            }
+
+            op.combineRow(row, &d[0], &o[0], (ptrdiff_t) ncomp);
+        }
+    }
+}
+
+} /* namespace GridDiff */
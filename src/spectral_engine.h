@@ -0,0 +1,276 @@
+/*
+ * File: spectral_engine.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing SpectralAxis and SpectralEngine classes used for
+ * evaluating differential operators (described by FieldOperator child
+ * classes) with spectral (Fourier) derivatives along periodic axes (e.g.
+ * phi axis of cylindrical and spherical grids) and Fornberg stencils along
+ * the other ones.
+ */
+
+#ifndef GRIDDIFF_SPECTRAL_ENGINE_H
+#define GRIDDIFF_SPECTRAL_ENGINE_H
+
+#include "qobj.h"            /* QGrid, QFieldIndex */
+#include "field_engine.h"    /* FieldEngine */
+#include "field_operator.h"  /* FieldOperator */
+
+#include <vector>            /* std::vector */
+
+namespace GridDiff
+{
+
+/*
+ * SpectralAxis class
+ *
+ * Spectral differentiation along a periodic, uniformly spaced axis of n
+ * nodes: a line is transformed with a discrete Fourier transform, every
+ * coefficient of wavenumber kappa is multiplied by (i kappa)^k and the
+ * result is transformed back. For smooth periodic functions derivatives
+ * converge exponentially with n. For even n and odd k the Nyquist
+ * coefficient is set to zero (so derivatives of real lines stay real).
+ *
+ * Transforms use a built-in mixed-radix FFT (Stockham autosort, so no bit
+ * reversal is needed) of any length; it is fastest for lengths whose prime
+ * factors are small (2, 3 and 5). Many lines are transformed at once:
+ * values of count lines are interleaved (value of line j at node i stored
+ * at i*count + j), so every butterfly operates on contiguous vectors of
+ * count (or more) values. Since differentiation is a real operator, two
+ * real lines are packed as real and imaginary parts of one complex line.
+ */
+class SpectralAxis
+{
+    protected:
+        /* Number of grid nodes. */
+        size_t                mSize;
+        /* Radices of FFT stages. */
+        std::vector<size_t>   mRadices;
+        /* Butterfly coefficients of every stage: for stage of radix p
+         * following stages of total length L, coefficients
+         * exp(-2 pi i t (f1 + L f) / (L p)) for every f1 < L, f < p and
+         * t < p (real and imaginary parts). */
+        std::vector<double>   mCoeffRe,
+                              mCoeffIm;
+        /* Wavenumber of every Fourier coefficient. */
+        std::vector<double>   mKappa;
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Default constructor
+         *
+         * Creates an empty axis (of zero size).
+         */
+        SpectralAxis ();
+
+        /*
+         * Constructor
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const QGrid & coords
+         *     Grid point positions along axis. Have to be uniformly spaced
+         *     and cover exactly one period (the node following the last
+         *     one would be the first node shifted by period).
+         *
+         * const double & period
+         *     Period of the axis (e.g. 2 pi for phi axis).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if:
+         *     * coords is of size < 2
+         *     * period is not positive
+         *     * coords is not uniformly spaced with spacing period/n
+         */
+        SpectralAxis (const QGrid  & coords,
+                      const double & period);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /* Number of grid nodes. */
+        size_t size () const { return mSize; }
+
+        /*
+         * transform()
+         *
+         * Forward discrete Fourier transform (with exp(-2 pi i f t / n)
+         * kernel) of count interleaved complex lines, in place.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * double * re
+         * double * im
+         *     Real and imaginary parts of size()*count values.
+         *
+         * const size_t & count
+         *     Number of lines.
+         *
+         * double * work
+         *     Workspace of 2*size()*count doubles.
+         */
+        void transform (double       *    re,
+                        double       *    im,
+                        const size_t & count,
+                        double       *  work) const;
+
+        /*
+         * derivative()
+         *
+         * Replaces count interleaved complex lines with their kth
+         * derivatives (real and imaginary parts are differentiated
+         * independently). Workspace as for transform().
+         */
+        void derivative (const unsigned &  order,
+                         double         *     re,
+                         double         *     im,
+                         const size_t   &  count,
+                         double         *   work) const;
+
+}; /* class SpectralAxis */
+
+
+/*
+ * SpectralEngine class
+ *
+ * Evaluates operators at every node of a tensor grid, like FieldEngine
+ * class, but with derivatives along periodic axes evaluated spectrally (see
+ * SpectralAxis class). Derivatives along other axes are evaluated with
+ * Fornberg stencils of an internal FieldEngine. Derivatives used by an
+ * operator are evaluated for the whole field first (one field per
+ * derivative) and combined by FieldOperator::combineRow() afterwards, so
+ * every existing operator (e.g. CylindricalLaplacianFieldOp) can be used.
+ *
+ * Spectral derivatives are evaluated for blocks of lines in parallel;
+ * lines of a block are gathered into interleaved buffers (contiguous
+ * copies along q2 and q3 axes).
+ */
+class SpectralEngine
+{
+    protected:
+        /* Engine used along non-periodic axes. */
+        FieldEngine       mEngine;
+        /* Whether axis is periodic. */
+        bool              mPeriodic[3];
+        /* Spectral differentiation of periodic axes. */
+        SpectralAxis      mAxes[3];
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Constructor
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const QGrid & q1Coords
+         * const QGrid & q2Coords
+         * const QGrid & q3Coords
+         *     Grid point positions along axes q1, q2 and q3. For each axis
+         *     those positions have to be strictly increasing.
+         *
+         * const double * periods
+         *     Periods of q1, q2 and q3 axes (zero for non-periodic ones).
+         *
+         * const unsigned & width
+         *     Number of grid points used for every stencil along
+         *     non-periodic axes.
+         *
+         * const unsigned & maxOrder
+         *     Highest derivative order of evaluated operators.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if arguments are invalid (see FieldEngine
+         * and SpectralAxis constructors).
+         */
+        SpectralEngine (const QGrid    & q1Coords,
+                        const QGrid    & q2Coords,
+                        const QGrid    & q3Coords,
+                        const double   *  periods,
+                        const unsigned &    width,
+                        const unsigned & maxOrder);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /* Engine used along non-periodic axes. */
+        const FieldEngine & engine () const { return mEngine; }
+
+        /* Total number of grid points. */
+        size_t size () const { return mEngine.size(); }
+
+        /* Whether axis (AXIS_Q1, AXIS_Q2 or AXIS_Q3) is periodic. */
+        bool periodic (const unsigned & axis) const
+        {
+            return mPeriodic[axis];
+        }
+
+        /*
+         * derivative()
+         *
+         * Evaluates kth partial derivative along given axis at every grid
+         * node.
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const unsigned & axis
+         *     Axis (AXIS_Q1, AXIS_Q2 or AXIS_Q3).
+         *
+         * const unsigned & order
+         *     Derivative order (up to the one given in constructor).
+         *
+         * const double * f
+         *     Function values at grid nodes (size() values).
+         *
+         * double * out
+         *     Array receiving size() values. Cannot be the same as f.
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if axis or order is invalid, or f and out
+         * are the same.
+         */
+        void derivative (const unsigned &  axis,
+                         const unsigned & order,
+                         const double   *     f,
+                         double         *   out) const;
+
+        /*
+         * apply()
+         *
+         * Evaluates operator at every grid node (see FieldEngine::apply()).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if operator order is higher than the one
+         * given in constructor, or operator does not fit the grid (see
+         * FieldOperator::fits()).
+         */
+        void apply (const FieldOperator & op,
+                    const double        *  f,
+                    double              * out) const;
+
+}; /* class SpectralEngine */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_SPECTRAL_ENGINE_H */
@@ -0,0 +1,167 @@
+/*
+ * File: stencil_table.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A source file providing StencilTable class methods implementation
+ * (declared in stencil_table.h header file).
+ */
+
+#include "stencil_table.h"
+#include "util.h"     /* HashBytes */
+
+#include <algorithm>  /* std::copy, std::equal, std::max */
+#include <cmath>      /* fabs */
+#include <stdexcept>  /* std::invalid_argument */
+
+namespace GridDiff
+{
+
+StencilTable::StencilTable (const unsigned         &    length,
+                            const StencilPrecision & precision,
+                            const double           & tolerance)
+
+                          : mLength    (length),
+                            mPrecision (precision),
+                            mTolerance (tolerance)
+{
+    /* If one of arguments is invalid, throw exception. */
+    if (length == 0){
+        throw std::invalid_argument("row length == 0");
+    }
+    if (tolerance < 0.0){
+        throw std::invalid_argument("negative tolerance");
+    }
+}
+
+
+size_t StencilTable::append (const double * row)
+{
+    const unsigned n = mLength;
+
+    /* Single precision, if rounding errors are small enough. */
+    std::vector<float> f;
+
+    if (mPrecision == STENCIL_FLOAT){
+        double largest = 0.0, error = 0.0;
+
+        f.resize(n);
+
+        for (unsigned j = 0; j < n; ++j){
+            f[j] = (float) row[j];
+
+            largest = std::max(largest, fabs(row[j]));
+            error   = std::max(error,   fabs(row[j] - (double) f[j]));
+        }
+
+        if (error > mTolerance * largest){
+            f.clear();
+        }
+    }
+
+    const bool   single = !f.empty();
+    const size_t h      = single ? HashBytes(&f[0], n * sizeof(float))
+                                 : HashBytes(row,   n * sizeof(double));
+
+    /* Stored row with the same values. */
+    typedef std::multimap<size_t, size_t>::const_iterator Iter;
+
+    std::pair<Iter, Iter> range = mLookup.equal_range(h);
+
+    for (Iter it = range.first; it != range.second; ++it){
+        const size_t e = it->second;
+
+        if ((e & 1) != (size_t) single){
+            continue;
+        }
+
+        const bool same = single
+            ? std::equal(f.begin(), f.end(), &mFloats[e >> 1])
+            : std::equal(row, row + n, &mDoubles[e >> 1]);
+
+        if (same){
+            mEntries.push_back(e);
+            return mEntries.size() - 1;
+        }
+    }
+
+    /* New row. */
+    size_t e;
+
+    if (single){
+        e = 2 * mFloats.size() + 1;
+        mFloats.insert(mFloats.end(), f.begin(), f.end());
+    }
+    else {
+        e = 2 * mDoubles.size();
+        mDoubles.insert(mDoubles.end(), row, row + n);
+    }
+
+    mLookup.insert(std::make_pair(h, e));
+    mEntries.push_back(e);
+
+    return mEntries.size() - 1;
+}
+
+
+void StencilTable::shrink ()
+{
+    std::multimap<size_t, size_t>().swap(mLookup);
+
+    std::vector<double>(mDoubles).swap(mDoubles);
+    std::vector<float> (mFloats) .swap(mFloats);
+    std::vector<size_t>(mEntries).swap(mEntries);
+}
+
+
+void StencilTable::assign (const std::vector<double> & doubles,
+                           const std::vector<float>  &  floats,
+                           const std::vector<size_t> & entries)
+{
+    /* If one of arguments is invalid, throw exception. */
+    if (doubles.size() % mLength != 0 || floats.size() % mLength != 0){
+        throw std::invalid_argument("values not a multiple of row length");
+    }
+
+    for (size_t i = 0; i < entries.size(); ++i){
+        const size_t o = entries[i] >> 1;
+        const size_t n = (entries[i] & 1) ? floats.size() : doubles.size();
+
+        if (o % mLength != 0 || o >= n){
+            throw std::invalid_argument("entry does not point to a row");
+        }
+    }
+
+    mDoubles = doubles;
+    mFloats  = floats;
+    mEntries = entries;
+
+    std::multimap<size_t, size_t>().swap(mLookup);
+}
+
+
+void StencilTable::load (const size_t &   i,
+                         double       * out) const
+{
+    if (isFloat(i)){
+        const float * r = floatRow(i);
+
+        for (unsigned j = 0; j < mLength; ++j){
+            out[j] = r[j];
+        }
+    }
+    else {
+        const double * r = doubleRow(i);
+        std::copy(r, r + mLength, out);
+    }
+}
+
+
+size_t StencilTable::memoryFootprint () const
+{
+    return mDoubles.size() * sizeof(double) +
+           mFloats .size() * sizeof(float)  +
+           mEntries.size() * sizeof(size_t);
+}
+
+} /* namespace GridDiff */
@@ -0,0 +1,176 @@
+/*
+ * File: stencil_table.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * A header file providing StencilTable class used for storing stencil
+ * coefficient rows of many grid nodes (e.g. of a grid axis or of a set of
+ * grid lines) without keeping duplicate rows.
+ */
+
+#ifndef GRIDDIFF_STENCIL_TABLE_H
+#define GRIDDIFF_STENCIL_TABLE_H
+
+#include <vector>   /* std::vector */
+#include <map>      /* std::multimap */
+#include <cstddef>  /* size_t */
+
+namespace GridDiff
+{
+
+/*
+ * Precisions of rows stored in StencilTable.
+ */
+enum StencilPrecision
+{
+    STENCIL_DOUBLE,  /* all rows stored in double precision */
+    STENCIL_FLOAT    /* rows stored in single precision, unless rounding
+                        error exceeds tolerance (double then) */
+};
+
+/*
+ * StencilTable class
+ *
+ * Table of coefficient rows of equal length, one row per entry (e.g. per
+ * grid node). Identical rows (such as rows of nodes of uniformly spaced
+ * parts of a non-uniform grid) are stored once; every entry only keeps
+ * the position of its row, so lookups take constant time.
+ *
+ * With STENCIL_FLOAT precision, a row is stored in single precision if
+ * rounding changes none of its values by more than tolerance times the
+ * largest magnitude in the row; otherwise it is stored in double
+ * precision. Rows are compared (for deduplication) as stored.
+ */
+class StencilTable
+{
+    protected:
+        /* Number of values per row. */
+        unsigned                      mLength;
+        /* Storage precision and rounding tolerance. */
+        StencilPrecision              mPrecision;
+        double                        mTolerance;
+        /* Distinct rows stored in double and single precision. */
+        std::vector<double>           mDoubles;
+        std::vector<float>            mFloats;
+        /* Row of every entry: 2*offset (double) or 2*offset + 1 (float),
+         * where offset is position of the first row value. */
+        std::vector<size_t>           mEntries;
+        /* Hashes of stored rows (pointing to their mEntries values), used
+         * while rows are added. */
+        std::multimap<size_t, size_t> mLookup;
+
+    public:
+        /*************
+         * LIFECYCLE *
+         ************/
+
+        /*
+         * Constructor
+         *
+         * -----------
+         *  Arguments
+         * -----------
+         * const unsigned & length
+         *     Number of values per row.
+         *
+         * const StencilPrecision & precision
+         *     Storage precision.
+         *
+         * const double & tolerance
+         *     Largest relative rounding error of rows stored in single
+         *     precision (STENCIL_FLOAT only).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if length is 0 or tolerance is negative.
+         */
+        StencilTable (const unsigned         &    length = 1,
+                      const StencilPrecision & precision = STENCIL_DOUBLE,
+                      const double           & tolerance = 1e-6);
+
+        /**************
+         * OPERATIONS *
+         **************/
+
+        /*
+         * append()
+         *
+         * Adds an entry with given row (length values). Returns entry
+         * index.
+         */
+        size_t append (const double * row);
+
+        /*
+         * shrink()
+         *
+         * Releases memory used only while rows are added (appending is
+         * still possible, but rows added afterwards are not deduplicated
+         * against earlier ones).
+         */
+        void shrink ();
+
+        /*
+         * assign()
+         *
+         * Replaces contents of the table with stored rows and entries
+         * (e.g. read from a file; see doubleValues(), floatValues() and
+         * entries()).
+         *
+         * ------------
+         *  Exceptions
+         * ------------
+         * std::invalid_argument if numbers of values are not multiples of
+         * row length or any entry does not point to a row.
+         */
+        void assign (const std::vector<double> & doubles,
+                     const std::vector<float>  &  floats,
+                     const std::vector<size_t> & entries);
+
+        /* Number of values per row. */
+        unsigned length () const { return mLength; }
+
+        /* Number of entries. */
+        size_t size () const { return mEntries.size(); }
+
+        /* Number of distinct rows stored in double and single
+         * precision. */
+        size_t doubleRows () const { return mDoubles.size() / mLength; }
+        size_t floatRows  () const { return mFloats.size()  / mLength; }
+
+        /* Whether row of ith entry is stored in single precision. */
+        bool isFloat (const size_t & i) const { return mEntries[i] & 1; }
+
+        /* Row of ith entry stored in double (single) precision. Valid only
+         * if isFloat(i) is false (true). */
+        const double * doubleRow (const size_t & i) const
+        {
+            return &mDoubles[mEntries[i] >> 1];
+        }
+        const float * floatRow (const size_t & i) const
+        {
+            return &mFloats[mEntries[i] >> 1];
+        }
+
+        /* Stored rows and entries (see assign()). */
+        const std::vector<double> & doubleValues () const { return mDoubles; }
+        const std::vector<float>  & floatValues  () const { return mFloats;  }
+        const std::vector<size_t> & entries      () const { return mEntries; }
+
+        /* Copies row of ith entry (length values) to out. */
+        void load (const size_t &   i,
+                   double       * out) const;
+
+        /*
+         * memoryFootprint()
+         *
+         * Number of bytes taken by stored rows and entries (without memory
+         * released by shrink()).
+         */
+        size_t memoryFootprint () const;
+
+}; /* class StencilTable */
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_STENCIL_TABLE_H */
@@ -0,0 +1,73 @@
+/*
+ * File: util.h
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * An internal header file providing small helper functions shared by
+ * source files: grid validation (IsIncreasing), monotonic clock
+ * (MonotonicSeconds) and FNV-1a hash of bytes (HashBytes).
+ */
+
+#ifndef GRIDDIFF_UTIL_H
+#define GRIDDIFF_UTIL_H
+
+#include "qobj.h"   /* QGrid */
+
+#include <cstddef>  /* size_t */
+
+#include <time.h>   /* clock_gettime */
+
+namespace GridDiff
+{
+
+/* Offset basis of 64-bit FNV-1a hash (hash of no bytes). */
+const unsigned long long FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+/*
+ * IsIncreasing()
+ *
+ * Checks whether axis coordinates are strictly increasing.
+ */
+inline bool IsIncreasing (const QGrid & coords)
+{
+    for (size_t i = 1; i < coords.size(); ++i){
+        if (!(coords[i-1] < coords[i])){
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * MonotonicSeconds()
+ *
+ * Returns monotonic clock time in seconds.
+ */
+inline double MonotonicSeconds ()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/*
+ * HashBytes()
+ *
+ * Continues 64-bit FNV-1a hash h with n bytes (starting from
+ * FNV_OFFSET_BASIS by default).
+ */
+inline unsigned long long HashBytes (const void               * data,
+                                     const size_t             &    n,
+                                     unsigned long long h = FNV_OFFSET_BASIS)
+{
+    const unsigned char * b = static_cast<const unsigned char *>(data);
+
+    for (size_t i = 0; i < n; ++i){
+        h = (h ^ b[i]) * 1099511628211ULL;
+    }
+    return h;
+}
+
+} /* namespace GridDiff */
+
+#endif /* GRIDDIFF_UTIL_H */
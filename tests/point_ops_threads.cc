@@ -0,0 +1,144 @@
+/*
+ * File: point_ops_threads.cc
+ * Author(s): P Kuszaj
+ * Last changed: 18.10.2026
+ *
+ * Stress test of concurrent evaluation of point operators (see
+ * basic_3D_diffop.h header file): gradients and Laplacians of all
+ * coordinate systems are shared (const) by many threads, which evaluate
+ * them repeatedly at many sets of function values. Results have to be
+ * bit-identical to those of serial evaluation. Returns EXIT_FAILURE on
+ * any difference.
+ */
+
+#include "Gradients.h"   /* CartesianGradient, CylindricalGradient,
+                            SphericalGradient */
+#include "Laplacians.h"  /* CartesianLaplacian, CylindricalLaplacian,
+                            SphericalLaplacian */
+
+#include <cmath>         /* sin */
+#include <cstdio>        /* printf */
+#include <cstdlib>       /* EXIT_SUCCESS, EXIT_FAILURE */
+#include <vector>        /* std::vector */
+
+using namespace GridDiff;
+
+namespace
+{
+
+/* Number of value sets, of results per set, of parallel repetitions and
+ * of threads. */
+const long     SETS    = 20000;
+const unsigned RESULTS = 12;
+const unsigned REPEATS = 20;
+const int      THREADS = 8;
+
+
+/*
+ * Operators struct
+ *
+ * All tested operators, built at the same point of a non-uniform grid.
+ */
+struct Operators
+{
+    CartesianGradient    cartGrad;
+    CartesianLaplacian   cartLap;
+    CylindricalGradient  cylGrad;
+    CylindricalLaplacian cylLap;
+    SphericalGradient    sphGrad;
+    SphericalLaplacian   sphLap;
+
+    Operators (const QPoint & p0,
+               const QGrid  & q1, const QGrid & q2, const QGrid & q3)
+        : cartGrad(p0, q1, q2, q3), cartLap(p0, q1, q2, q3),
+          cylGrad (p0, q1, q2, q3), cylLap (p0, q1, q2, q3),
+          sphGrad (p0, q1, q2, q3), sphLap (p0, q1, q2, q3) { }
+};
+
+
+/*
+ * Evaluates all operators at sth value set, writing RESULTS values.
+ */
+void EvalSet (const Operators          & ops,
+              const std::vector<QGrid> &   v,
+              const long               &   s,
+              double                   * out)
+{
+    const QGrid & f1 = v[3*s];
+    const QGrid & f2 = v[3*s + 1];
+    const QGrid & f3 = v[3*s + 2];
+
+    const QPoint g[3] = { ops.cartGrad.eval(f1, f2, f3),
+                          ops.cylGrad .eval(f1, f2, f3),
+                          ops.sphGrad .eval(f1, f2, f3) };
+
+    for (unsigned k = 0; k < 3; ++k){
+        out[3*k]     = g[k].q1;
+        out[3*k + 1] = g[k].q2;
+        out[3*k + 2] = g[k].q3;
+    }
+
+    out[9]  = ops.cartLap.eval(f1, f2, f3);
+    out[10] = ops.cylLap .eval(f1, f2, f3);
+    out[11] = ops.sphLap .eval(f1, f2, f3);
+}
+
+} /* anonymous namespace */
+
+
+int main ()
+{
+    /* Non-uniform grid around (1.12, 0.63, 0.9). */
+    const unsigned n = 7;
+    QGrid          q1, q2, q3;
+
+    for (unsigned i = 0; i < n; ++i){
+        q1.push_back(1.0 + 0.01 * i * i);
+        q2.push_back(0.5 + 0.05 * i);
+        q3.push_back(0.3 * i + 0.01 * i * i);
+    }
+
+    QPoint p0;
+    p0.q1 = 1.12; p0.q2 = 0.63; p0.q3 = 0.9;
+
+    const Operators ops(p0, q1, q2, q3);
+
+    /* Function values along every axis for every set. */
+    std::vector<QGrid> v(3 * SETS, QGrid(n));
+
+    for (long s = 0; s < SETS; ++s){
+        for (unsigned a = 0; a < 3; ++a){
+            for (unsigned i = 0; i < n; ++i){
+                v[3*s + a][i] = sin(0.001 * s + a + 0.7 * i);
+            }
+        }
+    }
+
+    /* Serial reference. */
+    std::vector<double> ref(RESULTS * SETS), par(RESULTS * SETS);
+
+    for (long s = 0; s < SETS; ++s){
+        EvalSet(ops, v, s, &ref[RESULTS * s]);
+    }
+
+    /* Shared operators evaluated concurrently (dynamic schedule, so sets
+     * move between threads from one repetition to another). */
+    for (unsigned r = 0; r < REPEATS; ++r){
+        #pragma omp parallel for schedule(dynamic, 7) num_threads(THREADS)
+        for (long s = 0; s < SETS; ++s){
+            EvalSet(ops, v, s, &par[RESULTS * s]);
+        }
+
+        for (size_t k = 0; k < par.size(); ++k){
+            if (!(par[k] == ref[k])){
+                printf("point_ops_threads: FAILED (repetition %u, "
+                       "value %lu)\n", r, (unsigned long) k);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    printf("point_ops_threads: OK (%u repetitions, %d threads)\n",
+           REPEATS, THREADS);
+    return EXIT_SUCCESS;
+}